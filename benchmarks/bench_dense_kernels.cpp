@@ -0,0 +1,183 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "Utilities.hpp"
+#include "DenseKernels.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace LCQPow;
+
+/*
+ *  Reference: the previous (naive) implementations of the dense kernels.
+ */
+void ReferenceAffineLinearTransformation(const double* const A, const double* const b, double* d, int m, int n) {
+    for (int i = 0; i < m; i++) {
+        double tmp = 0;
+        for (int k = 0; k < n; k++)
+            tmp += A[i*n + k]*b[k];
+
+        d[i] = tmp;
+    }
+}
+
+
+void ReferenceTransponsedMatrixMultiplication(const double* const A, const double* const B, double* C, int m, int n) {
+    for (int i = 0; i < n; i++) {
+        C[i] = 0;
+        for (int k = 0; k < m; k++)
+            C[i] += A[k*n + i]*B[k];
+    }
+}
+
+
+void ReferenceMatrixSymmetrizationProduct(const double* const A, const double* const B, double* C, int m, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            C[i*n + j] = 0;
+            for (int k = 0; k < m; k++)
+                C[i*n + j] += A[k*n + i]*B[k*n + j] + B[k*n + i]*A[k*n + j];
+
+            C[j*n + i] = C[i*n + j];
+        }
+    }
+}
+
+
+double ReferenceQuadraticFormProduct(const double* const Q, const double* const p, int m) {
+    double ret = 0;
+    for (int i = 0; i < m; i++) {
+        double tmp = 0;
+        for (int j = 0; j < m; j++)
+            tmp += Q[i*m + j]*p[j];
+
+        ret += tmp*p[i];
+    }
+
+    return ret;
+}
+
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+// Runs the kernel repeatedly for at least 0.2 seconds and returns GFLOP/s
+template <typename Kernel>
+double gflops(Kernel kernel, double flops) {
+    int reps = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    do {
+        kernel();
+        reps++;
+    } while (elapsedSeconds(start) < 0.2);
+
+    return flops*reps/elapsedSeconds(start)*1e-9;
+}
+
+
+int main(int argc, char* argv[]) {
+
+    int sizes[3] = { 500, 1000, 2000 };
+    int nSizes = 3;
+
+    // A single size can be passed
+    if (argc > 1) {
+        sizes[0] = atoi(argv[1]);
+        nSizes = 1;
+    }
+
+    const char* names[3] = { "scalar", "avx2", "avx512" };
+    KernelInstructionSet defaultSet = DenseKernels::getInstructionSet();
+
+    printf("GFLOP/s of the dense kernels (nV x nV Hessian, nV/2 dense complementarity rows)\n");
+
+    if (DenseKernels::usesBLAS())
+        printf("Built with LCQPOW_USE_BLAS: the products are computed by BLAS for every instruction set.\n");
+
+    printf("%6s %-28s %10s %10s %10s %10s\n", "nV", "kernel", "reference", names[0], names[1], names[2]);
+
+    for (int s = 0; s < nSizes; s++) {
+        int n = sizes[s];
+        int m = n/2;
+
+        std::vector<double> Q((size_t)(n*n)), L((size_t)(m*n)), R((size_t)(m*n)), C((size_t)(n*n)), x((size_t)n), y((size_t)n);
+        for (double& v : Q) v = (std::rand() % 2001 - 1000)/1000.0;
+        for (double& v : L) v = (std::rand() % 2001 - 1000)/1000.0;
+        for (double& v : R) v = (std::rand() % 2001 - 1000)/1000.0;
+        for (double& v : x) v = (std::rand() % 2001 - 1000)/1000.0;
+
+        double sink = 0;
+
+        // Reference results first, then every supported instruction set
+        double results[4][4];
+        for (int v = 0; v < 4; v++) {
+            for (int k = 0; k < 4; k++)
+                results[v][k] = -1;
+
+            if (v == 0) {
+                results[v][0] = gflops([&]() { ReferenceAffineLinearTransformation(Q.data(), x.data(), y.data(), n, n); }, 2.0*n*n);
+                results[v][1] = gflops([&]() { ReferenceTransponsedMatrixMultiplication(L.data(), x.data(), y.data(), m, n); }, 2.0*m*n);
+                results[v][2] = gflops([&]() { ReferenceMatrixSymmetrizationProduct(L.data(), R.data(), C.data(), m, n); }, 2.0*m*n*(n+1));
+                results[v][3] = gflops([&]() { sink += ReferenceQuadraticFormProduct(Q.data(), x.data(), n); }, 2.0*n*n);
+                continue;
+            }
+
+            KernelInstructionSet isa = (KernelInstructionSet)(v - 1);
+            if (DenseKernels::setInstructionSet(isa) != SUCCESSFUL_RETURN)
+                continue;
+
+            results[v][0] = gflops([&]() { Utilities::AffineLinearTransformation(1, Q.data(), x.data(), y.data(), y.data(), n, n); }, 2.0*n*n);
+            results[v][1] = gflops([&]() { Utilities::TransponsedMatrixMultiplication(L.data(), x.data(), y.data(), m, n, 1); }, 2.0*m*n);
+            results[v][2] = gflops([&]() { Utilities::MatrixSymmetrizationProduct(L.data(), R.data(), C.data(), m, n); }, 2.0*m*n*(n+1));
+            results[v][3] = gflops([&]() { sink += Utilities::QuadraticFormProduct(Q.data(), x.data(), n); }, 2.0*n*n);
+        }
+
+        const char* kernels[4] = { "Qk*xk (AffineLinear...)", "L'*y (TransponsedMatrix...)", "C = L'R + R'L (Symmetriz...)", "p'*Qk*p (QuadraticForm...)" };
+
+        for (int k = 0; k < 4; k++) {
+            printf("%6d %-28s", n, kernels[k]);
+
+            for (int v = 0; v < 4; v++) {
+                if (results[v][k] < 0)
+                    printf(" %10s", "-");
+                else
+                    printf(" %10.2f", results[v][k]);
+            }
+
+            printf("\n");
+        }
+
+        // Keep the quadratic forms from being optimized away
+        if (sink == 0.123456789)
+            printf("\n");
+    }
+
+    DenseKernels::setInstructionSet(defaultSet);
+
+    return 0;
+}
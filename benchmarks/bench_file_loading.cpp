@@ -0,0 +1,208 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#include "LCQProblem.hpp"
+#include "Utilities.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace LCQPow;
+
+/*
+ *  Reference: the previous reader (one fscanf call per number).
+ */
+bool ReferenceReadFromFile(double* data, int n, const char* datafilename) {
+    FILE* datafile = fopen(datafilename, "r");
+
+    if (datafile == 0)
+        return false;
+
+    for (int i = 0; i < n; i++) {
+        if (fscanf(datafile, "%lf\n", &(data[i])) == 0) {
+            fclose(datafile);
+            return false;
+        }
+    }
+
+    fclose(datafile);
+    return true;
+}
+
+
+int countLines(const std::string& file) {
+    FILE* f = fopen(file.c_str(), "r");
+    if (f == 0) return 0;
+
+    int lines = 0;
+    for (int c = fgetc(f); c != EOF; c = fgetc(f))
+        if (c == '\n') lines++;
+
+    fclose(f);
+    return lines;
+}
+
+
+void writeBinary(const std::vector<double>& data, const std::string& file) {
+    FILE* f = fopen(file.c_str(), "wb");
+    fwrite(data.data(), sizeof(double), data.size(), f);
+    fclose(f);
+}
+
+
+// Writes the nonzeros of a dense row-major matrix as Matrix Market coordinate file
+void writeMatrixMarket(const std::vector<double>& data, int m, int n, const std::string& file) {
+    int nnz = 0;
+    for (size_t k = 0; k < data.size(); k++)
+        if (data[k] != 0) nnz++;
+
+    FILE* f = fopen(file.c_str(), "w");
+    fprintf(f, "%%%%MatrixMarket matrix coordinate real general\n%d %d %d\n", m, n, nnz);
+
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            if (data[(size_t)(i*n + j)] != 0)
+                fprintf(f, "%d %d %.17g\n", i + 1, j + 1, data[(size_t)(i*n + j)]);
+
+    fclose(f);
+}
+
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int main(int argc, char* argv[]) {
+
+    // Data directory and number of repetitions can be passed
+    std::string inputdir = argc > 1 ? argv[1] : "examples/example_data";
+    int nRep = argc > 2 ? atoi(argv[2]) : 20;
+
+    // Dimensions (one number per line)
+    int nV = (int)std::lround(std::sqrt((double)countLines(inputdir + "/Q.txt")));
+    int nComp = nV > 0 ? countLines(inputdir + "/L.txt")/nV : 0;
+    int nC = nV > 0 ? countLines(inputdir + "/A.txt")/nV : 0;
+
+    if (nV <= 0 || nComp <= 0) {
+        printf("No LCQP found in %s.\n", inputdir.c_str());
+        return 1;
+    }
+
+    const char* names[4] = { "Q", "L", "R", "A" };
+    const int rows[4] = { nV, nComp, nComp, nC };
+
+    std::vector<double> matrices[4];
+    for (int k = 0; k < 4; k++)
+        matrices[k].resize((size_t)(rows[k]*nV));
+
+    std::vector<double> g((size_t)nV);
+
+    // Text files of the matrices and g, with the previous and the buffered reader
+    std::string txt[5], bin[5], mtx[4];
+    for (int k = 0; k < 4; k++) {
+        txt[k] = inputdir + "/" + names[k] + ".txt";
+        bin[k] = std::string("bench_file_loading_") + names[k] + ".bin";
+        mtx[k] = std::string("bench_file_loading_") + names[k] + ".mtx";
+    }
+    txt[4] = inputdir + "/g.txt";
+    bin[4] = "bench_file_loading_g.bin";
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < nRep; r++) {
+        for (int k = 0; k < 4; k++)
+            if (rows[k] > 0 && !ReferenceReadFromFile(matrices[k].data(), rows[k]*nV, txt[k].c_str())) return 1;
+        if (!ReferenceReadFromFile(g.data(), nV, txt[4].c_str())) return 1;
+    }
+    double fscanfTime = elapsedSeconds(start)/nRep;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < nRep; r++) {
+        for (int k = 0; k < 4; k++)
+            if (rows[k] > 0 && Utilities::readFromFile(matrices[k].data(), rows[k]*nV, txt[k].c_str()) != SUCCESSFUL_RETURN) return 1;
+        if (Utilities::readFromFile(g.data(), nV, txt[4].c_str()) != SUCCESSFUL_RETURN) return 1;
+    }
+    double textTime = elapsedSeconds(start)/nRep;
+
+    // Binary and Matrix Market copies
+    for (int k = 0; k < 4; k++) {
+        writeBinary(matrices[k], bin[k]);
+        writeMatrixMarket(matrices[k], rows[k], nV, mtx[k]);
+    }
+    writeBinary(g, bin[4]);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < nRep; r++) {
+        for (int k = 0; k < 4; k++)
+            if (rows[k] > 0 && Utilities::readFromFile(matrices[k].data(), rows[k]*nV, bin[k].c_str()) != SUCCESSFUL_RETURN) return 1;
+        if (Utilities::readFromFile(g.data(), nV, bin[4].c_str()) != SUCCESSFUL_RETURN) return 1;
+    }
+    double binaryTime = elapsedSeconds(start)/nRep;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < nRep; r++) {
+        for (int k = 0; k < 4; k++) {
+            csc* M = NULL;
+            if (rows[k] > 0 && Utilities::readMatrixMarket(&M, mtx[k].c_str()) != SUCCESSFUL_RETURN) return 1;
+            Utilities::ClearSparseMat(&M);
+        }
+        if (Utilities::readFromFile(g.data(), nV, bin[4].c_str()) != SUCCESSFUL_RETURN) return 1;
+    }
+    double mtxTime = elapsedSeconds(start)/nRep;
+
+    // Complete loads (reading and setting up the LCQP)
+    LCQProblem lcqp(nV, nC, nComp);
+    const char* A_txt = nC > 0 ? txt[3].c_str() : 0;
+    const char* A_mtx = nC > 0 ? mtx[3].c_str() : 0;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < nRep; r++)
+        if (lcqp.loadLCQP(txt[0].c_str(), txt[4].c_str(), txt[1].c_str(), txt[2].c_str(), 0, 0, 0, 0, A_txt) != SUCCESSFUL_RETURN) return 1;
+    double loadTextTime = elapsedSeconds(start)/nRep;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < nRep; r++)
+        if (lcqp.loadLCQP(mtx[0].c_str(), bin[4].c_str(), mtx[1].c_str(), mtx[2].c_str(), 0, 0, 0, 0, A_mtx) != SUCCESSFUL_RETURN) return 1;
+    double loadMtxTime = elapsedSeconds(start)/nRep;
+
+    printf("Reading the LCQP in %s (nV = %d, nC = %d, nComp = %d), %d repetitions\n", inputdir.c_str(), nV, nC, nComp, nRep);
+    printf("%-28s %12s %10s\n", "format", "ms", "speedup");
+    printf("%-28s %12.3f %10.2f\n", "text (fscanf)", 1e3*fscanfTime, 1.0);
+    printf("%-28s %12.3f %10.2f\n", "text (buffered)", 1e3*textTime, fscanfTime/textTime);
+    printf("%-28s %12.3f %10.2f\n", "binary", 1e3*binaryTime, fscanfTime/binaryTime);
+    printf("%-28s %12.3f %10.2f\n", "Matrix Market (csc)", 1e3*mtxTime, fscanfTime/mtxTime);
+    printf("%-28s %12.3f %10s\n", "loadLCQP text (dense)", 1e3*loadTextTime, "");
+    printf("%-28s %12.3f %10s\n", "loadLCQP Matrix Market", 1e3*loadMtxTime, "");
+
+    for (int k = 0; k < 4; k++) {
+        remove(bin[k].c_str());
+        remove(mtx[k].c_str());
+    }
+    remove(bin[4].c_str());
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#include "Utilities.hpp"
+#include "TrajectoryWriter.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace LCQPow;
+
+/*
+ *  Reference: the previous writer (one fprintf call per number with 6 decimals).
+ */
+bool ReferenceWriteToFile(const double* data, int n, const char* datafilename) {
+    FILE* datafile = fopen(datafilename, "w");
+
+    if (datafile == 0)
+        return false;
+
+    for (int i = 0; i < n; i++) {
+        if (fprintf(datafile, "%f\n", data[i]) == 0) {
+            fclose(datafile);
+            return false;
+        }
+    }
+
+    fclose(datafile);
+    return true;
+}
+
+
+// Number of values that differ after writing and reading a file
+int countMismatches(const std::vector<double>& data, const char* file) {
+    std::vector<double> read(data.size());
+
+    if (Utilities::readFromFile(read.data(), (int)read.size(), file) != SUCCESSFUL_RETURN)
+        return (int)data.size();
+
+    int mismatches = 0;
+    for (size_t i = 0; i < data.size(); i++)
+        if (read[i] != data[i]) mismatches++;
+
+    return mismatches;
+}
+
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int main(int argc, char* argv[]) {
+
+    // Length of an iterate and number of iterates can be passed
+    int nV = argc > 1 ? atoi(argv[1]) : 1000;
+    int nSteps = argc > 2 ? atoi(argv[2]) : 500;
+
+    std::vector<double> data((size_t)nV*(size_t)nSteps);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (std::rand() - RAND_MAX/2)/(double)RAND_MAX*std::pow(10.0, (double)(std::rand() % 9 - 4));
+
+    // All values at once
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!ReferenceWriteToFile(data.data(), (int)data.size(), "bench_file_writing_ref.txt")) return 1;
+    double fprintfTime = elapsedSeconds(start);
+
+    start = std::chrono::steady_clock::now();
+    if (Utilities::writeToFile(data.data(), (int)data.size(), "bench_file_writing.txt") != SUCCESSFUL_RETURN) return 1;
+    double textTime = elapsedSeconds(start);
+
+    start = std::chrono::steady_clock::now();
+    if (Utilities::writeToFile(data.data(), (int)data.size(), "bench_file_writing.bin") != SUCCESSFUL_RETURN) return 1;
+    double binaryTime = elapsedSeconds(start);
+
+    // One record per iterate (as streamed during a solve)
+    TrajectoryWriter writer;
+    start = std::chrono::steady_clock::now();
+    if (writer.open("bench_file_writing_steps.bin") != SUCCESSFUL_RETURN) return 1;
+    for (int k = 0; k < nSteps; k++)
+        writer.write(data.data() + (size_t)k*(size_t)nV, nV);
+    if (writer.close() != SUCCESSFUL_RETURN) return 1;
+    double streamTime = elapsedSeconds(start);
+
+    printf("Writing %d iterates of length %d\n", nSteps, nV);
+    printf("%-24s %12s %10s %12s\n", "format", "ms", "speedup", "mismatches");
+    printf("%-24s %12.3f %10.2f %12d\n", "text (fprintf %f)", 1e3*fprintfTime, 1.0, countMismatches(data, "bench_file_writing_ref.txt"));
+    printf("%-24s %12.3f %10.2f %12d\n", "text (%.17g, buffered)", 1e3*textTime, fprintfTime/textTime, countMismatches(data, "bench_file_writing.txt"));
+    printf("%-24s %12.3f %10.2f %12d\n", "binary", 1e3*binaryTime, fprintfTime/binaryTime, countMismatches(data, "bench_file_writing.bin"));
+    printf("%-24s %12.3f %10.2f %12d\n", "binary (per iterate)", 1e3*streamTime, fprintfTime/streamTime, countMismatches(data, "bench_file_writing_steps.bin"));
+
+    remove("bench_file_writing_ref.txt");
+    remove("bench_file_writing.txt");
+    remove("bench_file_writing.bin");
+    remove("bench_file_writing_steps.bin");
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "LCQProblem.hpp"
+#include "LCQProblemPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace LCQPow;
+
+/*
+ *  A request: a small LCQP of one of a few known shapes.
+ *  min 1/2 x'Qx + g'x  s.t.  -10 nV <= sum(x) <= 10 nV,  0 <= x_i _|_ x_{nComp+i} >= 0
+ */
+struct Request {
+    LCQProblemShape shape;
+    std::vector<double> Q, g, L, R, A, lbA, ubA;
+};
+
+
+Request createRequest(int nV) {
+    Request r;
+    int nComp = nV/2;
+
+    r.shape.nV = nV;
+    r.shape.nC = 1;
+    r.shape.nComp = nComp;
+    r.shape.fingerprint = 0;
+
+    // Diagonally dominant tridiagonal Hessian
+    r.Q.assign((size_t)(nV*nV), 0.0);
+    for (int i = 0; i < nV; i++) {
+        r.Q[(size_t)(i*nV + i)] = 2.0;
+        if (i + 1 < nV) {
+            r.Q[(size_t)(i*nV + i + 1)] = 0.5;
+            r.Q[(size_t)((i + 1)*nV + i)] = 0.5;
+        }
+    }
+
+    r.g.resize((size_t)nV);
+    for (double& v : r.g) v = (std::rand() % 2001 - 1000)/1000.0;
+
+    r.L.assign((size_t)(nComp*nV), 0.0);
+    r.R.assign((size_t)(nComp*nV), 0.0);
+    for (int i = 0; i < nComp; i++) {
+        r.L[(size_t)(i*nV + i)] = 1.0;
+        r.R[(size_t)(i*nV + nComp + i)] = 1.0;
+    }
+
+    r.A.assign((size_t)nV, 1.0);
+    r.lbA.assign(1, -10.0*nV);
+    r.ubA.assign(1, 10.0*nV);
+
+    return r;
+}
+
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+// Solves a request on the given object, returns whether it succeeded
+bool solve(LCQProblem& lcqp, const Request& r, double* x) {
+    ReturnValue ret = lcqp.loadLCQP(r.Q.data(), r.g.data(), r.L.data(), r.R.data(), 0, 0, 0, 0, r.A.data(), r.lbA.data(), r.ubA.data());
+
+    if (ret == SUCCESSFUL_RETURN)
+        ret = lcqp.runSolver();
+
+    lcqp.getPrimalSolution(x);
+
+    return ret == SUCCESSFUL_RETURN;
+}
+
+
+// Runs nRequests requests on each of nThreads threads and returns the requests per second
+double throughput(const std::vector<Request>& requests, Options& options, LCQProblemPool* pool, int nThreads, int nRequests, std::atomic<int>& failures) {
+    std::vector<std::thread> workers;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < nThreads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            std::vector<double> x;
+
+            for (int k = 0; k < nRequests; k++) {
+                const Request& r = requests[(size_t)((t*nRequests + k) % (int)requests.size())];
+                x.resize((size_t)r.shape.nV);
+
+                if (pool == NULL) {
+                    LCQProblem lcqp(r.shape.nV, r.shape.nC, r.shape.nComp);
+                    lcqp.setOptions(options);
+
+                    if (!solve(lcqp, r, x.data()))
+                        failures++;
+                } else {
+                    LCQProblem* lcqp = pool->acquire(r.shape);
+
+                    if (!solve(*lcqp, r, x.data()))
+                        failures++;
+
+                    pool->release(lcqp);
+                }
+            }
+        }));
+    }
+
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    return nThreads*nRequests/elapsedSeconds(start);
+}
+
+
+int main(int argc, char* argv[]) {
+
+    // Requests per thread, size of the smallest shape and number of shapes can be passed
+    int nRequests = argc > 1 ? atoi(argv[1]) : 200;
+    int nVMin = argc > 2 ? atoi(argv[2]) : 10;
+    int nShapes = argc > 3 ? atoi(argv[3]) : 24;
+
+    std::vector<Request> requests;
+    for (int s = 0; s < nShapes; s++)
+        requests.push_back(createRequest(nVMin + s));
+
+    Options options;
+    options.setPrintLevel(PrintLevel::NONE);
+
+    int threads[3] = { 1, 8, 32 };
+    std::atomic<int> failures( 0 );
+
+    printf("Requests/s of fresh vs. pooled LCQProblem objects (%d shapes, nV = %d..%d, %d requests per thread)\n", nShapes, nVMin, nVMin + nShapes - 1, nRequests);
+    printf("%8s %12s %12s %10s\n", "threads", "fresh", "pooled", "speedup");
+
+    for (int k = 0; k < 3; k++) {
+        LCQProblemPool pool(options, 32*nShapes, 32);
+
+        // Untimed pass to fill the pool
+        throughput(requests, options, &pool, threads[k], nShapes, failures);
+
+        double fresh = throughput(requests, options, NULL, threads[k], nRequests, failures);
+        double pooled = throughput(requests, options, &pool, threads[k], nRequests, failures);
+
+        printf("%8d %12.1f %12.1f %10.2f\n", threads[k], fresh, pooled, pooled/fresh);
+    }
+
+    if (failures.load() > 0)
+        printf("%d requests failed.\n", failures.load());
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "Utilities.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace LCQPow;
+
+/*
+ *  Reference: the previous implementation of the sparse symmetrization product,
+ *  which visits every (i,j) pair of the n x n result.
+ */
+csc* ReferenceSymmetrizationProduct(const csc* const L, const csc* const R) {
+    int n = L->n;
+    std::vector<int> C_rows;
+    std::vector<double> C_data;
+    int* C_p = (int*) malloc((size_t)(n+1)*sizeof(int));
+    C_p[0] = 0;
+
+    for (int j = 0; j < n; j++) {
+        C_p[j+1] = C_p[j];
+        for (int i = 0; i < n; i++) {
+            double tmp = 0;
+
+            for (int k = L->p[i]; k < L->p[i+1]; k++) {
+                int ind = Utilities::getIndexOfIn(L->i[k], R->i, R->p[j], R->p[j+1]);
+                if (ind != -1)
+                    tmp += L->x[k]*R->x[ind];
+            }
+
+            for (int k = R->p[i]; k < R->p[i+1]; k++) {
+                int ind = Utilities::getIndexOfIn(R->i[k], L->i, L->p[j], L->p[j+1]);
+                if (ind != -1)
+                    tmp += R->x[k]*L->x[ind];
+            }
+
+            if (!Utilities::isZero(tmp)) {
+                C_rows.push_back(i);
+                C_data.push_back(tmp);
+                C_p[j+1]++;
+            }
+        }
+    }
+
+    int* C_i = (int*) malloc((size_t)C_p[n]*sizeof(int));
+    double* C_x = (double*) malloc((size_t)C_p[n]*sizeof(double));
+    for (int k = 0; k < C_p[n]; k++) {
+        C_i[k] = C_rows[(size_t)k];
+        C_x[k] = C_data[(size_t)k];
+    }
+
+    return Utilities::createCSC(n, n, C_p[n], C_x, C_i, C_p);
+}
+
+
+/*
+ *  Complementarity selectors of a typical MPCC: nV = 2*nComp, x_i \perp x_{nComp+i}.
+ */
+void createSelectors(int nComp, csc** L, csc** R) {
+    int nV = 2*nComp;
+
+    int* L_p = (int*) malloc((size_t)(nV+1)*sizeof(int));
+    int* R_p = (int*) malloc((size_t)(nV+1)*sizeof(int));
+    int* L_i = (int*) malloc((size_t)nComp*sizeof(int));
+    int* R_i = (int*) malloc((size_t)nComp*sizeof(int));
+    double* L_x = (double*) malloc((size_t)nComp*sizeof(double));
+    double* R_x = (double*) malloc((size_t)nComp*sizeof(double));
+
+    for (int j = 0; j <= nV; j++) {
+        L_p[j] = (j < nComp) ? j : nComp;
+        R_p[j] = (j < nComp) ? 0 : j - nComp;
+    }
+
+    for (int k = 0; k < nComp; k++) {
+        L_i[k] = k;
+        R_i[k] = k;
+        L_x[k] = 1.0;
+        R_x[k] = 1.0;
+    }
+
+    *L = Utilities::createCSC(nComp, nV, nComp, L_x, L_i, L_p);
+    *R = Utilities::createCSC(nComp, nV, nComp, R_x, R_i, R_p);
+}
+
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int main(int argc, char* argv[]) {
+
+    // Reference implementation is only run up to this number of variables (quadratic cost)
+    int maxReferenceSize = 20000;
+    if (argc > 1)
+        maxReferenceSize = atoi(argv[1]);
+
+    int sizes[5] = { 1000, 5000, 20000, 50000, 200000 };
+
+    printf("%10s %10s %14s %14s %10s\n", "nV", "nnz(C)", "reference [s]", "sparse [s]", "speedup");
+
+    for (int s = 0; s < 5; s++) {
+        int nComp = sizes[s]/2;
+
+        csc* L;
+        csc* R;
+        createSelectors(nComp, &L, &R);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        csc* C = Utilities::MatrixSymmetrizationProduct(L, R);
+        double tSparse = elapsedSeconds(start);
+
+        if (sizes[s] <= maxReferenceSize) {
+            start = std::chrono::steady_clock::now();
+            csc* C_ref = ReferenceSymmetrizationProduct(L, R);
+            double tReference = elapsedSeconds(start);
+
+            // Both results must coincide exactly
+            bool equal = C->p[C->n] == C_ref->p[C_ref->n];
+            for (int k = 0; equal && k < C->p[C->n]; k++)
+                equal = (C->i[k] == C_ref->i[k]) && Utilities::isEqual(C->x[k], C_ref->x[k]);
+
+            if (!equal) {
+                printf("Mismatch between reference and sparse product (nV = %d).\n", sizes[s]);
+                return 1;
+            }
+
+            printf("%10d %10d %14.6f %14.6f %9.1fx\n", sizes[s], C->p[C->n], tReference, tSparse, tReference/tSparse);
+            Utilities::ClearSparseMat(&C_ref);
+        } else {
+            printf("%10d %10d %14s %14.6f %10s\n", sizes[s], C->p[C->n], "-", tSparse, "-");
+        }
+
+        Utilities::ClearSparseMat(&C);
+        Utilities::ClearSparseMat(&L);
+        Utilities::ClearSparseMat(&R);
+    }
+
+    return 0;
+}
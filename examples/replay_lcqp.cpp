@@ -0,0 +1,117 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#include "LCQProblem.hpp"
+#include "LCQPContainer.hpp"
+#include "OutputStatistics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace LCQPow;
+
+/*
+ *  Replays a problem dumped by the solver (see Options::setDumpFile): loads the snapshot with its options and solves it
+ *  repeatedly, reporting the outcome of the solve and its timing.
+ *
+ *  Usage: replay_lcqp <snapshot.lcqp> [repetitions] [print level]
+ */
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 2) {
+        printf("Usage: %s <snapshot.lcqp> [repetitions] [print level]\n", argv[0]);
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? std::max(atoi(argv[2]), 1) : 1;
+
+    LCQPContainer snapshot;
+
+    if (snapshot.open( argv[1] ) != SUCCESSFUL_RETURN) {
+        printf("Failed to open snapshot %s.\n", argv[1]);
+        return 1;
+    }
+
+    // The options of the captured solve (the defaults if the container holds none)
+    Options options;
+    if (snapshot.getOptions( options ) != SUCCESSFUL_RETURN)
+        printf("The snapshot holds no options, using the default options.\n");
+
+    options.setDumpFile( NULL );
+    options.setPrintLevel( argc > 3 ? atoi(argv[3]) : (int)PrintLevel::NONE );
+
+    const char* solvers[3] = { "qpOASES (dense)", "qpOASES (sparse)", "OSQP" };
+    printf("Snapshot %s: nV = %d, nC = %d, nComp = %d, %s data, QP solver %s\n", argv[1], snapshot.getNV(), snapshot.getNC(),
+        snapshot.getNComp(), snapshot.isSparse() ? "sparse" : "dense", solvers[options.getQPSolver()]);
+
+    std::vector<double> loadTimes, solveTimes;
+    ReturnValue ret = SUCCESSFUL_RETURN;
+    OutputStatistics stats;
+
+    for (int k = 0; k < repetitions; k++) {
+        LCQProblem lcqp( snapshot.getNV(), snapshot.getNC(), snapshot.getNComp() );
+        lcqp.setOptions( options );
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ret = snapshot.load( lcqp );
+        loadTimes.push_back(elapsedSeconds(start));
+
+        if (ret != SUCCESSFUL_RETURN) {
+            printf("Failed to load the snapshot (return value %d).\n", (int)ret);
+            return 1;
+        }
+
+        start = std::chrono::steady_clock::now();
+        ret = lcqp.runSolver();
+        solveTimes.push_back(elapsedSeconds(start));
+
+        lcqp.getOutputStatistics( stats );
+    }
+
+    printf("Return value %d, status %d, %d iterations (%d outer, %d QP iterations), rho = %g\n", (int)ret,
+        (int)stats.getSolutionStatus(), stats.getIterTotal(), stats.getIterOuter(), stats.getSubproblemIter(), stats.getRhoOpt());
+
+    std::sort(loadTimes.begin(), loadTimes.end());
+    std::sort(solveTimes.begin(), solveTimes.end());
+
+    printf("%10s %12s %12s %12s\n", "", "min [ms]", "median [ms]", "max [ms]");
+    printf("%10s %12.3f %12.3f %12.3f\n", "load", 1e3*loadTimes.front(), 1e3*loadTimes[loadTimes.size()/2], 1e3*loadTimes.back());
+    printf("%10s %12.3f %12.3f %12.3f\n", "solve", 1e3*solveTimes.front(), 1e3*solveTimes[solveTimes.size()/2], 1e3*solveTimes.back());
+
+    printf("\nLast solve by phase [ms]:\n");
+    const char* phases[NUMBER_OF_PHASES] = { "setup", "QP solve", "linearize", "stationary", "step", "terminate", "bookkeep" };
+
+    for (int p = 0; p < NUMBER_OF_PHASES; p++)
+        printf("%10s %12.3f\n", phases[p], 1e3*stats.getPhaseTime( (SolverPhase)p ));
+
+    return ret == SUCCESSFUL_RETURN ? 0 : 1;
+}
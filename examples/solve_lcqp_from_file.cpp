@@ -23,6 +23,7 @@
 #include <iostream>
 #include <fstream>
 #include <LCQProblem.hpp>
+#include <LCQPContainer.hpp>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <chrono>
@@ -33,11 +34,46 @@ bool PathExists(const std::string &s)
     return (stat (s.c_str(), &buffer) == 0);
 }
 
-int main() {
+// Solves an LCQP stored in a container file (see LCQPContainer)
+int solveContainer(const char* filename) {
+
+    LCQPow::LCQPContainer container;
+
+    if (container.open( filename ) != LCQPow::SUCCESSFUL_RETURN) {
+        printf("Failed to open container.\n");
+        return 1;
+    }
+
+    LCQPow::LCQProblem lcqp( container.getNV(), container.getNC(), container.getNComp() );
+
+    LCQPow::Options options;
+    options.setPrintLevel( LCQPow::PrintLevel::INNER_LOOP_ITERATES );
+    options.setQPSolver( container.isSparse() ? LCQPow::QPSolver::QPOASES_SPARSE : LCQPow::QPSolver::QPOASES_DENSE );
+    lcqp.setOptions( options );
+
+    // The data is referenced in the mapped file (the container stays open while solving)
+    if (container.load( lcqp ) != LCQPow::SUCCESSFUL_RETURN) {
+        printf("Failed to load LCQP.\n");
+        return 1;
+    }
+
+    if (lcqp.runSolver() != LCQPow::SUCCESSFUL_RETURN) {
+        printf("Failed to solve LCQP.\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
 
     std::cout << "Preparing OCP loaded from file...\n";
 
-    std::string inputdir = "examples/example_data";
+    // Either a container file or a directory of data files can be passed
+    std::string inputdir = argc > 1 ? argv[1] : "examples/example_data";
+
+    if (inputdir.size() > 5 && inputdir.compare(inputdir.size() - 5, 5, ".lcqp") == 0)
+        return solveContainer(argv[1]);
 
     if (!PathExists(inputdir)) {
         printf("Input directory does not exist.");
@@ -118,7 +154,7 @@ int main() {
     }
 
     if (PathExists(y0_file)) {
-        y0f = &y0f[0];
+        y0f = &y0_file[0];
     }
 
     LCQPow::LCQProblem lcqp( nV, nC, nComp );
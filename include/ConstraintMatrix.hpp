@@ -0,0 +1,210 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef LCQPOW_CONSTRAINTMATRIX_HPP
+#define LCQPOW_CONSTRAINTMATRIX_HPP
+
+#include "Utilities.hpp"
+
+#include <vector>
+
+namespace LCQPow {
+
+    /**
+     *  The blocks of the stacked constraint matrix [A; L; R].
+     */
+    enum ConstraintBlock {
+        BLOCK_A = 0,                                    /**< Linear constraints (rows 0 to nC-1). */
+        BLOCK_L = 1,                                    /**< LHS of the complementarity pairs (rows nC to nC+nComp-1). */
+        BLOCK_R = 2                                     /**< RHS of the complementarity pairs (rows nC+nComp to nC+2*nComp-1). */
+    };
+
+
+    /**
+     *  The constraint matrix [A; L; R] of an LCQP.
+     *  It is stored only once, in the stacked layout passed to the QP solvers, and the blocks are accessed through it:
+     *  in dense format a block is a range of rows of the (row major) stacked matrix, in sparse format each column
+     *  remembers where the entries of the blocks start.
+     *  Blocks that are selector matrices (every row has a single entry, which is 1) are detected on set up, their
+     *  products are computed by gathering and scattering entries of the vectors.
+     */
+    class ConstraintMatrix {
+
+        public:
+
+            /** Default constructor. */
+            ConstraintMatrix( );
+
+
+            /** Copy constructor (deep copy). */
+            ConstraintMatrix( const ConstraintMatrix& rhs );
+
+
+            /** Destructor. */
+            ~ConstraintMatrix( );
+
+
+            /** Assignment operator (deep copy). */
+            ConstraintMatrix& operator=( const ConstraintMatrix& rhs );
+
+
+            /** Set up the stacked matrix from dense blocks (any previous data is cleared).
+             *
+             * @param nV Number of optimization variables.
+             * @param nC Number of linear constraints.
+             * @param nComp Number of complementarity pairs.
+             * @param A The constraint matrix (row major). A `NULL` pointer can be passed if no linear constraints exist.
+             * @param L The LHS complementarity matrix (row major).
+             * @param R The RHS complementarity matrix (row major).
+             */
+            void setUp( int nV, int nC, int nComp, const double* const A, const double* const L, const double* const R );
+
+
+            /** Set up the stacked matrix from sparse blocks (any previous data is cleared).
+             *
+             * @param nV Number of optimization variables.
+             * @param nC Number of linear constraints.
+             * @param nComp Number of complementarity pairs.
+             * @param A The constraint matrix in csc format. A `NULL` pointer can be passed if no linear constraints exist.
+             * @param L The LHS complementarity matrix in csc format.
+             * @param R The RHS complementarity matrix in csc format.
+             */
+            void setUp( int nV, int nC, int nComp, const csc* const A, const csc* const L, const csc* const R );
+
+
+            /** Convert the stored matrix to sparse format.
+             *
+             * @returns SUCCESSFUL_RETURN or FAILED_SWITCH_TO_SPARSE.
+             */
+            ReturnValue switchToSparseMode( );
+
+
+            /** Convert the stored matrix to dense format.
+             *
+             * @returns SUCCESSFUL_RETURN or FAILED_SWITCH_TO_DENSE.
+             */
+            ReturnValue switchToDenseMode( );
+
+
+            /** Clear the memory. */
+            void clear( );
+
+
+            /** Whether the matrix is stored in sparse format. */
+            bool isSparse( ) const;
+
+
+            /** Get the number of rows of the stacked matrix (nC + 2*nComp). */
+            int getNumberOfRows( ) const;
+
+
+            /** Get the stacked matrix in dense (row major) format (`NULL` in sparse mode). */
+            const double* getDense( ) const;
+
+
+            /** Get the stacked matrix in csc format (`NULL` in dense mode). */
+            const csc* getSparse( ) const;
+
+
+            /** Get the column of the unit entry of each row of a block (`NULL` if the block is not a selector matrix). */
+            const int* getSelectorColumns( ConstraintBlock block ) const;
+
+
+            /** y = M*x, where M is a block of the stacked matrix.
+             *
+             * @param block The block to be multiplied.
+             * @param x A vector of length nV.
+             * @param y The result (of the block's number of rows).
+             */
+            void multiply( ConstraintBlock block, const double* const x, double* y ) const;
+
+
+            /** y = M*x, where M consists of the consecutive blocks first, ..., last (e.g. [L; R] in one pass).
+             *
+             * @param first The first block to be multiplied.
+             * @param last The last block to be multiplied.
+             * @param x A vector of length nV.
+             * @param y The result (of the blocks' total number of rows).
+             */
+            void multiply( ConstraintBlock first, ConstraintBlock last, const double* const x, double* y ) const;
+
+
+            /** x += alpha*[A; L; R]'*y (a single pass over all blocks).
+             *
+             * @param alpha The scaling factor.
+             * @param y A vector of length nC + 2*nComp.
+             * @param x The vector of length nV to be updated.
+             */
+            void addTransposedMultiply( double alpha, const double* const y, double* x ) const;
+
+
+            /** x += alpha*M'*y, where M is a block of the stacked matrix.
+             *
+             * @param block The block to be multiplied.
+             * @param alpha The scaling factor.
+             * @param y A vector of the block's number of rows.
+             * @param x The vector of length nV to be updated.
+             */
+            void addTransposedMultiply( ConstraintBlock block, double alpha, const double* const y, double* x ) const;
+
+
+        protected:
+
+            /** Copies all members from given rhs object. */
+            void copy( const ConstraintMatrix& rhs );
+
+
+            /** Get the first row of a block within the stacked matrix. */
+            int getBlockOffset( int block ) const;
+
+
+            /** Locate the blocks within each column of the sparse stacked matrix (the blocks must be stored in order). */
+            void setBlockPointers( );
+
+
+            /** Determine which blocks are selector matrices. */
+            void detectSelectors( );
+
+
+            /** Record an entry of the stacked matrix during the selector detection (marks rows with several or non-unit entries). */
+            static void setSelectorColumn( std::vector<int>& columns, int row, int column, double val );
+
+
+            /** y = M*x for the consecutive blocks first, ..., last using the stored matrix. */
+            void multiplyBlocks( int first, int last, const double* const x, double* y ) const;
+
+
+        private:
+
+            int nV = 0;                             /**< Number of optimization variables. */
+            int nC = 0;                             /**< Number of linear constraints. */
+            int nComp = 0;                          /**< Number of complementarity pairs. */
+
+            double* M = NULL;                       /**< Stacked matrix in dense (row major) format. */
+            csc* M_sparse = NULL;                   /**< Stacked matrix in csc format. */
+            std::vector<int> blockPointers;         /**< Entries of block b in column j are blockPointers[4*j + b] to blockPointers[4*j + b + 1] - 1. */
+            std::vector<int> selectorColumns[3];    /**< Column of the unit entry of each row of block b (empty if block b is no selector matrix). */
+            std::vector<int> rowColumns;            /**< Scratch of detectSelectors (kept, such that set ups of the same dimensions do not allocate). */
+    };
+}
+
+#endif  // LCQPOW_CONSTRAINTMATRIX_HPP
@@ -0,0 +1,99 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef LCQPOW_DENSEKERNELS_HPP
+#define LCQPOW_DENSEKERNELS_HPP
+
+#include "Utilities.hpp"
+
+namespace LCQPow {
+
+    /**
+     *  Instruction sets of the dense kernels.
+     */
+    enum KernelInstructionSet {
+        KERNELS_SCALAR = 0,                             /**< Portable scalar code (always available). */
+        KERNELS_AVX2 = 1,                               /**< AVX2 and FMA (x86-64 only). */
+        KERNELS_AVX512 = 2                              /**< AVX-512F (x86-64 only). */
+    };
+
+
+    /**
+     *  Cache and register blocked dense linear algebra (all matrices are row major).
+     *  The kernels are built on a few vector primitives, which are compiled for every supported instruction set.
+     *  The fastest set supported by the CPU is chosen at runtime, the scalar code serves as fallback.
+     *  If built with LCQPOW_USE_BLAS, the matrix-vector and matrix-matrix products are computed by dgemv, dgemm, dsyr2k and dsymv instead.
+     *  Results may differ from a naive implementation by round-off only (the summation order differs).
+     */
+    class DenseKernels {
+
+        public:
+
+            /** Returns a'*b (a and b are of length n). */
+            static double DotProduct(const double* const a, const double* const b, int n);
+
+
+            /** y = alpha*A*x + c (A is m x n). A `NULL` pointer can be passed for c. */
+            static void MatrixVectorProduct(double alpha, const double* const A, const double* const x, const double* const c, double* y, int m, int n);
+
+
+            /** y += alpha*A'*x (A is m x n). */
+            static void AddTransposedMatrixVectorProduct(double alpha, const double* const A, const double* const x, double* y, int m, int n);
+
+
+            /** C = A*B (A is m x n, B is n x p). */
+            static void MatrixProduct(const double* const A, const double* const B, double* C, int m, int n, int p);
+
+
+            /** C = A'*B, or C += A'*B if accumulate is set (A is m x n, B is m x p). */
+            static void TransposedMatrixProduct(const double* const A, const double* const B, double* C, int m, int n, int p, bool accumulate);
+
+
+            /** C = A'*B + B'*A (A and B are m x n, C is n x n). */
+            static void SymmetrizationProduct(const double* const A, const double* const B, double* C, int m, int n);
+
+
+            /** Returns p'*Q*p (Q is n x n and symmetric). The BLAS backend needs a buffer Qp of n doubles, without one the built-in kernels are used. */
+            static double QuadraticFormProduct(const double* const Q, const double* const p, int n, double* Qp = 0);
+
+
+            /** Whether the products are computed by an external BLAS (see the CMake option LCQPOW_USE_BLAS). */
+            static bool usesBLAS( );
+
+
+            /** Get the instruction set currently used by the kernels. */
+            static KernelInstructionSet getInstructionSet( );
+
+
+            /** Whether the CPU (and the build) supports the given instruction set. */
+            static bool isSupported( KernelInstructionSet isa );
+
+
+            /** Select the instruction set of the kernels (meant for tests and benchmarks; kernels already running on other threads finish with the previous one).
+             *
+             * @returns SUCCESSFUL_RETURN or INVALID_ARGUMENT if the instruction set is not supported.
+             */
+            static ReturnValue setInstructionSet( KernelInstructionSet isa );
+    };
+}
+
+#endif  // LCQPOW_DENSEKERNELS_HPP
@@ -0,0 +1,67 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#ifndef LCQPOW_ITERATIONCALLBACK_HPP
+#define LCQPOW_ITERATIONCALLBACK_HPP
+
+#include "Utilities.hpp"
+
+namespace LCQPow {
+
+    /**
+     *  Read-only view of the solver state passed to an iteration callback. The pointers refer to the solver's own memory
+     *  and are only valid during the call (copy the values that are needed later).
+     */
+    struct IterationData {
+        int totalIter;                                  /**< Total number of iterations. */
+        int outerIter;                                  /**< Number of outer iterations (penalty updates). */
+        int innerIter;                                  /**< Number of inner iterations of the current outer iteration. */
+        int subproblemIter;                             /**< Iterations of the most recent QP subproblem. */
+        double rho;                                     /**< Current penalty parameter. */
+        double stepLength;                              /**< Step length of the most recent step. */
+        double stepSize;                                /**< Maximum absolute entry of the most recent step. */
+        double statNorm;                                /**< Maximum absolute entry of the stationarity violation. */
+        double phi;                                     /**< Complementarity value (penalty function). */
+        double merit;                                   /**< Merit function value. */
+        int nV;                                         /**< Length of x, p and stat. */
+        int nDuals;                                     /**< Length of y. */
+        const double* x;                                /**< Current primal iterate. */
+        const double* y;                                /**< Current dual iterate (in penalty form until the solver terminated). */
+        const double* p;                                /**< Most recent step. */
+        const double* stat;                             /**< Stationarity violation at the primal iterate. */
+        ReturnValue status;                             /**< Return value of the solve (only set for EVENT_TERMINATION). */
+    };
+
+
+    /** An iteration callback is called by the solver on the events of CallbackEvent (see LCQProblem::setIterationCallback).
+     *
+     * @param event The event.
+     * @param data The solver state.
+     * @param userData The pointer passed to LCQProblem::setIterationCallback.
+     *
+     * @returns true to continue the solve, false to abort it with SOLVER_ABORTED_BY_CALLBACK (ignored for EVENT_TERMINATION).
+     */
+    typedef bool (*IterationCallback)( CallbackEvent event, const IterationData& data, void* userData );
+}
+
+#endif  // LCQPOW_ITERATIONCALLBACK_HPP
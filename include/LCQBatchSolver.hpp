@@ -0,0 +1,172 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef LCQPOW_LCQBATCHSOLVER_HPP
+#define LCQPOW_LCQBATCHSOLVER_HPP
+
+#include "LCQProblem.hpp"
+#include "OutputStatistics.hpp"
+#include "MessageHandler.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace LCQPow {
+
+    class LCQBatchSolver {
+
+        public:
+
+            /** Default constructor. */
+            LCQBatchSolver( );
+
+
+            /** Construct a batch solver from a structural template.
+             *
+             * @param _lcqp A loaded LCQP with its options set (and switched to sparse mode if a sparse solver is used).
+             *              Its matrices and the data derived from them (C, the pattern of Qk) are set up once and shared by the worker threads.
+             * @param _nThreads The number of worker threads. If a non-positive number is passed, then the number of hardware threads is used.
+             * @param _hotstart By default every instance is solved from a new subsolver, i.e. the results do not depend on the number of threads.
+             *                  Pass true to hotstart the subsolver of a worker from the instance it solved before. Each worker then solves a
+             *                  fixed, contiguous range of instances, i.e. the results are reproducible for a given number of threads.
+             */
+            LCQBatchSolver( const LCQProblem& _lcqp, int _nThreads = 0, bool _hotstart = false );
+
+
+            /** Solve a batch of LCQPs that only differ from the template in the linear term, bounds and initial guess.
+             *  All arrays hold the data of the instances stacked one after another.
+             *  If a `NULL` pointer is passed, then the data of the template is used for all instances.
+             *  Note that the output of the instances is interleaved if the template's print level is not NONE.
+             *  If the template's options set a dump file (see Options::setDumpFile), then the template is dumped once per batch.
+             *  Stored iterates are kept in the output statistics of the instances, a step file (see Options::setStepFile) is not written.
+             *
+             * @param _nInstances The number of LCQPs to be solved.
+             * @param _g The objectives' linear terms (nInstances x nV).
+             * @param _lbA The lower bounds associated to the constraint matrix `A` (nInstances x nC).
+             * @param _ubA The upper bounds associated to the constraint matrix `A` (nInstances x nC).
+             * @param _lb The box constraints' lower bounds (nInstances x nV).
+             * @param _ub The box constraints' upper bounds (nInstances x nV).
+             * @param _x0 The primal initial guesses (nInstances x nV).
+             * @param _y0 The dual initial guesses (nInstances x (nV + nC + 2*nComp)).
+             *
+             * @returns SUCCESSFUL_RETURN if all instances were solved. Otherwise the return value of the first failed instance is passed.
+             */
+            ReturnValue solve(
+                int _nInstances,
+                const double* const _g = 0,
+                const double* const _lbA = 0,
+                const double* const _ubA = 0,
+                const double* const _lb = 0,
+                const double* const _ub = 0,
+                const double* const _x0 = 0,
+                const double* const _y0 = 0
+            );
+
+
+            /** Get the number of instances solved in the most recent batch. */
+            int getNumberOfInstances( ) const;
+
+
+            /** Get the number of primal variables (of each instance). */
+            int getNumberOfPrimals( ) const;
+
+
+            /** Get the number of dual variables (of each instance). This depends on the utilized subproblem solver. */
+            int getNumberOfDuals( ) const;
+
+
+            /** Get the return value of runSolver for an instance.
+             *
+             * @param instance The index of the instance.
+             *
+             * @returns The return value of the instance or INDEX_OUT_OF_BOUNDS.
+             */
+            ReturnValue getReturnValue( int instance ) const;
+
+
+            /** Writes the primal solution vector of an instance.
+             *
+             * @param instance The index of the instance.
+             * @param xOpt A pointer to the vector to be filled (of length nV).
+             *
+             * @returns If the instance was solved successfully the stationarity type is passed. Else PROBLEM_NOT_SOLVED is returned.
+             */
+            AlgorithmStatus getPrimalSolution( int instance, double* const xOpt ) const;
+
+
+            /** Writes the dual solution vector of an instance.
+             *
+             * @param instance The index of the instance.
+             * @param yOpt A pointer to the vector to be filled (of length getNumberOfDuals()).
+             *
+             * @returns If the instance was solved successfully the stationarity type is passed. Else PROBLEM_NOT_SOLVED is returned.
+             */
+            AlgorithmStatus getDualSolution( int instance, double* const yOpt ) const;
+
+
+            /** Get the output statistics of an instance.
+             *
+             * @param instance The index of the instance.
+             * @param _stats The output statistics to be filled.
+             */
+            void getOutputStatistics( int instance, OutputStatistics& _stats ) const;
+
+
+        protected:
+
+            /** Solve instances until the batch is exhausted (executed by each worker thread).
+             *
+             * @param next The index of the next instance to be solved (shared by all workers). Pass `NULL` to solve the instances begin, ..., end-1.
+             * @param begin The first instance of the worker (ignored if next is passed).
+             * @param end The end of the instances of the worker.
+             * @param sink The message sink of the thread calling solve (used by the worker as well).
+             * @param sinkData The user data of the message sink.
+             */
+            void runWorker( std::atomic<int>* next, int begin, int end, MessageSink sink, void* sinkData );
+
+
+        private:
+            LCQProblem lcqp;                            /**< The structural template (each worker solves on a copy that shares its matrices). */
+            int nThreads = 1;                           /**< Number of worker threads. */
+            bool hotstart = false;                      /**< Whether the workers hotstart their subsolver from their previous instance. */
+
+            int nInstances = 0;                         /**< Number of instances of the most recent batch. */
+            int nDuals = 0;                             /**< Number of dual variables of each instance. */
+            int nDualsMax = 0;                          /**< Stride of the stored dual solutions (nV + nC + 2*nComp). */
+
+            const double* g = NULL;                     /**< Stacked linear terms of the current batch. */
+            const double* lbA = NULL;                   /**< Stacked constraint lower bounds of the current batch. */
+            const double* ubA = NULL;                   /**< Stacked constraint upper bounds of the current batch. */
+            const double* lb = NULL;                    /**< Stacked box lower bounds of the current batch. */
+            const double* ub = NULL;                    /**< Stacked box upper bounds of the current batch. */
+            const double* x0 = NULL;                    /**< Stacked primal initial guesses of the current batch. */
+            const double* y0 = NULL;                    /**< Stacked dual initial guesses of the current batch. */
+
+            std::vector<double> xOpt;                   /**< Primal solutions of all instances. */
+            std::vector<double> yOpt;                   /**< Dual solutions of all instances. */
+            std::vector<ReturnValue> retVals;           /**< Return values of all instances. */
+            std::vector<AlgorithmStatus> algoStats;     /**< Solution status of all instances. */
+            std::vector<OutputStatistics> stats;        /**< Output statistics of all instances. */
+    };
+}
+
+#endif  // LCQPOW_LCQBATCHSOLVER_HPP
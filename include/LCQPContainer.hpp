@@ -0,0 +1,237 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#ifndef LCQPOW_LCQPCONTAINER_HPP
+#define LCQPOW_LCQPCONTAINER_HPP
+
+#include "LCQProblem.hpp"
+#include "Options.hpp"
+#include "Utilities.hpp"
+
+#include <cstddef>
+
+namespace LCQPow {
+
+    /**
+     *  Sections of an LCQP container file. Matrices are either dense (row by row, the values section only) or csc (values,
+     *  column pointers and row indices). Absent sections (e.g. no A or no x0) have no data.
+     */
+    enum ContainerSection {
+        SECTION_Q = 0,                                  /**< Values of Q. */
+        SECTION_Q_P = 1,                                /**< Column pointers of Q (csc). */
+        SECTION_Q_I = 2,                                /**< Row indices of Q (csc). */
+        SECTION_G = 3,                                  /**< Linear term g. */
+        SECTION_L = 4,                                  /**< Values of L. */
+        SECTION_L_P = 5,                                /**< Column pointers of L (csc). */
+        SECTION_L_I = 6,                                /**< Row indices of L (csc). */
+        SECTION_R = 7,                                  /**< Values of R. */
+        SECTION_R_P = 8,                                /**< Column pointers of R (csc). */
+        SECTION_R_I = 9,                                /**< Row indices of R (csc). */
+        SECTION_A = 10,                                 /**< Values of A. */
+        SECTION_A_P = 11,                               /**< Column pointers of A (csc). */
+        SECTION_A_I = 12,                               /**< Row indices of A (csc). */
+        SECTION_LBL = 13,                               /**< Lower bounds of L*x. */
+        SECTION_UBL = 14,                               /**< Upper bounds of L*x. */
+        SECTION_LBR = 15,                               /**< Lower bounds of R*x. */
+        SECTION_UBR = 16,                               /**< Upper bounds of R*x. */
+        SECTION_LBA = 17,                               /**< Lower bounds of A*x. */
+        SECTION_UBA = 18,                               /**< Upper bounds of A*x. */
+        SECTION_LB = 19,                                /**< Lower box bounds. */
+        SECTION_UB = 20,                                /**< Upper box bounds. */
+        SECTION_X0 = 21,                                /**< Primal initial guess. */
+        SECTION_Y0 = 22,                                /**< Dual initial guess (nV + nC + 2*nComp, see LCQProblem::loadLCQP). */
+        SECTION_OPTIONS = 23,                           /**< Algorithmic options (doubles, see LCQPContainer::getOptions). */
+        SECTION_QPOASES_OPTIONS = 24,                   /**< qpOASES options (raw bytes, only valid for the same qpOASES build). */
+        SECTION_OSQP_OPTIONS = 25,                      /**< OSQP settings (raw bytes, only valid for the same OSQP build). */
+        NUMBER_OF_SECTIONS = 26                         /**< Number of sections. */
+    };
+
+
+    /**
+     *  A single-file container of an LCQP (file extension .lcqp) that is loaded without parsing. The file starts with a
+     *  64 byte header (magic, version, byte order mark, dimensions, format) followed by a table of the sections' offsets
+     *  and lengths. Every section starts at a 64 byte boundary and holds raw doubles or 32 bit integers in native byte order.
+     *  Containers written with options (e.g. snapshots of Options::setDumpFile) additionally hold the solver settings.
+     *
+     *  An opened container maps the file read-only into memory. Loading it into an LCQProblem references Q in the mapping
+     *  (see LCQProblem::loadLCQPBorrowed), i.e. the container must stay open as long as the problem is solved.
+     */
+    class LCQPContainer {
+
+        public:
+
+            /** Default constructor. */
+            LCQPContainer( );
+
+
+            /** Destructor (closes the container). */
+            ~LCQPContainer( );
+
+
+            /** Map a container file and validate its header and sections.
+             *
+             * @param filename The file.
+             *
+             * @returns SUCCESSFUL_RETURN or UNABLE_TO_READ_FILE if the file can not be mapped or is no valid container.
+             */
+            ReturnValue open( const char* filename );
+
+
+            /** Unmap the file. */
+            void close( );
+
+
+            /** Whether a container is opened. */
+            bool isOpen( ) const;
+
+
+            /** Whether the matrices are stored in csc format. */
+            bool isSparse( ) const;
+
+
+            /** Get the number of optimization variables. */
+            int getNV( ) const;
+
+
+            /** Get the number of linear constraints. */
+            int getNC( ) const;
+
+
+            /** Get the number of complementarity pairs. */
+            int getNComp( ) const;
+
+
+            /** Get the data of a section (`NULL` if it is absent, the row indices and column pointers are int arrays).
+             *
+             * @param section The section.
+             * @param count The number of entries of the section (optional).
+             */
+            const void* getSection( ContainerSection section, size_t* count = 0 ) const;
+
+
+            /** Load the LCQP into a solver of the same dimensions (dense or sparse, the QP solver of its options must match).
+             *
+             * @param lcqp The solver.
+             *
+             * @returns SUCCESSFUL_RETURN, LCQPOBJECT_NOT_SETUP if no container is open, INVALID_ARGUMENT if the dimensions differ
+             *  or the return value of loadLCQPBorrowed.
+             */
+            ReturnValue load( LCQProblem& lcqp ) const;
+
+
+            /** Get the options stored with the LCQP. The QP solver settings are only restored if they were written by the same
+             *  qpOASES and OSQP builds (their sizes match), otherwise the passed ones are kept.
+             *
+             * @param options The options to be overwritten.
+             *
+             * @returns SUCCESSFUL_RETURN, LCQPOBJECT_NOT_SETUP if no container is open or INVALID_ARGUMENT if no options are stored.
+             */
+            ReturnValue getOptions( Options& options ) const;
+
+
+            /** Write an LCQP in dense format (arguments as in the dense LCQProblem::loadLCQP and the options to be stored with it,
+             *  `NULL` pointers are omitted).
+             *
+             * @returns SUCCESSFUL_RETURN, INVALID_ARGUMENT on invalid dimensions or UNABLE_TO_WRITE_FILE if the file can not be written.
+             */
+            static ReturnValue write(
+                const char* filename,
+                int nV,
+                int nC,
+                int nComp,
+                const double* const Q,
+                const double* const g,
+                const double* const L,
+                const double* const R,
+                const double* const lbL = 0,
+                const double* const ubL = 0,
+                const double* const lbR = 0,
+                const double* const ubR = 0,
+                const double* const A = 0,
+                const double* const lbA = 0,
+                const double* const ubA = 0,
+                const double* const lb = 0,
+                const double* const ub = 0,
+                const double* const x0 = 0,
+                const double* const y0 = 0,
+                const Options* const options = 0
+            );
+
+
+            /** Write an LCQP in sparse format (arguments as in the sparse LCQProblem::loadLCQP and the options to be stored with it,
+             *  `NULL` pointers are omitted).
+             *
+             * @returns SUCCESSFUL_RETURN, INVALID_ARGUMENT on invalid dimensions or UNABLE_TO_WRITE_FILE if the file can not be written.
+             */
+            static ReturnValue write(
+                const char* filename,
+                int nV,
+                int nC,
+                int nComp,
+                const csc* const Q,
+                const double* const g,
+                const csc* const L,
+                const csc* const R,
+                const double* const lbL = 0,
+                const double* const ubL = 0,
+                const double* const lbR = 0,
+                const double* const ubR = 0,
+                const csc* const A = 0,
+                const double* const lbA = 0,
+                const double* const ubA = 0,
+                const double* const lb = 0,
+                const double* const ub = 0,
+                const double* const x0 = 0,
+                const double* const y0 = 0,
+                const Options* const options = 0
+            );
+
+
+        protected:
+
+            /** Validate the mapped file and set up the csc headers (returns false if it is no valid container). */
+            bool validate( );
+
+
+            /** Get a section as doubles (`NULL` if absent). */
+            const double* getDoubles( ContainerSection section ) const;
+
+
+        private:
+
+            LCQPContainer( const LCQPContainer& rhs );              /**< Containers are not copyable. */
+            LCQPContainer& operator=( const LCQPContainer& rhs );   /**< Containers are not copyable. */
+
+            void* mapping = NULL;                                   /**< The mapped file. */
+            size_t mappingSize = 0;                                 /**< Size of the mapped file in bytes. */
+
+            int nV = 0;                                             /**< Number of optimization variables. */
+            int nC = 0;                                             /**< Number of linear constraints. */
+            int nComp = 0;                                          /**< Number of complementarity pairs. */
+            bool sparse = false;                                    /**< Whether the matrices are stored in csc format. */
+
+            csc matrices[4];                                        /**< csc headers of Q, L, R and A referencing the mapping. */
+    };
+}
+
+#endif  // LCQPOW_LCQPCONTAINER_HPP
@@ -0,0 +1,104 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef LCQPOW_LCQPWORKSPACE_HPP
+#define LCQPOW_LCQPWORKSPACE_HPP
+
+#include <cstddef>
+
+namespace LCQPow {
+
+    /**
+     *  A memory arena holding the work vectors of a solver in one contiguous block.
+     *  The owner requests its buffers in a fixed order twice: first to count the memory (layout pass, see startLayout),
+     *  then to receive the buffers (after allocate). Every buffer starts at a cache line boundary and is zero initialized.
+     *  Requesting the buffers again in the same order after rewind (e.g. after copying the workspace) returns the same slices.
+     */
+    class LCQPWorkspace {
+
+        public:
+
+            /** Default constructor. */
+            LCQPWorkspace( );
+
+
+            /** Copy constructor (deep copy of the block, the copy is rewound). */
+            LCQPWorkspace( const LCQPWorkspace& rhs );
+
+
+            /** Destructor. */
+            ~LCQPWorkspace( );
+
+
+            /** Assignment operator (deep copy of the block, the copy is rewound). */
+            LCQPWorkspace& operator=( const LCQPWorkspace& rhs );
+
+
+            /** Release the memory and start a layout pass: subsequent requests are counted and return `NULL`. */
+            void startLayout( );
+
+
+            /** Allocate one block for the buffers requested during the layout pass and rewind. */
+            void allocate( );
+
+
+            /** Hand out the buffers from the start of the block again. */
+            void rewind( );
+
+
+            /** Release the memory (subsequent requests return `NULL`). */
+            void clear( );
+
+
+            /** Get the next buffer of n doubles (`NULL` during the layout pass or if the block is exhausted). */
+            double* getDoubles( size_t n );
+
+
+            /** Get the next buffer of n integers (`NULL` during the layout pass or if the block is exhausted). */
+            int* getInts( size_t n );
+
+
+            /** Get the size of the block in bytes. */
+            size_t getSize( ) const;
+
+
+        protected:
+
+            /** Copies all members from given rhs object. */
+            void copy( const LCQPWorkspace& rhs );
+
+
+            /** Reserve the next slice of the given size in bytes (returns `NULL` during the layout pass). */
+            void* take( size_t bytes );
+
+
+        private:
+
+            char* memory = NULL;                    /**< The allocated memory. */
+            char* block = NULL;                     /**< Start of the block (memory aligned to a cache line). */
+            size_t capacity = 0;                    /**< Size of the block in bytes. */
+            size_t position = 0;                    /**< Start of the next slice in bytes (total size during the layout pass). */
+            bool layoutPass = false;                /**< Whether the requests are only counted. */
+    };
+}
+
+#endif  // LCQPOW_LCQPWORKSPACE_HPP
@@ -24,13 +24,18 @@
 #define LCQPOW_LCQPROBLEM_HPP
 
 #include "Utilities.hpp"
+#include "ConstraintMatrix.hpp"
+#include "LCQPWorkspace.hpp"
 #include "Subsolver.hpp"
 #include "OutputStatistics.hpp"
+#include "TrajectoryWriter.hpp"
 #include "Options.hpp"
+#include "IterationCallback.hpp"
 
 #include <qpOASES.hpp>
+#include <chrono>
+#include <memory>
 #include <vector>
-#include <deque>
 
 using qpOASES::QProblem;
 
@@ -60,11 +65,26 @@ namespace LCQPow {
 			);
 
 
+			/** Copy constructor (deep copy).
+			 *
+			 * @param rhs The object to be copied.
+			 */
+			LCQProblem( const LCQProblem& rhs );
+
+
 			/** Destructor. */
-			~LCQProblem( );
+			virtual ~LCQProblem( );
+
+
+			/** Assignment operator (deep copy).
+			 *
+			 * @param rhs The object from which to assign.
+			 */
+			LCQProblem& operator=( const LCQProblem& rhs );
 
 
 			/** Run solver passing the desired LCQP in dense format (qpOASES is used on subsolver level).
+			 *  The object can be loaded again (e.g. with the next problem of the same dimensions), the memory of the previous load is reused.
 			 *
 			 * @param _Q The objective's hessian matrix.
 			 * @param _g The obective's linear term.
@@ -104,7 +124,8 @@ namespace LCQPow {
 
 
 			/** Run solver passing the desired LCQP in (file) dense format (qpOASES is used on subsolver level).
-			 *  All matrices are assumed to be stored row-wise.
+			 *  All matrices are assumed to be stored row-wise. The format of each file is given by its extension (see Utilities::getFileFormat):
+			 *  text, raw binary (.bin) or Matrix Market (.mtx). If all matrices are Matrix Market files the problem is loaded in sparse format.
 			 *
 			 * @param Q_file The objective's hessian matrix.
 			 * @param g_file The obective's linear term.
@@ -144,6 +165,7 @@ namespace LCQPow {
 
 
 			/** Run solver passing the desired LCQP in sparse format (OSQP is used on subsolver level).
+			 *  The object can be loaded again, the memory of the previous load is reused if the number of entries of Q is unchanged.
 			 *
 			 * @param _Q Hessian matrix in csc sparse format.
 			 * @param _g The objective's linear term.
@@ -182,6 +204,57 @@ namespace LCQPow {
 			);
 
 
+			/** Load the desired LCQP in dense format without copying the Hessian matrix Q.
+			 *  The solver only keeps a reference to it. The matrices A, L and R are stored once, in the stacked constraint matrix required by the QP solvers.
+			 *  The caller guarantees that the matrices outlive this object (or the next call of loadLCQP) and are not modified meanwhile.
+			 *  All arguments follow the conventions of the dense loadLCQP, vectors are still copied.
+			 *
+			 * @returns SUCCESSFUL_RETURN if the data was loaded successfully. Otherwise the return value will indicate an occured error.
+			*/
+			ReturnValue loadLCQPBorrowed(
+				const double* const _Q,
+				const double* const _g,
+				const double* const _L,
+				const double* const _R,
+				const double* const lbL = 0,
+				const double* const ubL = 0,
+				const double* const lbR = 0,
+				const double* const ubR = 0,
+				const double* const _A = 0,
+				const double* const _lbA = 0,
+				const double* const _ubA = 0,
+				const double* const _lb = 0,
+				const double* const _ub = 0,
+				const double* const _x0 = 0,
+				const double* const _y0 = 0
+			);
+
+
+			/** Load the desired LCQP in sparse format without copying the Hessian matrix Q (see the dense loadLCQPBorrowed).
+			 *  The caller guarantees that the matrices outlive this object (or the next call of loadLCQP) and are not modified meanwhile.
+			 *  All arguments follow the conventions of the sparse loadLCQP, vectors are still copied.
+			 *
+			 * @returns SUCCESSFUL_RETURN if the data was loaded successfully. Otherwise the return value will indicate an occured error.
+			*/
+			ReturnValue loadLCQPBorrowed(
+				const csc* const _Q,
+				const double* const _g,
+				const csc* const _L,
+				const csc* const _R,
+				const double* const lbL = 0,
+				const double* const ubL = 0,
+				const double* const lbR = 0,
+				const double* const ubR = 0,
+				const csc* const _A = 0,
+				const double* const _lbA = 0,
+				const double* const _ubA = 0,
+				const double* const _lb = 0,
+				const double* const _ub = 0,
+				const double* const _x0 = 0,
+				const double* const _y0 = 0
+			);
+
+
 			/** Switch to sparse mode (if initialized with dense data but want to use sparse solver). */
 			ReturnValue switchToSparseMode( );
 
@@ -196,6 +269,64 @@ namespace LCQPow {
 			ReturnValue runSolver( );
 
 
+			/** Update the objective's linear term of an already loaded LCQP (no memory is allocated).
+			 *  The matrices and the subsolver are kept, such that a subsequent call of resolve can hotstart.
+			 *
+			 * @param _g The new objective's linear term.
+			 *
+			 * @returns SUCCESSFUL_RETURN on success. Otherwise the return value will indicate an occured error.
+			 */
+			ReturnValue updateLinearTerm( const double* const _g );
+
+
+			/** Update the bounds of an already loaded LCQP (the matrices and the subsolver are kept).
+			 *  All pointers follow the conventions of loadLCQP.
+			 *
+			 * @param _lb The box constraint's lower bounds. A `NULL` pointer can be passed if no lower bounds exist.
+			 * @param _ub The box constraint's upper bounds. A `NULL` pointer can be passed if no upper bounds exist.
+			 * @param _lbA The lower bounds associated to the constraint matrix `A`. A `NULL` pointer can be passed if no lower bounds exist.
+			 * @param _ubA The upper bounds associated to the constraint matrix `A`. A `NULL` pointer can be passed if no upper bounds exist.
+			 * @param _lbL The lower bounds associated to the complementarity matrix `L`. A `NULL` leads to zero bounds.
+			 * @param _ubL The upper bounds associated to the complementarity matrix `L`. A `NULL` pointer can be passed if no upper bounds exist.
+			 * @param _lbR The lower bounds associated to the complementarity matrix `R`. A `NULL` leads to zero bounds.
+			 * @param _ubR The upper bounds associated to the complementarity matrix `R`. A `NULL` pointer can be passed if no upper bounds exist.
+			 *
+			 * @returns SUCCESSFUL_RETURN on success. Otherwise the return value will indicate an occured error.
+			 */
+			ReturnValue updateBounds(
+				const double* const _lb,
+				const double* const _ub,
+				const double* const _lbA,
+				const double* const _ubA,
+				const double* const _lbL = 0,
+				const double* const _ubL = 0,
+				const double* const _lbR = 0,
+				const double* const _ubR = 0
+			);
+
+
+			/** Solve the LCQP again after its data was updated (e.g. in a closed-loop MPC step).
+			 *  The first QP subproblem is hotstarted from the active set (qpOASES) or workspace (OSQP) of the previous call.
+			 *  If no previous QP sequence exists (e.g. runSolver was not called yet or the QP solver changed) a cold start is performed.
+			 *
+			 * @param _x0 The primal initial guess. If a `NULL` pointer is passed the previous solution is used.
+			 * @param _y0 The dual initial guess (only used by a cold start). A `NULL` pointer can be passed.
+			 *
+			 * @returns SUCCESSFUL_RETURN if a solution is found. Otherwise the return value will indicate an occured error. */
+			ReturnValue resolve(
+				const double* const _x0 = 0,
+				const double* const _y0 = 0
+			);
+
+
+			/** Reset the solver state (iterates, statistics and QP sequence) but keep the loaded data, the problem buffers and the subsolver.
+			 *  The next call of runSolver or resolve starts cold from the initial guess (e.g. before handing the object to the next user).
+			 *  If the matrices loaded meanwhile have the same dimensions and sparsity patterns, only their values are passed to the subsolver,
+			 *  i.e. it keeps its memory (e.g. the OSQP workspace). Otherwise, or if new options are set, the subsolver is set up again.
+			 */
+			void reset( );
+
+
 			/** Writes the primal solution vector.
 			 *
 			 * @param xOpt A pointer to the desired primal solution storage vector.
@@ -235,6 +366,13 @@ namespace LCQPow {
 			virtual void getOutputStatistics( OutputStatistics& stats) const;
 
 
+			/** Get the output statistics without copying them (e.g. with many stored iterates).
+			 *
+			 * @returns A reference to the statistics of the most recent solve, valid until the next solve or the destruction of the object.
+			 */
+			const OutputStatistics& getOutputStatistics( ) const;
+
+
 			/** Pass options for the LCQP.
 			 *
 			 * @param _options Options to be used.
@@ -242,6 +380,18 @@ namespace LCQPow {
 			inline void setOptions(	const Options& _options	);
 
 
+			/** Register a callback that is called after each inner iteration, after each penalty update and on termination.
+			 *  It receives read-only views of the iterates (nothing is copied) and can abort the solve. The callback is kept by
+			 *  reset and copies. Building with LCQPOW_NO_CALLBACKS removes all calls from the solver loop.
+			 *
+			 * @param callback The callback. A `NULL` pointer removes the current callback.
+			 * @param userData A pointer passed to each call of the callback.
+			 *
+			 * @returns SUCCESSFUL_RETURN or CALLBACKS_DISABLED if the library was built with LCQPOW_NO_CALLBACKS.
+			 */
+			ReturnValue setIterationCallback( IterationCallback callback, void* userData = 0 );
+
+
 		/**
     	 *	PROTECTED METHODS
 		 */
@@ -250,6 +400,27 @@ namespace LCQPow {
 			void clear( );
 
 
+			/** Clears the problem matrices and their derived data (borrowed matrices are only dropped). */
+			void clearMatrices( );
+
+
+			/** Called before loading the problem matrices. Releases those of a previous load that can not be reused,
+			 *  i.e. owned buffers are only kept for owned loads of the same format (borrowed matrices are only dropped).
+			 *
+			 * @param sparseLoad Whether the new matrices are sparse.
+			 * @param borrowedLoad Whether the new matrices are borrowed (see loadLCQPBorrowed).
+			 */
+			void releaseMatrices( bool sparseLoad, bool borrowedLoad );
+
+
+			/** Copies all members from given rhs object.
+			 *
+			 * @param rhs The object to be copied.
+			 * @param shareMatrices Whether to share the matrices of rhs instead of copying them (see the sharing copy constructor).
+			 */
+			void copy( const LCQProblem& rhs, bool shareMatrices = false );
+
+
 			/** Prints concise information on the current iteration. */
 			void printIteration( );
 
@@ -262,20 +433,32 @@ namespace LCQPow {
 			void printLine();
 
 
+			/** Start the wall-clock timers of a solve. */
+			void startTiming( );
+
+
+			/** Add the time since the end of the previous phase to the given phase of the output statistics. */
+			void finishPhase( SolverPhase phase );
+
+
+			/** Attribute the remaining time to bookkeeping and store the total time of the solve. */
+			void finishTiming( );
+
+
 			/** Set the complementarity bounds. */
 			ReturnValue setComplementarityBounds(const double* const lbL_new, const double* const ubL_new, const double* const lbR_new, const double* const ubR_new);
 
 
 			/** Store the (dense) Hessian matrix Q internally.
 			 *
-			 * @param Q_new New dense Hessian matrix (with correct dimension!), a shallow copy is made.
+			 * @param Q_new New dense Hessian matrix (with correct dimension!), a deep copy is made unless the data is borrowed.
 			 */
 			inline ReturnValue setQ( const double* const Q_new );
 
 
 			/** Store the (sparse) Hessian matrix Q internally.
 			 *
-			 * @param Q_new Hessian matrix in csc sparse format.
+			 * @param Q_new Hessian matrix in csc sparse format, a deep copy is made unless the data is borrowed.
 			 */
 			inline ReturnValue setQ( const csc* const Q_new );
 
@@ -323,6 +506,17 @@ namespace LCQPow {
 			);
 
 
+			/** Store the box constraints as passed by the user (lb and ub are built from them once the subsolver is known).
+			 *
+			 * @param lb_new The box constraint's lower bounds. A `NULL` pointer can be passed if no lower bounds exist.
+			 * @param ub_new The box constraint's upper bounds. A `NULL` pointer can be passed if no upper bounds exist.
+			 */
+			inline void setBoxBounds(
+				const double* const lb_new,
+				const double* const ub_new
+			);
+
+
 			/** Set the new linear constraint consisting of (dense) complementarity pairs and regular linear constraints.
 			 *
 			 * @param L_new New lhs complementarity matrix.
@@ -374,10 +568,40 @@ namespace LCQPow {
 			);
 
 
-			/** Set Qk. */
+			/** Symbolic phase of Qk = Q + rho*C (sparse mode only).
+			 *  Computes the union pattern of Q and C once and remembers where their entries are located in Qk.
+			 */
+			void setQkPattern( );
+
+
+			/** Set Qk = Q + rho*C for the current penalty parameter (numeric phase in sparse mode, no allocations). */
 			void setQk( );
 
 
+			/** Whether both L and R are selector matrices (see ConstraintMatrix::getSelectorColumns). */
+			bool hasSelectorComplementarities( ) const;
+
+
+			/** Compute Qkv = Qk*v and Cv = C*v in one sweep (in sparse mode over the common pattern of Qk). */
+			void multiplyQkAndC( const double* const v, double* Qkv, double* Cv ) const;
+
+
+			/** Evaluate Qk*xk, C*xk, L*xk, R*xk (unless they are cached for the current iterate) and the penalty function at xk. */
+			void evaluateIterate( );
+
+
+			/** Evaluate the penalty function phi(xk) = (L*xk - lbL)'*(R*xk - lbR) from the cached L*xk and R*xk (O(nComp)). */
+			void evaluatePhi( );
+
+
+			/** Evaluate Qk*pk, C*pk, L*pk and R*pk for the current step. */
+			void evaluateStep( );
+
+
+			/** Drop the cached products (required whenever xk or Qk change other than by updateStep). */
+			void resetEvaluation( );
+
+
 		/**
 		 *	PROTECTED MEMBER VARIABLES
 		 */
@@ -390,8 +614,89 @@ namespace LCQPow {
 		 */
 		private:
 
-			/** Called in runSolver to initialize variables. */
-			ReturnValue initializeSolver( );
+			friend class LCQBatchSolver;
+
+			/** Symbolic phase of Qk = Q + rho*C in sparse mode (it does not change with rho, copies share it). */
+			struct QkPattern {
+				std::vector<int> indices_of_Q;		/**< Indices of Qk corresponding to the entries of Q. */
+				std::vector<int> indices_of_C;		/**< Indices of Qk corresponding to the entries of C. */
+				std::vector<double> C_on_Qk;		/**< Entries of C scattered to the pattern of Qk (allows fused products with Qk and C). */
+			};
+
+			/** Copy constructor that shares the matrices Q, C and [A; L; R] of rhs instead of copying them (used for the workers of LCQBatchSolver).
+			 *  Only the data that changes during a solve is copied. rhs must outlive the copy and must not be loaded again meanwhile.
+			 *
+			 * @param rhs The object to be copied.
+			 * @param shareMatrices Pass true to share the matrices.
+			 */
+			LCQProblem( const LCQProblem& rhs, bool shareMatrices );
+
+			/** Load the data of a dense LCQP (called by loadLCQP and loadLCQPBorrowed, see their documentation). */
+			ReturnValue loadProblemData(
+				const double* const _Q, const double* const _g,
+				const double* const _L, const double* const _R,
+				const double* const _lbL, const double* const _ubL,
+				const double* const _lbR, const double* const _ubR,
+				const double* const _A, const double* const _lbA, const double* const _ubA,
+				const double* const _lb, const double* const _ub,
+				const double* const _x0, const double* const _y0
+			);
+
+			/** Load the data of a sparse LCQP (called by loadLCQP and loadLCQPBorrowed, see their documentation). */
+			ReturnValue loadProblemData(
+				const csc* const _Q, const double* const _g,
+				const csc* const _L, const csc* const _R,
+				const double* const _lbL, const double* const _ubL,
+				const double* const _lbR, const double* const _ubR,
+				const csc* const _A, const double* const _lbA, const double* const _ubA,
+				const double* const _lb, const double* const _ub,
+				const double* const _x0, const double* const _y0
+			);
+
+			/** Called in runSolver (and resolve) to initialize variables.
+			 *
+			 * @param reuseSubsolver Pass true to keep the current subsolver (and its QP sequence) instead of setting up a new one.
+			 */
+			ReturnValue initializeSolver( bool reuseSubsolver = false );
+
+			/** The main loop of the algorithm (called after initialization).
+			 *
+			 * @param initialSolve Pass true if the first QP must initialize a new QP sequence, false if it can be hotstarted.
+			 */
+			ReturnValue runHomotopy( bool initialSolve );
+
+			/** Solve from the current initial guess and hotstart the QP sequence of the subsolver (called by resolve and LCQBatchSolver).
+			 *  Falls back to runSolver if the subsolver holds no QP sequence (e.g. before the first solve or after a failed one).
+			 */
+			ReturnValue runHotstartedSolver( );
+
+			/** Set the bounds of the first nC rows of the constraint matrix (the remaining rows hold the complementarity bounds).
+			 *
+			 * @param lbA_new The lower bounds. A `NULL` pointer can be passed if no lower bounds exist.
+			 * @param ubA_new The upper bounds. A `NULL` pointer can be passed if no upper bounds exist.
+			 */
+			void setConstraintBounds( const double* const lbA_new, const double* const ubA_new );
+
+			/** Replace the instance dependent data of an already loaded LCQP (used by LCQBatchSolver).
+			 *  All pointers follow the conventions of loadLCQP, i.e. a `NULL` pointer means that no bounds (or initial guess) exist.
+			 *
+			 * @param _g The objective's linear term.
+			 * @param _lbA The lower bounds associated to the constraint matrix `A`.
+			 * @param _ubA The upper bounds associated to the constraint matrix `A`.
+			 * @param _lb The box constraint's lower bounds.
+			 * @param _ub The box constraint's upper bounds.
+			 * @param _x0 The primal initial guess.
+			 * @param _y0 The dual initial guess.
+			 */
+			ReturnValue setInstanceData(
+				const double* const _g,
+				const double* const _lbA,
+				const double* const _ubA,
+				const double* const _lb,
+				const double* const _ub,
+				const double* const _x0,
+				const double* const _y0
+			);
 
 			/** Update the penalty linearization. */
 			void updateLinearization( );
@@ -402,6 +707,9 @@ namespace LCQPow {
 			 */
 			ReturnValue solveQPSubproblem( bool initialSolve );
 
+			/** Evaluate the primal and dual residuals of the QP solution (xnew, yk) from the QP data. */
+			void evaluateQPResiduals( );
+
 			/** Check outer stationarity at current iterate xk. */
 			bool stationarityCheck( );
 
@@ -423,7 +731,7 @@ namespace LCQPow {
 			/** Get optimal step length. */
 			void getOptimalStepLength( );
 
-			/** Update xk and gk. */
+			/** Update xk and the cached products Qk*xk, C*xk along the step. */
 			void updateStep( );
 
 			/** Update gradient of Lagrangian. */
@@ -432,9 +740,6 @@ namespace LCQPow {
 			/** Check the dynamic penalty update strategy by Leyffer. */
 			bool leyfferCheckPositive( );
 
-			/** Update Qk. */
-			void updateQk( );
-
 			/** Update outer iteration counter. */
 			void updateOuterIter( );
 
@@ -450,20 +755,46 @@ namespace LCQPow {
 			/** Store detailed steps to output stats. */
 			void storeSteps( );
 
+			/** Close the step file of the current solve (prints a warning if writing it failed). */
+			void closeStepFile( );
+
+			/** Write the problem data, initial guess and options as passed to the solver to a container (see Options::setDumpFile).
+			 *
+			 * @param filename The file.
+			 *
+			 * @returns SUCCESSFUL_RETURN, LCQPOBJECT_NOT_SETUP if no problem is loaded or the return value of LCQPContainer::write.
+			 */
+			ReturnValue dumpProblem( const char* const filename );
+
+			/** Whether a callback is registered (always false if built with LCQPOW_NO_CALLBACKS). */
+			bool hasIterationCallback( ) const;
+
+			/** Call the iteration callback with the current iterate.
+			 *
+			 * @param event The event.
+			 * @param status The return value of the solve (for EVENT_TERMINATION).
+			 *
+			 * @returns Whether the solve should continue.
+			 */
+			bool notifyIterationCallback( CallbackEvent event, ReturnValue status = SUCCESSFUL_RETURN );
+
 			/** Transform the dual variables from penalty form to LCQP form. */
 			void transformDuals( );
 
 			/** Determine stationarity type of optimal solution. */
 			void determineStationarityType( );
 
-			/** Get indices of weak complementarites. */
-			std::vector<int> getWeakComplementarities( );
+			/** Store the indices of the weak complementarites in weakComp and return their number. */
+			int getWeakComplementarities( );
 
-			int nV;									/**< Number of variables. */
-			int nC;									/**< Number of constraints. */
-			int nComp;								/**< Number of complementarity constraints. */
-			int nDuals; 							/**< Number of duals variables. */
-			int boxDualOffset;						/**< Offset for linear constraint duals (i.e. 0 if no BC (Box Constraints) exist nV if BC exist). */
+			/** Assign the auxiliar vectors to their slices of the workspace (the order defines the layout). */
+			void carveWorkspace( );
+
+			int nV = 0;								/**< Number of variables. */
+			int nC = 0;								/**< Number of constraints. */
+			int nComp = 0;							/**< Number of complementarity constraints. */
+			int nDuals = 0;							/**< Number of duals variables. */
+			int boxDualOffset = 0;					/**< Offset for linear constraint duals (i.e. 0 if no BC (Box Constraints) exist nV if BC exist). */
 
 			double* Q = NULL;						/**< Objective Hessian term. */
 
@@ -471,65 +802,101 @@ namespace LCQPow {
 
 			double* lb = NULL;						/**< Lower bound vector (on variables). */
 			double* ub = NULL;						/**< Upper bound vector (on variables). */
-			double* lb_tmp = NULL;					/**< Temporary box constraints. */
-			double* ub_tmp = NULL;					/**< Temporary box constraints. */
+			double* lb_tmp = NULL;					/**< Box constraints as passed by the user (lb is built from them once the solver is known). */
+			double* ub_tmp = NULL;					/**< Box constraints as passed by the user (ub is built from them once the solver is known). */
 
-			double* A = NULL;						/**< Constraint matrix. */
+			std::shared_ptr<ConstraintMatrix> constraints = std::make_shared<ConstraintMatrix>();	/**< Stacked constraint matrix [A; L; R] (dense or sparse). */
 			double* lbA = NULL;						/**< Lower bound vector (on constraints). */
 			double* ubA = NULL;						/**< Upper bound vector (on constraints). */
 
-			double* L = NULL;						/**< LHS of complementarity product. */
-			double* R = NULL;						/**< RHS of complementarity product. */
 			double* C = NULL;						/**< Complementarity matrix (L'*R + R'*L). */
 			double* lbL = NULL;						/**< LHS Complementarity lower bounds. */
 			double* ubL = NULL;						/**< LHS Complementarity upper bounds. */
 			double* lbR = NULL;						/**< RHS Complementarity lower bounds. */
 			double* ubR = NULL;						/**< RHS Complementarity upper bounds. */
 			double* g_phi = NULL;					/**< Linear Term of phi -(l_L'*R + l_R'*L). */
-			double phi_const = 0;					/**< Constant phi expression (l_L'*l_R). */
 
-			double rho; 							/**< Current penalty value. */
+			double rho = 0;							/**< Current penalty value. */
 
 			double* g_tilde = NULL;					/**< Current linear terms (g + rhok*g_phi). Updated once per inner loop. */
 			double* gk = NULL;						/**< Current objective linear term. */
 
+			double* x0 = NULL;						/**< Primal initial guess (each call of runSolver starts here). */
+			double* y0 = NULL;						/**< Dual initial guess (box, linear, complementarity duals). */
+
 			double* xk = NULL;						/**< Current primal iterate. */
 			double* yk = NULL;						/**< Current dual vector. */
 			double* yk_A = NULL;					/**< Current dual vector w.r.t A. */
 			double* xnew = NULL;					/**< Current qpSubproblem solution. */
 			double* pk = NULL;						/**< xnew - xk. */
 
-			double alphak; 							/**< Optimal step length. */
-			double* lk_tmp = NULL;					/**< An auxiliar vector to help compute lkj. */
+			double alphak = 0;						/**< Optimal step length. */
 
-			double* Qk = NULL;						/**< Q + rho*C, required for stationarity and optimal step length. */
+			double* Qk = NULL;						/**< Q + rho*C, required for stationarity and optimal step length (dense mode, allocated with C). */
 			double* statk = NULL;					/**< Stationarity of current iterate. */
-			double* constr_statk = NULL;			/**< Constraint contribution to stationarity equation. */
 			double* box_statk = NULL;				/**< Box Constraint contribution to stationarity equation. */
-
-			int outerIter;							/**< Outer iterate counter. */
-			int innerIter;							/**< Inner iterate counter. */
-			int totalIter;							/**< Total iterate counter. */
-
-			int qpIterk;							/**< Iterations taken by qpSolver to solve subproblem. */
-			int qpSolverExitFlag;					/**< Most recent exit flag of QP solver. */
-			AlgorithmStatus algoStat;				/**< Status of algorithm. */
+			double statNormk = 0;					/**< Infinity norm of statk. */
+
+			double* Qkxk = NULL;					/**< Qk*xk of the current iterate (see evaluateIterate). */
+			double* Cxk = NULL;						/**< C*xk of the current iterate (see evaluateIterate). */
+			double* Qkpk = NULL;					/**< Qk*pk of the current step (see evaluateStep). */
+			double* Cpk = NULL;						/**< C*pk of the current step (see evaluateStep). */
+			double* LRxk = NULL;					/**< [L*xk; R*xk] of the current iterate (see evaluateIterate). */
+			double* LRpk = NULL;					/**< [L*pk; R*pk] of the current step (see evaluateStep). */
+			double* qpResidual = NULL;				/**< Stationarity residual of the QP solution (see evaluateQPResiduals). */
+			double* qpAx = NULL;					/**< [A; L; R]*xnew of the QP solution (see evaluateQPResiduals). */
+			double* Qxk = NULL;						/**< Buffer for Q*xk of the objective (see getObj). */
+			double phik = 0;						/**< Penalty function at the current iterate. */
+			bool iterateEvaluated = false;			/**< Whether Qkxk, Cxk, LRxk and phik belong to the current xk and Qk. */
+			bool stepEvaluated = false;				/**< Whether Qkpk, Cpk and LRpk belong to the current pk and Qk. */
+			bool iterateUpdated = false;			/**< Whether the products of the iterate were updated along the step instead of evaluated from scratch. */
+
+			int outerIter = 0;						/**< Outer iterate counter. */
+			int innerIter = 0;						/**< Inner iterate counter. */
+			int totalIter = 0;						/**< Total iterate counter. */
+
+			int qpIterk = 0;						/**< Iterations taken by qpSolver to solve subproblem. */
+			int qpSolverExitFlag = 0;				/**< Most recent exit flag of QP solver. */
+			AlgorithmStatus algoStat = PROBLEM_NOT_SOLVED;	/**< Status of algorithm. */
 
 			bool sparseSolver = false;				/**< Whether to use sparse algebra or dense. */
+			bool borrowedData = false;				/**< Whether Q (dense or sparse) references user data (see loadLCQPBorrowed). */
+			bool sharedMatrices = false;			/**< Whether Q, C and the constraint matrix belong to another object (see the sharing copy constructor). */
 
 			csc* Q_sparse = NULL;					/**< Sparse objective Hessian matrix. */
-			csc* A_sparse = NULL;					/**< Sparse constraint matrix. */
-			csc* L_sparse = NULL;					/**< Sparse L. */
-			csc* R_sparse = NULL;					/**< Sparse R. */
 			csc* C_sparse = NULL;					/**< Sparse C. */
 			csc* Qk_sparse = NULL;					/**< Sparse Qk. */
-			std::vector<int> Qk_indices_of_C;		/**< Remember the indices of Qk corresponding to C (for fast Qk update). */
+			std::shared_ptr<const QkPattern> Qk_pattern;	/**< Symbolic phase of Qk (see setQkPattern). */
+
+			std::vector<double> complHistory; 		/**< Ring buffer containing the previous complementarity values. */
+			size_t complHistoryLength = 0;			/**< Number of values stored in complHistory. */
+			size_t complHistoryOldest = 0;			/**< Position of the oldest value in complHistory (once it is full). */
+
+			unsigned long long perturbationCounter = 0;	/**< Number of random numbers drawn for the perturbations (restarts on each solve, see Utilities::AddRandomPerturbation). */
+
+			std::chrono::steady_clock::time_point solveStart;	/**< Start of the current solve. */
+			std::chrono::steady_clock::time_point phaseStart;	/**< End of the previous phase of the current solve. */
+			double loadTime = 0;					/**< Wall-clock time of the most recent load (added to the setup time of the next solve). */
+
+			double qpSolveTime = 0;					/**< Wall-clock time of the most recent QP solve. */
+			int qpRhoUpdates = 0;					/**< Rho updates of the most recent QP solve (OSQP). */
+			int qpFactorizations = 0;				/**< Factorizations of the most recent QP solve. */
+			double qpPrimalResidual = 0;			/**< Primal residual of the most recent QP solution (only evaluated if steps are stored). */
+			double qpDualResidual = 0;				/**< Dual residual of the most recent QP solution (only evaluated if steps are stored). */
+
+			IterationCallback iterationCallback = NULL;	/**< Callback on iterations, penalty updates and termination (see setIterationCallback). */
+			void* iterationCallbackData = NULL;		/**< User data passed to the callback. */
+
+			int* weakComp = NULL;					/**< Indices of the weak complementarities (see getWeakComplementarities). */
 
-			std::deque<double> complHistory; 		/**< Vector containing the previous complementarity values. */
+			LCQPWorkspace workspace;				/**< Memory of the auxiliar vectors (allocated once by the constructor). */
 
 			Subsolver subsolver;					/**< Subsolver class for solving the QP subproblems. */
+			bool qpSequenceInitialized = false;		/**< Whether the subsolver holds an initialized QP sequence that can be hotstarted. */
+			bool keepSubsolver = false;				/**< Whether the next runSolver passes the matrices to the subsolver instead of setting it up again (see reset). */
 
 			OutputStatistics stats;					/**< Output statistics. */
+			TrajectoryWriter stepWriter;			/**< Writer of the stored iterates (only open during a solve with a step file). */
 	};
 }
 
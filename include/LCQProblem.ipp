@@ -29,8 +29,16 @@ namespace LCQPow {
 		if (nV <= 0)
 			return LCQPOBJECT_NOT_SETUP;
 
-		Q = new double[nV*nV];
-		memcpy( Q, Q_new, (size_t)(nV*nV)*sizeof(double) );
+		// Borrowed data is never written to
+		if (borrowedData) {
+			Q = const_cast<double*>(Q_new);
+			return SUCCESSFUL_RETURN;
+		}
+
+		if (Utilities::isNullPtr(Q))
+			Q = new double[(size_t)nV*(size_t)nV];
+
+		memcpy( Q, Q_new, (size_t)nV*(size_t)nV*sizeof(double) );
 
 		return SUCCESSFUL_RETURN;
 	}
@@ -44,7 +52,9 @@ namespace LCQPow {
 		if ( Utilities::isNullPtr(g_new) )
 			return INVALID_OBJECTIVE_LINEAR_TERM;
 
-		g = new double[nV];
+		if (Utilities::isNullPtr(g))
+			g = new double[nV];
+
 		memcpy( g, g_new, (size_t)nV*sizeof(double) );
 
 		return SUCCESSFUL_RETURN;
@@ -56,7 +66,8 @@ namespace LCQPow {
 		if ( nV == 0 )
 			return LCQPOBJECT_NOT_SETUP;
 
-		lb = new double[nV];
+		if (Utilities::isNullPtr(lb))
+			lb = new double[nV];
 
 		if (Utilities::isNotNullPtr(lb_new))
 		{
@@ -95,7 +106,8 @@ namespace LCQPow {
 		if ( nV == 0 )
 			return LCQPOBJECT_NOT_SETUP;
 
-		ub = new double[nV];
+		if (Utilities::isNullPtr(ub))
+			ub = new double[nV];
 
 		if (Utilities::isNotNullPtr(ub_new))
 		{
@@ -130,28 +142,66 @@ namespace LCQPow {
 	}
 
 
+	inline void LCQProblem::setBoxBounds( const double* const lb_new, const double* const ub_new )
+	{
+		if (Utilities::isNotNullPtr(lb_new)) {
+			if (Utilities::isNullPtr(lb_tmp))
+				lb_tmp = new double[nV];
+
+			memcpy(lb_tmp, lb_new, (size_t)nV*sizeof(double));
+		} else if (Utilities::isNotNullPtr(lb_tmp)) {
+			delete[] lb_tmp;
+			lb_tmp = NULL;
+		}
+
+		if (Utilities::isNotNullPtr(ub_new)) {
+			if (Utilities::isNullPtr(ub_tmp))
+				ub_tmp = new double[nV];
+
+			memcpy(ub_tmp, ub_new, (size_t)nV*sizeof(double));
+		} else if (Utilities::isNotNullPtr(ub_tmp)) {
+			delete[] ub_tmp;
+			ub_tmp = NULL;
+		}
+	}
+
+
 	inline ReturnValue LCQProblem::setInitialGuess( const double* const _x0, const double* const _y0 )
 	{
 		if ( nV == 0 || nComp == 0)
 			return LCQPOBJECT_NOT_SETUP;
 
-		xk = new double[nV]();
+		if (Utilities::isNullPtr(x0))
+			x0 = new double[nV];
+
+		if (Utilities::isNullPtr(xk))
+			xk = new double[nV];
 
 		if (Utilities::isNotNullPtr(_x0)) {
-			memcpy(xk, _x0, (size_t)nV*sizeof(double));
+			memcpy(x0, _x0, (size_t)nV*sizeof(double));
+		} else {
+			for (int i = 0; i < nV; i++)
+				x0[i] = 0;
 		}
 
-		if (Utilities::isNotNullPtr(_y0)) {
-			// If user passes dual constraints, let us for now assume they have all of the constraint guesses:
-			//    1) box, 2) Linear, 3) Complementarity
-			int dualGuessLength = nV + nC + 2*nComp;
+		memcpy(xk, x0, (size_t)nV*sizeof(double));
 
-			yk = new double[dualGuessLength];
-			for (int i = 0; i < dualGuessLength; i++)
-				yk[i] = _y0[i];
+		// If user passes dual constraints, let us for now assume they have all of the constraint guesses:
+		//    1) box, 2) Linear, 3) Complementarity
+		int dualGuessLength = nV + nC + 2*nComp;
 
-		} else {
-			yk = (double*)0;
+		// The dual iterate must be able to hold the duals of any subsolver
+		if (Utilities::isNullPtr(yk))
+			yk = new double[dualGuessLength]();
+
+		if (Utilities::isNotNullPtr(_y0)) {
+			if (Utilities::isNullPtr(y0))
+				y0 = new double[dualGuessLength];
+
+			memcpy(y0, _y0, (size_t)dualGuessLength*sizeof(double));
+		} else if (Utilities::isNotNullPtr(y0)) {
+			delete[] y0;
+			y0 = NULL;
 		}
 
 		return SUCCESSFUL_RETURN;
@@ -160,6 +210,15 @@ namespace LCQPow {
 
 	inline void LCQProblem::setOptions( const Options& _options )
 	{
+		QPSolver previousQPSolver = options.getQPSolver();
+
 		options = _options;
+
+		// A QP sequence of a different subsolver can not be hotstarted
+		if (options.getQPSolver() != previousQPSolver)
+			qpSequenceInitialized = false;
+
+		// The next solve sets up the subsolver with the new options
+		keepSubsolver = false;
 	}
 }
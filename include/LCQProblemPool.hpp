@@ -0,0 +1,185 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef LCQPOW_LCQPROBLEMPOOL_HPP
+#define LCQPOW_LCQPROBLEMPOOL_HPP
+
+#include "LCQProblem.hpp"
+#include "Options.hpp"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace LCQPow {
+
+    /**
+     *  The shape of an LCQP: its dimensions and a fingerprint of its sparsity patterns.
+     */
+    struct LCQProblemShape {
+        int nV;                                         /**< Number of optimization variables. */
+        int nC;                                         /**< Number of linear constraints. */
+        int nComp;                                      /**< Number of complementarity pairs. */
+        size_t fingerprint;                             /**< Fingerprint of the sparsity patterns (see LCQProblemPool::getFingerprint), 0 for dense problems. */
+    };
+
+
+    /**
+     *  A thread-safe pool of LCQProblem objects for services solving many small LCQPs of a few known shapes.
+     *  Workers acquire an object of the shape of their request, load and solve the problem on it and release it afterwards.
+     *  Released objects are reset (see LCQProblem::reset) and handed out again for the same shape: they keep their workspace,
+     *  problem buffers and subsolver, i.e. loading the next problem of this shape reuses the memory of the LCQProblem and its
+     *  solve only passes the new matrix values to the subsolver (the shape guarantees equal dimensions and sparsity patterns).
+     *  Objects are solved concurrently, hence the dump and step files of the pool's options are numbered per object (see getObjectFile).
+     *  If more objects are idle than allowed (per shape or in total), the least recently released ones are deleted.
+     */
+    class LCQProblemPool {
+
+        public:
+
+            /** Default constructor (default options, at most 64 idle objects and 8 per shape). */
+            LCQProblemPool( );
+
+
+            /** Constructor.
+             *
+             * @param _options The options of all objects created by the pool.
+             * @param _maxIdle The maximum number of idle objects.
+             * @param _maxIdlePerShape The maximum number of idle objects of each shape.
+             */
+            LCQProblemPool( const Options& _options, int _maxIdle = 64, int _maxIdlePerShape = 8 );
+
+
+            /** Destructor. All acquired objects must be released before (this is asserted, remaining ones are not deleted). */
+            ~LCQProblemPool( );
+
+
+            /** Acquire an object of the given shape: the most recently released one of this shape, or a new one.
+             *
+             * @param shape The shape of the problem to be solved.
+             *
+             * @returns The object (owned by the pool), or a `NULL` pointer if the dimensions are invalid.
+             */
+            LCQProblem* acquire( const LCQProblemShape& shape );
+
+
+            /** Release an acquired object (it is reset and kept with its subsolver for the next request of its shape, or deleted if the pool is full).
+             *
+             * @param lcqp The object.
+             *
+             * @returns SUCCESSFUL_RETURN or INVALID_ARGUMENT if the object was not acquired from this pool.
+             */
+            ReturnValue release( LCQProblem* lcqp );
+
+
+            /** Create idle objects of a shape in advance (e.g. on start up of a service), the limits apply.
+             *  This allocates the workspace and problem buffers of the objects, their subsolvers are set up when solving.
+             *
+             * @param shape The shape of the problems to be solved.
+             * @param number The number of objects to be created.
+             *
+             * @returns SUCCESSFUL_RETURN or INVALID_ARGUMENT if the dimensions are invalid.
+             */
+            ReturnValue warmUp( const LCQProblemShape& shape, int number );
+
+
+            /** Delete all idle objects. */
+            void clear( );
+
+
+            /** Get the number of idle objects. */
+            int getNumberOfIdle( ) const;
+
+
+            /** Get the number of idle objects of a shape. */
+            int getNumberOfIdle( const LCQProblemShape& shape ) const;
+
+
+            /** Get the number of objects created by the pool. */
+            int getNumberOfCreated( ) const;
+
+
+            /** Get the number of requests served by an idle object. */
+            int getNumberOfReused( ) const;
+
+
+            /** Computes a fingerprint of the sparsity patterns of a sparse LCQP (equal patterns yield equal fingerprints).
+             *
+             * @param Q The objective's Hessian matrix.
+             * @param L The LHS complementarity matrix.
+             * @param R The RHS complementarity matrix.
+             * @param A The constraint matrix. A `NULL` pointer can be passed if no linear constraints exist.
+             */
+            static size_t getFingerprint( const csc* const Q, const csc* const L, const csc* const R, const csc* const A = 0 );
+
+
+        protected:
+
+            /** Create a new object of the given shape with the pool's options (returns `NULL` if the dimensions are invalid).
+             *  The dump and step files of the options are numbered per object (see getObjectFile). */
+            LCQProblem* create( const LCQProblemShape& shape );
+
+
+            /** Get the next number of an object's files (takes the mutex). */
+            int getObjectId( );
+
+
+            /** Get the file of an object, i.e. the number inserted before the extension (e.g. steps.bin becomes steps.3.bin). */
+            static std::string getObjectFile( const char* const file, int id );
+
+
+            /** Add an object to the idle list and evict the least recently released objects exceeding the limits (the mutex must be held).
+             *
+             * @param shape The shape of the object.
+             * @param lcqp The object.
+             * @param evicted The objects to be deleted by the caller (after the mutex is released).
+             */
+            void addIdle( const LCQProblemShape& shape, LCQProblem* lcqp, std::list<LCQProblem*>& evicted );
+
+
+            /** Whether two shapes are equal. */
+            static bool isSameShape( const LCQProblemShape& a, const LCQProblemShape& b );
+
+
+        private:
+
+            LCQProblemPool( const LCQProblemPool& rhs );                /**< Pools are not copyable. */
+            LCQProblemPool& operator=( const LCQProblemPool& rhs );     /**< Pools are not copyable. */
+
+            Options options;                                            /**< Options of the created objects. */
+            int maxIdle = 64;                                           /**< Maximum number of idle objects. */
+            int maxIdlePerShape = 8;                                    /**< Maximum number of idle objects of each shape. */
+
+            std::list< std::pair<LCQProblemShape, LCQProblem*> > idle;  /**< Idle objects, the most recently released first. */
+            std::map<const LCQProblem*, LCQProblemShape> acquired;      /**< Acquired objects and their shapes. */
+
+            int nCreated = 0;                                           /**< Number of objects created. */
+            int nReused = 0;                                            /**< Number of requests served by an idle object. */
+            int nNumbered = 0;                                          /**< Number of objects with numbered files. */
+
+            mutable std::mutex mutex;                                   /**< Guards the lists and counters. */
+    };
+}
+
+#endif  // LCQPOW_LCQPROBLEMPOOL_HPP
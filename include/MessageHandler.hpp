@@ -27,6 +27,19 @@
 
 namespace LCQPow {
 
+    /** A message sink receives each message as one complete string (e.g. to forward the output to the log of a service).
+     *
+     * @param message The message (including its line breaks).
+     * @param userData The pointer passed to MessageHandler::SetMessageSink.
+     */
+    typedef void (*MessageSink)( const char* message, void* userData );
+
+
+    /**
+     *  All output of the solver passes through the message handler. Each message is formatted completely and then written
+     *  with a single call, i.e. messages of solver objects running on different threads do not interleave. The sink is a
+     *  property of the calling thread (no global state is shared between threads).
+     */
     class MessageHandler {
 
         public:
@@ -46,6 +59,26 @@ namespace LCQPow {
              * @returns Simply passes the algorithm status that was given. */
             static AlgorithmStatus PrintSolution( AlgorithmStatus algoStat );
 
+
+            /** Print a formatted message (printf syntax) to the sink of the calling thread. */
+            static void Print( const char* format, ... );
+
+
+            /** Set the sink of the calling thread. LCQBatchSolver passes the sink on to its workers, i.e. the sink must then be thread-safe.
+             *
+             * @param sink The sink. A `NULL` pointer restores the default sink (stdout).
+             * @param userData A pointer passed to each call of the sink.
+             */
+            static void SetMessageSink( MessageSink sink, void* userData = 0 );
+
+
+            /** Get the sink of the calling thread (e.g. to pass it on to worker threads).
+             *
+             * @param sink Pointer to store the sink (`NULL` for the default sink).
+             * @param userData Pointer to store the user data of the sink.
+             */
+            static void GetMessageSink( MessageSink* sink, void** userData );
+
     };
 }
 
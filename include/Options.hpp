@@ -25,6 +25,8 @@
 
 #include "Utilities.hpp"
 
+#include <string>
+
 namespace LCQPow {
 
     class Options {
@@ -105,6 +107,14 @@ namespace LCQPow {
             ReturnValue setPerturbStep( bool val );
 
 
+            /** Get the seed of the step perturbation. */
+            unsigned int getRandomSeed( );
+
+
+            /** Set the seed of the step perturbation (equal seeds yield equal iterates, independent of other solver objects). */
+            ReturnValue setRandomSeed( unsigned int val );
+
+
             /** Get maximum number of iterations. */
             int getMaxIterations( );
 
@@ -157,6 +167,47 @@ namespace LCQPow {
             ReturnValue setStoreSteps( bool val );
 
 
+            /** Get the file the primal iterates are streamed to if steps are stored (`NULL` if they are kept in memory). */
+            const char* getStepFile( );
+
+
+            /** Set the file the primal iterates are streamed to if steps are stored (see setStoreSteps and TrajectoryWriter,
+             *  binary if the name ends with .bin). The iterates are then not kept in the output statistics. `NULL` or an empty
+             *  name keeps them in memory. */
+            ReturnValue setStepFile( const char* val );
+
+
+            /** Get how the primal iterates are stored if steps are stored. */
+            StepStorage getStepStorage( );
+
+
+            /** Set how the primal iterates are stored if steps are stored: all of them, the latest ones in a ring buffer
+             *  or every k-th one (see StepStorage and setStepStorageSize). */
+            ReturnValue setStepStorage( StepStorage val );
+
+
+            /** Set how the primal iterates are stored (using an integer). */
+            ReturnValue setStepStorage( int val );
+
+
+            /** Get the size of the ring buffer or the sampling interval of the stored iterates. */
+            int getStepStorageSize( );
+
+
+            /** Set the size of the ring buffer (STORE_LAST_STEPS) or the sampling interval (STORE_SAMPLED_STEPS) of the stored iterates. */
+            ReturnValue setStepStorageSize( int val );
+
+
+            /** Get the file the problem is dumped to on each call of runSolver (`NULL` if disabled). */
+            const char* getDumpFile( );
+
+
+            /** Set the file the problem is dumped to on each call of runSolver, i.e. a container with the problem data, initial
+             *  guess and options as passed to the solver (see LCQPContainer and examples/replay_lcqp). `NULL` or an empty
+             *  name disables the dump. */
+            ReturnValue setDumpFile( const char* val );
+
+
             /** Get QP solver. */
             QPSolver getQPSolver( );
 
@@ -197,6 +248,7 @@ namespace LCQPow {
             bool solveZeroPenaltyFirst;                 /**< Flag indicating whether first QP should ignore penalization. */
 
             bool perturbStep;                           /**< Flag whether to perform step perturbation. */
+            unsigned int randomSeed;                    /**< Seed of the step perturbation. */
 
             int maxIterations;                          /**< Maximum number of iterations to be performed. */
             double maxPenaltyParameter;                 /**< Maximum penalty value. */
@@ -208,6 +260,13 @@ namespace LCQPow {
 
             bool storeSteps;                            /**< Whether to store detailed information for each iterate (time consuming). */
 
+            std::string stepFile;                       /**< File the primal iterates are streamed to if steps are stored (empty if kept in memory). */
+
+            StepStorage stepStorage;                    /**< How the primal iterates are stored. */
+            int stepStorageSize;                        /**< Size of the ring buffer or sampling interval of the stored iterates. */
+
+            std::string dumpFile;                       /**< File the problem is dumped to on each call of runSolver (empty if disabled). */
+
             QPSolver qpSolver;                          /**< The QP solver to be used. */
 			qpOASES::Options qpOASES_opts;			    /**< qpOASES options. */
 			OSQPSettings *OSQP_opts = NULL;			    /**< OSQP options. */	
@@ -46,6 +46,11 @@ namespace LCQPow {
             void reset( );
 
 
+            /** Set the number of primal iterates kept (0 keeps all of them, otherwise the latest ones are kept in a ring buffer).
+             *  Clears the stored iterates. */
+            void setStepCapacity( int capacity );
+
+
             /** Update total iteration counter.
              *
              * @return Success or specifies the invalid argument.
@@ -88,7 +93,24 @@ namespace LCQPow {
             ReturnValue updateQPSolverExitFlag( int _flag );
 
 
-            /** Update tracking vectors.
+            /** Add time to a solver phase.
+             *
+             * @param phase The phase.
+             * @param seconds The wall-clock time spent in the phase.
+             *
+             * @return Success or specifies the invalid argument.
+             */
+            ReturnValue updatePhaseTime( SolverPhase phase, double seconds );
+
+
+            /** Add time to the total wall-clock time.
+             *
+             * @return Success or specifies the invalid argument.
+             */
+            ReturnValue updateTimeTotal( double seconds );
+
+
+            /** Update tracking vectors (xStep may be a `NULL` pointer if the iterates are not kept, see Options::setStepFile).
              *
              * @return Success or specifies the invalid argument.
              */
@@ -106,6 +128,25 @@ namespace LCQPow {
             );
 
 
+            /** Update the tracking vectors of the QP subproblems (one entry per inner iteration, next to subproblemIters).
+             *
+             * @param solveTime Wall-clock time of the QP solve (seconds).
+             * @param rhoUpdates Number of rho updates (OSQP).
+             * @param factorizations Number of matrix factorizations computed from scratch.
+             * @param primalResidual Maximum constraint violation of the QP solution.
+             * @param dualResidual Maximum violation of the QP's stationarity condition.
+             *
+             * @return Success.
+             */
+            ReturnValue updateSubproblemTrackingVectors(
+                double solveTime,
+                int rhoUpdates,
+                int factorizations,
+                double primalResidual,
+                double dualResidual
+            );
+
+
             /** Get the total number of iterations. */
             int getIterTotal( ) const;
 
@@ -130,6 +171,14 @@ namespace LCQPow {
             int getQPSolverExitFlag( ) const;
 
 
+            /** Get the wall-clock time (in seconds) spent in a phase of the solve. */
+            double getPhaseTime( SolverPhase phase ) const;
+
+
+            /** Get the wall-clock time (in seconds) of the solve (the sum of all phases). */
+            double getTimeTotal( ) const;
+
+
             /** Get values of inner loop iterates.*/
             int* getInnerIters( ) const;
 
@@ -202,9 +251,58 @@ namespace LCQPow {
             std::vector<double> getMeritValsStdVec( ) const;
 
 
-            /** Get primal iterates. */
+            /** Get the number of iterations tracked (the length of the tracking vectors). */
+            int getNumberOfTrackedSteps( ) const;
+
+
+            /** Get the number of stored primal iterates (0 if they were streamed to a file, see Options::setStepFile and Options::setStepStorage). */
+            int getNumberOfxSteps( ) const;
+
+
+            /** Get the number of entries of each stored primal iterate. */
+            int getxStepLength( ) const;
+
+
+            /** Get a stored primal iterate without copying it (valid until the next update or reset).
+             *
+             * @param k The index of the iterate, 0 being the oldest one stored.
+             *
+             * @returns A pointer to the nV entries of the iterate or a `NULL` pointer if k is out of range.
+             */
+            const double* getxStep( int k ) const;
+
+
+            /** Get the iteration (index into the other tracking vectors) of a stored primal iterate, -1 if k is out of range. */
+            int getxStepIter( int k ) const;
+
+
+            /** Get the iterations of the stored primal iterates. */
+            std::vector<int> getxStepItersStdVec( ) const;
+
+
+            /** Get the stored primal iterates, the oldest one first (copied, see getxStep). */
             std::vector<std::vector<double>> getxStepsStdVec ( ) const;
 
+
+            /** Get the wall-clock times of the QP subproblems. */
+            std::vector<double> getSubproblemTimesStdVec( ) const;
+
+
+            /** Get the numbers of rho updates of the QP subproblems (OSQP). */
+            std::vector<int> getSubproblemRhoUpdatesStdVec( ) const;
+
+
+            /** Get the numbers of factorizations of the QP subproblems. */
+            std::vector<int> getSubproblemFactorizationsStdVec( ) const;
+
+
+            /** Get the primal residuals of the QP subproblems. */
+            std::vector<double> getSubproblemPrimalResidualsStdVec( ) const;
+
+
+            /** Get the dual residuals of the QP subproblems. */
+            std::vector<double> getSubproblemDualResidualsStdVec( ) const;
+
         private:
             int iterTotal = 0;                                  /**< Total number of iterations, i.e., total number of inner iterations. */
             int iterOuter = 0;                                  /**< Total number of outer iterations, i.e., number of penalty updates. */
@@ -212,18 +310,29 @@ namespace LCQPow {
             double rhoOpt = 0.0;                                /**< Value of penalty parameter at the final iterate. */
             AlgorithmStatus status = PROBLEM_NOT_SOLVED;        /**< Status of the solver. This is set to the solution type on success. */
             int qpSolver_exit_flag = 0;                         /**< The exit flag of the most recent QP solved (refer to the respective QP solver docs for meanings). */
+            double phaseTimes[NUMBER_OF_PHASES] = { 0 };       /**< Wall-clock time spent in each phase (seconds). */
+            double timeTotal = 0.0;                             /**< Wall-clock time of the solve (seconds). */
 
             // Tracking vectors
             std::vector<int>    innerIters;                     /**< Number of inner iterations (accumulated per inner loop). */
             std::vector<int>    subproblemIters;                /**< Number of subsolver iterations for each inner loop. */
             std::vector<int>    accuSubproblemIters;            /**< Accumulated number of subsolver iterations. */
-            std::vector<std::vector<double>> xSteps;            /**< Primal iterates. */
+            std::vector<double> xSteps;                         /**< Stored primal iterates (nV entries each, a ring buffer if the capacity is bounded). */
+            std::vector<int>    xStepIters;                     /**< Iterations of the stored primal iterates (same slots as xSteps). */
+            int xStepLength = 0;                                /**< Number of entries of each stored primal iterate. */
+            int xStepCapacity = 0;                              /**< Maximum number of stored primal iterates (0 if unbounded). */
+            int xStepFirst = 0;                                 /**< Slot of the oldest stored primal iterate. */
             std::vector<double> stepLength;                     /**< Track values of alpha. */
             std::vector<double> stepSize;                       /**< Track norm of pk. */
             std::vector<double> statVals;                       /**< Track values of Lagrangian's gradient violation. */
             std::vector<double> objVals;                        /**< Track objective function values. */
             std::vector<double> phiVals;                        /**< Track values of complementarity penalty function. */
             std::vector<double> meritVals;                      /**< Track merit function values. */
+            std::vector<double> subproblemTimes;                /**< Track wall-clock times of the QP subproblems. */
+            std::vector<int>    subproblemRhoUpdates;           /**< Track rho updates of the QP subproblems (OSQP). */
+            std::vector<int>    subproblemFactorizations;       /**< Track factorizations of the QP subproblems. */
+            std::vector<double> subproblemPrimalResiduals;      /**< Track primal residuals of the QP subproblems. */
+            std::vector<double> subproblemDualResiduals;        /**< Track dual residuals of the QP subproblems. */
     };
 }
 
@@ -45,12 +45,12 @@ namespace LCQPow {
              * @param nV The number of optimization variables.
              * @param nC The number of linear constraints (should include the complementarity pairs).
              * @param Q The Hessian matrix in dense format.
-             * @param A The linear constraint matrix (should include the rows of the complementarity selector matrices).
+             * @param A The linear constraint matrix (should include the rows of the complementarity selector matrices). It is not copied and must outlive the subsolver.
             */
             Subsolver(  int nV,
                         int nC,
-                        double* Q,
-                        double* A );
+                        const double* const Q,
+                        const double* const A );
 
 
             /** Constructor for sparse matrices (qpOASES/OSQP).
@@ -58,13 +58,13 @@ namespace LCQPow {
              * @param nV The number of optimization variables.
              * @param nC The number of linear constraints (should include the complementarity pairs).
              * @param Q The Hessian matrix in sparse csc format.
-             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices).
+             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices). OSQP does not copy it, i.e. it must outlive the subsolver.
              * @param qpSolver The QP subproblem solver to be used.
             */
             Subsolver(  int nV,
                         int nC,
-                        csc* Q,
-                        csc* A,
+                        const csc* const Q,
+                        const csc* const A,
                         QPSolver qpSolver);
 
 
@@ -72,10 +72,81 @@ namespace LCQPow {
             Subsolver(const Subsolver& rhs);
 
 
+            /** Move constructor (takes over the data and the QP sequence of rhs). */
+            Subsolver(Subsolver&& rhs);
+
+
             /** Assignment operator (deep copy). */
             virtual Subsolver& operator=(const Subsolver& rhs);
 
 
+            /** Move assignment operator (takes over the data and the QP sequence of rhs). */
+            virtual Subsolver& operator=(Subsolver&& rhs);
+
+
+            /** Set up the subsolver in place for dense matrices (qpOASES).
+             *
+             * @param nV The number of optimization variables.
+             * @param nC The number of linear constraints (should include the complementarity pairs).
+             * @param Q The Hessian matrix in dense format.
+             * @param A The linear constraint matrix (should include the rows of the complementarity selector matrices). It is not copied and must outlive the subsolver.
+            */
+            void setUp( int nV, int nC, const double* const Q, const double* const A );
+
+
+            /** Set up the subsolver in place for sparse matrices (qpOASES/OSQP).
+             *
+             * @param nV The number of optimization variables.
+             * @param nC The number of linear constraints (should include the complementarity pairs).
+             * @param Q The Hessian matrix in sparse csc format.
+             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices). OSQP does not copy it, i.e. it must outlive the subsolver.
+             * @param qpSolver The QP subproblem solver to be used.
+             *
+             * @returns SUCCESSFUL_RETURN or INVALID_QPSOLVER if qpSolver is not a sparse solver.
+            */
+            ReturnValue setUp( int nV, int nC, const csc* const Q, const csc* const A, QPSolver qpSolver );
+
+
+            /** Pass the values of new dense matrices of the same dimensions to the current set up (qpOASES), keeping its memory.
+             *  The next initial solve starts a new QP sequence with the new values.
+             *
+             * @param nV The number of optimization variables.
+             * @param nC The number of linear constraints (should include the complementarity pairs).
+             * @param Q The Hessian matrix in dense format.
+             * @param A The linear constraint matrix (should include the rows of the complementarity selector matrices). It is not copied and must outlive the subsolver.
+             *
+             * @returns Whether the values were passed. Otherwise (e.g. no dense set up of these dimensions exists) setUp must be called.
+            */
+            bool updateMatrices( int nV, int nC, const double* const Q, const double* const A );
+
+
+            /** Pass the values of new sparse matrices of the same sparsity patterns to the current set up (qpOASES/OSQP), keeping its memory (e.g. the OSQP workspace).
+             *  The next initial solve starts a new QP sequence with the new values.
+             *
+             * @param nV The number of optimization variables.
+             * @param nC The number of linear constraints (should include the complementarity pairs).
+             * @param Q The Hessian matrix in sparse csc format.
+             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices). OSQP does not copy it, i.e. it must outlive the subsolver.
+             * @param qpSolver The QP subproblem solver to be used.
+             *
+             * @returns Whether the values were passed. Otherwise (e.g. the solver or a sparsity pattern differs) setUp must be called.
+            */
+            bool updateMatrices( int nV, int nC, const csc* const Q, const csc* const A, QPSolver qpSolver );
+
+
+            /** Get the number of OSQP workspace setups (zero when using qpOASES). */
+            int getNumberOfSetups( ) const;
+
+
+            /** Get the statistics of the most recent solve.
+             *
+             * @param rhoUpdates Number of step size (rho) updates (OSQP, zero for qpOASES).
+             * @param factorizations Number of matrix factorizations computed from scratch (qpOASES factorizes on initialization
+             *                       and updates the factorization on hotstarts, OSQP factorizes on setup and on each rho update).
+             */
+            void getSolveStatistics( int& rhoUpdates, int& factorizations ) const;
+
+
             /** Write solution to x and y. */
             void getSolution( double* x, double* y );
 
@@ -102,9 +173,13 @@ namespace LCQPow {
             void copy(const Subsolver& rhs);
 
 
+            /** Moves all members from given rhs object. */
+            void move(Subsolver& rhs);
+
+
         private:
             // The solver type
-            QPSolver qpSolver;                      /**< Inidicating which qpSolver to use. */
+            QPSolver qpSolver = QPSolver::QPOASES_DENSE;    /**< Inidicating which qpSolver to use. */
 
             // The different solvers
         	SubsolverQPOASES solverQPOASES;         /**< When using qpOASES. */
@@ -41,7 +41,7 @@ namespace LCQPow {
             /** Constructor for sparse matrices.
              *
              * @param Q The Hessian matrix in sparse csc format.
-             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices).
+             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices). It is not copied and must outlive the subsolver.
             */
             SubsolverOSQP(  const csc* const _Q,
                             const csc* const _A
@@ -52,6 +52,10 @@ namespace LCQPow {
             SubsolverOSQP(const SubsolverOSQP& rhs);
 
 
+            /** Move constructor (takes over the workspace of rhs without a new setup). */
+            SubsolverOSQP(SubsolverOSQP&& rhs);
+
+
             /** Destructor. */
             ~SubsolverOSQP( );
 
@@ -64,6 +68,38 @@ namespace LCQPow {
             virtual SubsolverOSQP& operator=(const SubsolverOSQP& rhs);
 
 
+            /** Move assignment operator (takes over the workspace of rhs without a new setup). */
+            virtual SubsolverOSQP& operator=(SubsolverOSQP&& rhs);
+
+
+            /** Set up the subsolver in place (any previous data and workspace is cleared).
+             *
+             * @param Q The Hessian matrix in sparse csc format.
+             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices). It is not copied and must outlive the subsolver.
+            */
+            void setUp( const csc* const _Q, const csc* const _A );
+
+
+            /** Pass the values of new matrices of the same sparsity patterns to the current workspace (it is not set up again).
+             *  The next initial solve passes them to OSQP (a numeric factorization only) and starts a new QP sequence from the initial guess.
+             *  The workspace keeps the settings it was set up with.
+             *
+             * @param Q The Hessian matrix in sparse csc format.
+             * @param A The linear constraint matrix in sparse csc format. It is not copied and must outlive the subsolver.
+             *
+             * @returns Whether the values were passed. Otherwise (no workspace of these patterns exists) setUp must be called.
+            */
+            bool updateMatrices( const csc* const _Q, const csc* const _A );
+
+
+            /** Get the number of OSQP workspace setups (i.e. KKT factorizations) performed by this object. */
+            int getNumberOfSetups( ) const;
+
+
+            /** Get the number of rho updates and KKT factorizations (setup and rho updates) of the most recent solve. */
+            void getSolveStatistics( int& rhoUpdates, int& factorizations ) const;
+
+
             /** Set OSQP settings. */
             void setOptions( OSQPSettings* settings );
 
@@ -101,17 +137,29 @@ namespace LCQPow {
             void copy(const SubsolverOSQP& rhs);
 
 
+            /** Moves all members from given rhs object (rhs is left empty). */
+            void move(SubsolverOSQP& rhs);
+
+
+            /** Clean up the OSQP workspace and data (matrices and settings are kept). */
+            void clearWorkspace();
+
+
         private:
 
-            int nV;                                 /**< Number of optimization variables. */
-            int nC;                                 /**< Number of constraints. */
+            int nV = 0;                             /**< Number of optimization variables. */
+            int nC = 0;                             /**< Number of constraints. */
+            int numberOfSetups = 0;                 /**< Number of calls of osqp_setup. */
+            int lastRhoUpdates = 0;                 /**< Number of rho updates of the most recent solve. */
+            int lastFactorizations = 0;             /**< Number of KKT factorizations of the most recent solve. */
+            bool matricesUpdated = false;           /**< Whether the next initial solve passes updated matrices to the workspace instead of setting it up (see updateMatrices). */
 
             OSQPWorkspace *work = NULL;             /**< OSQP workspace. */
             OSQPSettings *settings = NULL;          /**< OSQP settings. */
             OSQPData *data = NULL;                  /**< OSQP data. */
 
             csc* Q = NULL;                          /**< Hessian matrix in csc format (must be upper triagonal). */
-            csc* A = NULL;                          /**< Constraint matrix in csc format (should contain rows of compl. sel. matrices). */
+            const csc* A = NULL;                    /**< Constraint matrix in csc format (borrowed, should contain rows of compl. sel. matrices). */
     };
 }
 
@@ -39,12 +39,12 @@ namespace LCQPow {
              * @param nV Number of optimization variables.
              * @param nC Number of linear constraints (should include complementarity pairs).
              * @param Q The Hessian matrix in dense format.
-             * @param A The linear constraint matrix in dense format (should include the rows of the complementarity selector matrices).
+             * @param A The linear constraint matrix in dense format (should include the rows of the complementarity selector matrices). It is not copied and must outlive the subsolver.
             */
             SubsolverQPOASES(   int nV,
                                 int nC,
-                                double* Q,
-                                double* A);
+                                const double* const Q,
+                                const double* const A);
 
 
             /** Constructor for sparse matrices.
@@ -56,14 +56,18 @@ namespace LCQPow {
             */
             SubsolverQPOASES(   int nV,
                                 int nC,
-                                csc* Q,
-                                csc* A);
+                                const csc* const Q,
+                                const csc* const A);
 
 
             /** Copy constructor. */
             SubsolverQPOASES(const SubsolverQPOASES& rhs);
 
 
+            /** Move constructor (takes over the data and the QP sequence of rhs). */
+            SubsolverQPOASES(SubsolverQPOASES&& rhs);
+
+
             /** Destructor. */
             ~SubsolverQPOASES();
 
@@ -72,6 +76,56 @@ namespace LCQPow {
             virtual SubsolverQPOASES& operator=(const SubsolverQPOASES& rhs);
 
 
+            /** Move assignment operator (takes over the data and the QP sequence of rhs). */
+            virtual SubsolverQPOASES& operator=(SubsolverQPOASES&& rhs);
+
+
+            /** Set up the subsolver in place for dense matrices (any previous data is cleared).
+             *
+             * @param nV Number of optimization variables.
+             * @param nC Number of linear constraints (should include complementarity pairs).
+             * @param Q The Hessian matrix in dense format.
+             * @param A The linear constraint matrix in dense format (should include the rows of the complementarity selector matrices). It is not copied and must outlive the subsolver.
+            */
+            void setUp( int nV, int nC, const double* const Q, const double* const A );
+
+
+            /** Set up the subsolver in place for sparse matrices (any previous data is cleared).
+             *
+             * @param nV Number of optimization variables.
+             * @param nC Number of linear constraints (should include complementarity pairs).
+             * @param Q The Hessian matrix in sparse csc format.
+             * @param A The linear constraint matrix in sparse csc format (should include the rows of the complementarity selector matrices).
+            */
+            void setUp( int nV, int nC, const csc* const Q, const csc* const A );
+
+
+            /** Pass the values of new dense matrices of the same dimensions to the current set up (the QP object and its memory are kept).
+             *  The next initial solve starts a new QP sequence with the new values.
+             *
+             * @param nV Number of optimization variables.
+             * @param nC Number of linear constraints (should include complementarity pairs).
+             * @param Q The Hessian matrix in dense format.
+             * @param A The linear constraint matrix in dense format. It is not copied and must outlive the subsolver.
+             *
+             * @returns Whether the values were passed. Otherwise (no dense set up of these dimensions exists) setUp must be called.
+            */
+            bool updateMatrices( int nV, int nC, const double* const Q, const double* const A );
+
+
+            /** Pass the values of new sparse matrices of the same sparsity patterns to the current set up (the QP object and its memory are kept).
+             *  The next initial solve starts a new QP sequence with the new values.
+             *
+             * @param nV Number of optimization variables.
+             * @param nC Number of linear constraints (should include complementarity pairs).
+             * @param Q The Hessian matrix in sparse csc format.
+             * @param A The linear constraint matrix in sparse csc format.
+             *
+             * @returns Whether the values were passed. Otherwise (no sparse set up of these patterns exists) setUp must be called.
+            */
+            bool updateMatrices( int nV, int nC, const csc* const Q, const csc* const A );
+
+
             /** Setting the user options. */
             void setOptions( qpOASES::Options options );
 
@@ -106,25 +160,34 @@ namespace LCQPow {
             void getSolution( double* x, double* y );
 
 
+            /** Get the statistics of the most recent solve (no rho updates, one factorization on initialization). */
+            void getSolveStatistics( int& rhoUpdates, int& factorizations ) const;
+
+
         protected:
 
             /** Copies all members from given rhs object. */
             void copy(const SubsolverQPOASES& rhs);
 
 
+            /** Moves all members from given rhs object (rhs is left empty). */
+            void move(SubsolverQPOASES& rhs);
+
+
             /** Clear the memory. */
             void clear( );
 
         private:
 
-            int nV;                                     /**< Number of optimization variables. */
-            int nC;                                     /**< Total number of dual variables. */
+            int nV = 0;                                 /**< Number of optimization variables. */
+            int nC = 0;                                 /**< Total number of dual variables. */
 
             bool isSparse = false;                      /**< A flag storing whether data is given in sparse or dense format. */
             bool useSchur = false;                      /**< A flag indicating whether to use the Shur Complement method. */
+            bool lastSolveInitial = false;              /**< Whether the most recent solve initialized the QP sequence. */
 
-            double* Q = NULL;                           /**< Hessian matrix in dense format. */
-            double* A = NULL;                           /**< Constraint matrix in dense format (should contain rows of compl. sel. matrices). */
+            double* Q = NULL;                           /**< Hessian matrix in dense format (a copy, qpOASES may regularise it in place). */
+            const double* A = NULL;                     /**< Constraint matrix in dense format (borrowed, should contain rows of compl. sel. matrices). */
 
             qpOASES::SymSparseMat* Q_sparse = NULL;     /**< Hessian matrix as qpOASES symmetric sparse matrix. */
             qpOASES::SparseMatrix* A_sparse = NULL;     /**< Constraint matrix as qpOASES sparse matrix (should contain rows of compl. sel. matrices). */
@@ -137,8 +200,8 @@ namespace LCQPow {
             int* A_i = NULL;                            /**< Constraint matrix sparse rows (required because one cannot copy a symmetric(sprase) qpOASES matrix). */
             int* A_p = NULL;                            /**< Constraint matrix sparse col pointers (required because one cannot copy a symmetric(sprase) qpOASES matrix). */
 
-            qpOASES::QProblem qp;                       /**< Store a QP class and call it sequentially (using its hotstart functionality). */
-            qpOASES::SQProblemSchur qpSchur;            /**< Store a Schur Complement QP class and call it sequentially (using its hotstart functionality). */
+            qpOASES::QProblem* qp = NULL;               /**< Store a QP class and call it sequentially (using its hotstart functionality). */
+            qpOASES::SQProblemSchur* qpSchur = NULL;    /**< Store a Schur Complement QP class and call it sequentially (using its hotstart functionality). */
 
     };
 }
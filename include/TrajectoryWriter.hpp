@@ -0,0 +1,123 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#ifndef LCQPOW_TRAJECTORYWRITER_HPP
+#define LCQPOW_TRAJECTORYWRITER_HPP
+
+#include "Utilities.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace LCQPow {
+
+    /**
+     *  A buffered writer of vectors (e.g. solutions or iterates streamed during a solve). Each call of write appends
+     *  one record: in text files a line of numbers printed with 17 significant digits, in binary files the raw doubles
+     *  (native byte order). Both are lossless and can be read by Utilities::readFromFile as one vector of all records.
+     */
+    class TrajectoryWriter {
+
+        public:
+
+            /** Default constructor. */
+            TrajectoryWriter( );
+
+
+            /** Destructor (closes the file). */
+            ~TrajectoryWriter( );
+
+
+            /** Create (or truncate) a file, binary if the file name ends with .bin and text otherwise.
+             *
+             * @param filename The file.
+             *
+             * @returns SUCCESSFUL_RETURN or UNABLE_TO_WRITE_FILE.
+             */
+            ReturnValue open( const char* filename );
+
+
+            /** Create (or truncate) a file in the given format.
+             *
+             * @param filename The file.
+             * @param format TEXT_FILE or BINARY_FILE.
+             *
+             * @returns SUCCESSFUL_RETURN, INVALID_ARGUMENT for other formats or UNABLE_TO_WRITE_FILE.
+             */
+            ReturnValue open( const char* filename, FileFormat format );
+
+
+            /** Append a record.
+             *
+             * @param data The values.
+             * @param n The number of values.
+             *
+             * @returns SUCCESSFUL_RETURN, LCQPOBJECT_NOT_SETUP if no file is open or UNABLE_TO_WRITE_FILE.
+             */
+            ReturnValue write( const double* const data, int n );
+
+
+            /** Write the buffered records to the file.
+             *
+             * @returns SUCCESSFUL_RETURN or UNABLE_TO_WRITE_FILE (also if a previous write failed).
+             */
+            ReturnValue flush( );
+
+
+            /** Flush and close the file (nothing happens if no file is open).
+             *
+             * @returns SUCCESSFUL_RETURN or UNABLE_TO_WRITE_FILE (also if a previous write failed).
+             */
+            ReturnValue close( );
+
+
+            /** Whether a file is open. */
+            bool isOpen( ) const;
+
+
+            /** Get the number of records written since the file was opened. */
+            int getNumberOfRecords( ) const;
+
+
+        protected:
+
+            /** Make room for the given number of bytes in the buffer (flushes if required). */
+            void reserve( size_t bytes );
+
+
+        private:
+
+            TrajectoryWriter( const TrajectoryWriter& rhs );            /**< Writers are not copyable. */
+            TrajectoryWriter& operator=( const TrajectoryWriter& rhs ); /**< Writers are not copyable. */
+
+            FILE* file = NULL;                                          /**< The open file. */
+            FileFormat format = TEXT_FILE;                              /**< Format of the file. */
+            bool failed = false;                                        /**< Whether writing to the file failed. */
+            int nRecords = 0;                                           /**< Number of records written. */
+
+            std::vector<char> buffer;                                   /**< Output buffer. */
+            size_t used = 0;                                            /**< Number of bytes in the buffer. */
+    };
+}
+
+#endif  // LCQPOW_TRAJECTORYWRITER_HPP
@@ -74,11 +74,14 @@ namespace LCQPow {
         OSQP_WORKSPACE_NOT_SET_UP = 207,                /**< OSQP Workspace is not set up. */
         OSQP_INITIAL_PRIMAL_GUESS_FAILED = 208,         /**< OSQP failed to use the primal initial guess. */
         OSQP_INITIAL_DUAL_GUESS_FAILED = 209,           /**< OSQP failed to use the dual initial guess. */
+        SOLVER_ABORTED_BY_CALLBACK = 210,               /**< The iteration callback requested to abort the solve. */
 
         // Generic errors
         LCQPOBJECT_NOT_SETUP = 300,                     /**< Constructor has not been called. */
         INDEX_OUT_OF_BOUNDS = 301,                      /**< Index out of bounds. */
         UNABLE_TO_READ_FILE = 302,                      /**< Unable to read a file. */
+        CALLBACKS_DISABLED = 303,                       /**< The library was built without iteration callbacks (LCQPOW_NO_CALLBACKS). */
+        UNABLE_TO_WRITE_FILE = 304,                     /**< Unable to write a file. */
 
         // Sparse matrices
         INVALID_INDEX_POINTER = 400,                    /**< Invalid index pointer for a csc matrix. */
@@ -129,6 +132,51 @@ namespace LCQPow {
     };
 
 
+    /**
+     *  Storage of the primal iterates if steps are stored (see Options::setStepStorage).
+     */
+    enum StepStorage {
+        STORE_ALL_STEPS = 0,                            /**< Keep every iterate. */
+        STORE_LAST_STEPS = 1,                           /**< Keep the latest iterates in a ring buffer of Options::getStepStorageSize entries. */
+        STORE_SAMPLED_STEPS = 2                         /**< Keep every k-th iterate, k = Options::getStepStorageSize (also applies to the step file). */
+    };
+
+
+    /**
+     *  Phases of a solve (see OutputStatistics::getPhaseTime).
+     */
+    enum SolverPhase {
+        PHASE_SETUP = 0,                                /**< Loading, construction of C and Qk, initialization of the subsolver. */
+        PHASE_QP_SOLVE = 1,                             /**< QP subproblems. */
+        PHASE_LINEARIZATION = 2,                        /**< Linearization of the penalty function and penalty updates. */
+        PHASE_STATIONARITY = 3,                         /**< Evaluation of the stationarity violation. */
+        PHASE_STEP_LENGTH = 4,                          /**< Step length computation, step perturbation and update. */
+        PHASE_TERMINATION = 5,                          /**< Termination and Leyffer checks, LCQP duals and stationarity type. */
+        PHASE_BOOKKEEPING = 6,                          /**< Printing, storing steps and iteration counters. */
+        NUMBER_OF_PHASES = 7                            /**< Number of phases. */
+    };
+
+
+    /**
+     *  Data file formats (see Utilities::getFileFormat).
+     */
+    enum FileFormat {
+        TEXT_FILE = 0,                                  /**< Whitespace separated numbers (dense matrices row by row). */
+        BINARY_FILE = 1,                                /**< Raw numbers in native byte order (file extension .bin). */
+        MATRIX_MARKET_FILE = 2                          /**< Matrix Market coordinate or array file (file extension .mtx). */
+    };
+
+
+    /**
+     *  Events of the iteration callback (see LCQProblem::setIterationCallback).
+     */
+    enum CallbackEvent {
+        EVENT_ITERATION = 0,                            /**< An inner iteration was completed (after the step and stationarity update). */
+        EVENT_PENALTY_UPDATE = 1,                       /**< The penalty parameter was increased. */
+        EVENT_TERMINATION = 2                           /**< The solve terminated (successfully or not). */
+    };
+
+
     /**
      *  The utilities class
      */
@@ -164,12 +212,24 @@ namespace LCQPow {
             static void MatrixSymmetrizationProduct(const double* const A, const double* const B, double* C, int m, int n);
 
 
-            /** C = A'*B + B'*A **/
+            /** C = A'*B + B'*A (A and B have n columns, the number of rows is taken from their row indices) **/
             static csc* MatrixSymmetrizationProduct(double* L_x, int* L_i, int* L_p, double* R_x, int* R_i, int* R_p, int n);
 
 
+            /** C = A'*B + B'*A (A and B are m x n, the sparse product costs O(nnz) instead of O(n^2)) **/
+            static csc* MatrixSymmetrizationProduct(double* L_x, int* L_i, int* L_p, double* R_x, int* R_i, int* R_p, int m, int n);
+
+
             /** C = A'*B + B'*A **/
-            static csc* MatrixSymmetrizationProduct(csc* L, csc* R);
+            static csc* MatrixSymmetrizationProduct(const csc* const L, const csc* const R);
+
+
+            /** C = L'*R + R'*L for selector matrices L and R (m x n, row k has a single unit entry in column l[k] resp. r[k]) **/
+            static void SelectorSymmetrizationProduct(const int* const l, const int* const r, double* C, int m, int n);
+
+
+            /** C = L'*R + R'*L for selector matrices L and R (sparse result, costs O(m log m) instead of a general product) **/
+            static csc* SelectorSymmetrizationProduct(const int* const l, const int* const r, int m, int n);
 
 
             /** d = A*b + c **/
@@ -188,8 +248,8 @@ namespace LCQPow {
             static void WeightedVectorAdd(const double alpha, const double* const a, const double beta, const double* const b, double* c, int m);
 
 
-            /** @returns p' * Q * p **/
-            static double QuadraticFormProduct(const double* const Q, const double* const p, int m);
+            /** @returns p' * Q * p (Q is symmetric, Qp is an optional buffer of m doubles, see DenseKernels::QuadraticFormProduct) **/
+            static double QuadraticFormProduct(const double* const Q, const double* const p, int m, double* Qp = 0);
 
 
             /** @return p' * Q * p **/
@@ -204,6 +264,11 @@ namespace LCQPow {
             static double MaxAbs(const double* const a, int m);
 
 
+            /** Adds r_i*scale to a_i with r_i in {-1, 0, 1} drawn from a counter-based generator (SplitMix64): r_i only depends
+             *  on seed and counter + i, i.e. neither on previous calls nor on the thread. **/
+            static void AddRandomPerturbation(double* a, int m, unsigned long long seed, unsigned long long counter, double scale);
+
+
             /** Clear sparse matrix **/
             static void ClearSparseMat(csc* M);
 
@@ -212,16 +277,24 @@ namespace LCQPow {
             static void ClearSparseMat(csc** M);
 
 
-            /** Read integral data from file **/
+            /** Get the format of a data file from its extension (.bin, .mtx, anything else is text) **/
+            static FileFormat getFileFormat(const char* datafilename);
+
+
+            /** Read integral data from a text or binary file (exactly n numbers are expected) **/
             static ReturnValue readFromFile(int* data, int n, const char* datafilename);
 
 
-            /** Read float data from file **/
+            /** Read float data from a text, binary or Matrix Market file (exactly n numbers are expected, matrices are stored row by row) **/
             static ReturnValue readFromFile(double* data, int n, const char* datafilename );
 
 
-            /** Read float data from file **/
-            static ReturnValue writeToFile(double* data, int n, const char* datafilename );
+            /** Read a Matrix Market file into a new csc matrix (entries are sorted, duplicates summed, to be freed by ClearSparseMat) **/
+            static ReturnValue readMatrixMarket(csc** M, const char* datafilename );
+
+
+            /** Write float data to a text (one value per line, 17 significant digits) or binary file (ending with .bin), i.e. lossless **/
+            static ReturnValue writeToFile(const double* const data, int n, const char* datafilename );
 
 
             /** Print a double valued matrix **/
@@ -256,6 +329,18 @@ namespace LCQPow {
             static csc* copyCSC(const csc* const M, bool toUpperTriangular = false);
 
 
+            /** Copy a csc matrix into *dst, the memory of *dst is reused if the dimensions and number of entries match (otherwise it is reallocated) **/
+            static void assignCSC(const csc* const M, csc** dst);
+
+
+            /** Whether a csc matrix has the given dimensions and sparsity pattern (column pointers p and row indices i) **/
+            static bool hasPattern(const csc* const M, int m, int n, const int* const p, const int* const i);
+
+
+            /** Transpose a csc matrix (a new matrix with sorted row indices is allocated) **/
+            static csc* transposeCSC(const csc* const M);
+
+
             /** Copy an integer array **/
             static void copyIntToIntT(int* dest, const int* const src, int n);
 
@@ -342,6 +427,20 @@ namespace LCQPow {
 			}
 
 
+            /** Allocates a copy of an array (a null pointer is returned if src is a null pointer). */
+			template <typename T>
+		    static T* copyArray(const T* const src, size_t n) {
+                if (isNullPtr(src))
+                    return 0;
+
+                T* dest = new T[n];
+                for (size_t i = 0; i < n; i++)
+                    dest[i] = src[i];
+
+                return dest;
+			}
+
+
             /** Numerical value of machine precision (min eps, s.t. 1+eps > 1).
              *	Note: this value has to be positive! */
             #ifdef __USE_SINGLE_PRECISION__
@@ -690,8 +690,11 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
             "etaDynamicPenalty",
             "printLevel",
             "storeSteps",
+            "stepStorage",
+            "stepStorageSize",
             "qpSolver",
             "perturbStep",
+            "randomSeed",
             "qpOASES_options",
             "OSQP_options"
         };
@@ -755,6 +758,14 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
                 continue;
             }
 
+            if ( strcmp(name, "randomSeed") == 0 ) {
+                if (!checkDimensionAndTypeDouble(field, 1, 1, "params.randomSeed")) return;
+
+                fld_ptr = (double*) mxGetPr(field);
+                options.setRandomSeed( (unsigned int)fld_ptr[0] );
+                continue;
+            }
+
             if ( strcmp(name, "maxIterations") == 0 ) {
                 if (!checkDimensionAndTypeDouble(field, 1, 1, "params.maxIterations")) return;
 
@@ -803,6 +814,22 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
                 continue;
             }
 
+            if ( strcmp(name, "stepStorage") == 0 ) {
+                if (!checkDimensionAndTypeDouble(field, 1, 1, "params.stepStorage")) return;
+
+                fld_ptr = (double*) mxGetPr(field);
+                options.setStepStorage( (int)fld_ptr[0] );
+                continue;
+            }
+
+            if ( strcmp(name, "stepStorageSize") == 0 ) {
+                if (!checkDimensionAndTypeDouble(field, 1, 1, "params.stepStorageSize")) return;
+
+                fld_ptr = (double*) mxGetPr(field);
+                options.setStepStorageSize( (int)fld_ptr[0] );
+                continue;
+            }
+
             if ( strcmp(name, "qpSolver") == 0 ) {
                 if (!checkDimensionAndTypeDouble(field, 1, 1, "params.qpSolver")) return;
 
@@ -905,11 +932,8 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
         lcqp.getDualSolution(yOptTMP);
     }
 
-    // Get the statistics
-    LCQPow::OutputStatistics stats;
-    if (nlhs > 2) {
-        lcqp.getOutputStatistics(stats);
-    }
+    // Get the statistics (without copying, the object lives until the end of this call)
+    const LCQPow::OutputStatistics& stats = lcqp.getOutputStatistics();
 
     // Stop the timer
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
@@ -1013,11 +1037,31 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
         mxSetFieldByNumber(plhs[2], 0, 6, solution_type);
         mxSetFieldByNumber(plhs[2], 0, 7, qp_exit_flag);
 
+        // Wall-clock time of the solver phases
+        const char* timeFieldnames[] = {
+            "time_setup", "time_qp_solve", "time_linearization", "time_stationarity",
+            "time_step_length", "time_termination", "time_bookkeeping"
+        };
+
+        for (int k = 0; k < LCQPow::NUMBER_OF_PHASES; k++) {
+            mxArray* phaseTime = mxCreateDoubleMatrix(1, 1, mxREAL);
+            mxGetPr(phaseTime)[0] = stats.getPhaseTime( (LCQPow::SolverPhase)k );
+
+            mxAddField(plhs[2], timeFieldnames[k]);
+            mxSetField(plhs[2], 0, timeFieldnames[k], phaseTime);
+        }
+
+        mxArray* timeTotal = mxCreateDoubleMatrix(1, 1, mxREAL);
+        mxGetPr(timeTotal)[0] = stats.getTimeTotal();
+
+        mxAddField(plhs[2], "time_total");
+        mxSetField(plhs[2], 0, "time_total", timeTotal);
+
         // Tracking values
         if (options.getStoreSteps()) {
 
             if (stats.getIterTotal() > 0) {
-                mxArray* xStepsArr = mxCreateDoubleMatrix((mwSize)(stats.getIterTotal()*nV), 1, mxREAL);
+                mxArray* xStepsArr = mxCreateDoubleMatrix((mwSize)(stats.getNumberOfxSteps()*nV), 1, mxREAL);
                 mxArray* innerItersArr = mxCreateDoubleMatrix((mwSize)stats.getIterTotal(), 1, mxREAL);
                 mxArray* subproblemItersArr = mxCreateDoubleMatrix((mwSize)stats.getIterTotal(), 1, mxREAL);
                 mxArray* accuSubproblemItersArr = mxCreateDoubleMatrix((mwSize)stats.getIterTotal(), 1, mxREAL);
@@ -1039,7 +1083,6 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
                 double* phiVals = (double*) mxGetPr(phiValsArr);
                 double* meritVals = (double*) mxGetPr(meritValsArr);
 
-                std::vector<std::vector<double>> xStepsTMP = stats.getxStepsStdVec( );
                 int* innerItersTMP = stats.getInnerIters( );
                 int* subproblemItersTMP = stats.getSubproblemIters( );
                 int* accuSubproblemItersTMP = stats.getAccuSubproblemIters( );
@@ -1050,11 +1093,16 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
                 double* phiValsTMP = stats.getPhiVals( );
                 double* meritValsTMP = stats.getMeritVals( );
 
-                for (int i = 0; i < stats.getIterTotal(); i++) {
+                // Stored iterates only (see params.stepStorage)
+                for (int i = 0; i < stats.getNumberOfxSteps(); i++) {
+                    const double* xStepTMP = stats.getxStep(i);
+
                     for (int j = 0; j < nV; j++) {
-                        xSteps[i*nV+j] = xStepsTMP[i][j];
+                        xSteps[i*nV+j] = xStepTMP[j];
                     }
+                }
 
+                for (int i = 0; i < stats.getIterTotal(); i++) {
                     innerIters[i] = innerItersTMP[i];
                     subproblemIters[i] = subproblemItersTMP[i];
                     accuSubproblemIters[i] = accuSubproblemItersTMP[i];
@@ -1086,7 +1134,39 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
                 delete[] objValsTMP;
                 delete[] phiValsTMP;
                 delete[] meritValsTMP;
-                xStepsTMP.clear();
+
+                // QP subproblem telemetry
+                std::vector<double> subproblemTimes = stats.getSubproblemTimesStdVec( );
+                std::vector<int> subproblemRhoUpdates = stats.getSubproblemRhoUpdatesStdVec( );
+                std::vector<int> subproblemFactorizations = stats.getSubproblemFactorizationsStdVec( );
+                std::vector<double> subproblemPrimalResiduals = stats.getSubproblemPrimalResidualsStdVec( );
+                std::vector<double> subproblemDualResiduals = stats.getSubproblemDualResidualsStdVec( );
+
+                mxArray* subproblemTimesArr = mxCreateDoubleMatrix((mwSize)subproblemTimes.size(), 1, mxREAL);
+                mxArray* subproblemRhoUpdatesArr = mxCreateDoubleMatrix((mwSize)subproblemRhoUpdates.size(), 1, mxREAL);
+                mxArray* subproblemFactorizationsArr = mxCreateDoubleMatrix((mwSize)subproblemFactorizations.size(), 1, mxREAL);
+                mxArray* subproblemPrimalResidualsArr = mxCreateDoubleMatrix((mwSize)subproblemPrimalResiduals.size(), 1, mxREAL);
+                mxArray* subproblemDualResidualsArr = mxCreateDoubleMatrix((mwSize)subproblemDualResiduals.size(), 1, mxREAL);
+
+                for (size_t i = 0; i < subproblemTimes.size(); i++) {
+                    mxGetPr(subproblemTimesArr)[i] = subproblemTimes[i];
+                    mxGetPr(subproblemRhoUpdatesArr)[i] = subproblemRhoUpdates[i];
+                    mxGetPr(subproblemFactorizationsArr)[i] = subproblemFactorizations[i];
+                    mxGetPr(subproblemPrimalResidualsArr)[i] = subproblemPrimalResiduals[i];
+                    mxGetPr(subproblemDualResidualsArr)[i] = subproblemDualResiduals[i];
+                }
+
+                mxAddField(plhs[2], "subproblemTimes");
+                mxAddField(plhs[2], "subproblemRhoUpdates");
+                mxAddField(plhs[2], "subproblemFactorizations");
+                mxAddField(plhs[2], "subproblemPrimalResiduals");
+                mxAddField(plhs[2], "subproblemDualResiduals");
+
+                mxSetField(plhs[2], 0, "subproblemTimes", subproblemTimesArr);
+                mxSetField(plhs[2], 0, "subproblemRhoUpdates", subproblemRhoUpdatesArr);
+                mxSetField(plhs[2], 0, "subproblemFactorizations", subproblemFactorizationsArr);
+                mxSetField(plhs[2], 0, "subproblemPrimalResiduals", subproblemPrimalResidualsArr);
+                mxSetField(plhs[2], 0, "subproblemDualResiduals", subproblemDualResidualsArr);
             }
         }
     }
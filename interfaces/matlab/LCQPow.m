@@ -47,11 +47,14 @@
 %            penaltyUpdateFactor : Factor for updating penaltised complementarity term.
 %          solveZeroPenaltyFirst : Flag indicating whether first QP should ignore penalization.
 %                    perturbStep : Flag indicating whether to perform step perturbation.
+%                     randomSeed : Seed of the step perturbation.
 %                  maxIterations : Maximum number of iterations to be performed.
 %            maxPenaltyParameter : Maximum penalty value.
 %                     printLevel : The amount of output to be printed.
 %                nDynamicPenalty : The number of complementarity values to be compared in Leyffer check.
 %              etaDynamicPenalty : Complementarity reduction factor required in at least one of the lastet nDynamicPenalty steps.
+%                    stepStorage : Stored iterates if storeSteps is set (0: all, 1: latest stepStorageSize, 2: every stepStorageSize-th).
+%                stepStorageSize : Size of the ring buffer or sampling interval of the stored iterates.
 %                qpOASES_options : A qpOASES options struct.
 %                   OSQP_options : A OSQP options (settings) struct (to be implemented).
 %
@@ -66,4 +69,18 @@
 %                stats.exit_flag : Exit flag (0 on success, else some error according to the enum ReturnValue within Utilities.hpp)
 %            stats.solution_type : Solution type (0:failed, 1:Weak, 2:Clarke, 3:Mordukhovich, 4:Strong).
 %             stats.qp_exit_flag : A flag indicating the most recent status flag of the QP solver.
+%               stats.time_total : Wall-clock time of the solve measured by the solver (sum of the phases below)
+%               stats.time_setup : Time of loading, building C and Qk and initializing the QP subsolver
+%            stats.time_qp_solve : Time spent in the QP subproblems
+%       stats.time_linearization : Time of the penalty linearization and penalty updates
+%        stats.time_stationarity : Time of the stationarity evaluation
+%         stats.time_step_length : Time of the step length computation and step updates
+%         stats.time_termination : Time of the termination checks
+%         stats.time_bookkeeping : Remaining time (printing, storing steps)
+%                   stats.xSteps : Stored primal iterates, stacked (only if storeSteps is set, see stepStorage)
+%          stats.subproblemTimes : Wall-clock time of each QP subproblem (only if storeSteps is set)
+%     stats.subproblemRhoUpdates : Rho updates of each QP subproblem (OSQP, only if storeSteps is set)
+% stats.subproblemFactorizations : Factorizations of each QP subproblem (only if storeSteps is set)
+% stats.subproblemPrimalResiduals : Maximum constraint violation of each QP solution (only if storeSteps is set)
+% stats.subproblemDualResiduals : Maximum stationarity violation of each QP solution (only if storeSteps is set)
 %
\ No newline at end of file
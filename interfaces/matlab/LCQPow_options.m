@@ -8,6 +8,7 @@ function [ options ] = LCQPow_default_options( )
 						'penaltyUpdateFactor',      2.0 ...
 						'solveZeroPenaltyFirst',    1, ...
 						'perturbStep',              1, ...
+						'randomSeed',               0, ...
 						'maxIterations',            1000, ...      
 						'maxPenaltyParameter',      1.0e8, ...      
 						'printLevel',               1, ...
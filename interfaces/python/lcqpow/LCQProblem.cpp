@@ -7,6 +7,7 @@
 #include "Eigen/Core"
 
 #include "LCQProblem.hpp"
+#include "LCQPContainer.hpp"
 
 extern "C" {
     #include <osqp.h>
@@ -171,8 +172,94 @@ PYBIND11_MODULE(LCQProblem, m) {
             return yOpt;
          })
     .def("getNumberOfDuals", &LCQProblem::getNumberOfDuals)
-    .def("getOutputStatistics", &LCQProblem::getOutputStatistics)
+    .def("getOutputStatistics", static_cast<void (LCQProblem::*)(OutputStatistics&) const>(&LCQProblem::getOutputStatistics))
+    .def("getOutputStatistics", static_cast<const OutputStatistics& (LCQProblem::*)() const>(&LCQProblem::getOutputStatistics), 
+         py::return_value_policy::reference_internal)
     .def("setOptions", &LCQProblem::setOptions);
+
+  py::class_<LCQPContainer>(m, "LCQPContainer")
+    .def(py::init<>())
+    .def("open", &LCQPContainer::open, py::arg("filename"))
+    .def("close", &LCQPContainer::close)
+    .def("isOpen", &LCQPContainer::isOpen)
+    .def("isSparse", &LCQPContainer::isSparse)
+    .def("getNV", &LCQPContainer::getNV)
+    .def("getNC", &LCQPContainer::getNC)
+    .def("getNComp", &LCQPContainer::getNComp)
+    .def("load", &LCQPContainer::load, py::arg("lcqp"), 
+         py::keep_alive<2, 1>())
+    .def_static("write", [](const char* filename, int nV, int nC, int nComp, 
+                            const Eigen::MatrixXd& Q, const Eigen::VectorXd& g, 
+                            const Eigen::MatrixXd& L, const Eigen::MatrixXd& R, 
+                            const Eigen::VectorXd& lbL, const Eigen::VectorXd& ubL, 
+                            const Eigen::VectorXd& lbR, const Eigen::VectorXd& ubR, 
+                            const Eigen::MatrixXd& A, 
+                            const Eigen::VectorXd& lbA, const Eigen::VectorXd& ubA,
+                            const Eigen::VectorXd& lb, const Eigen::VectorXd& ub,  
+                            const Eigen::VectorXd& x0, const Eigen::VectorXd& y0) {
+            return LCQPContainer::write(filename, nV, nC, nComp, 
+                                        Q.data(), g.data(), L.data(), R.data(), 
+                                        getRawPtrFromEigenVectorXd(lbL),
+                                        getRawPtrFromEigenVectorXd(ubL),
+                                        getRawPtrFromEigenVectorXd(lbR),
+                                        getRawPtrFromEigenVectorXd(ubR),
+                                        getRawPtrFromEigenMatrixXd(A),
+                                        getRawPtrFromEigenVectorXd(lbA),
+                                        getRawPtrFromEigenVectorXd(ubA),
+                                        getRawPtrFromEigenVectorXd(lb),
+                                        getRawPtrFromEigenVectorXd(ub),
+                                        getRawPtrFromEigenVectorXd(x0),
+                                        getRawPtrFromEigenVectorXd(y0));
+          },
+          py::arg("filename"), py::arg("nV"), py::arg("nC"), py::arg("nComp"), 
+          py::arg("Q"), py::arg("g"), py::arg("L"), py::arg("R"), 
+          py::arg("lbL")=Eigen::VectorXd::Zero(0), 
+          py::arg("ubL")=Eigen::VectorXd::Zero(0), 
+          py::arg("lbR")=Eigen::VectorXd::Zero(0), 
+          py::arg("ubR")=Eigen::VectorXd::Zero(0), 
+          py::arg("A")=Eigen::MatrixXd::Zero(0, 0), 
+          py::arg("lbA")=Eigen::VectorXd::Zero(0), 
+          py::arg("ubA")=Eigen::VectorXd::Zero(0), 
+          py::arg("lb")=Eigen::VectorXd::Zero(0), 
+          py::arg("ub")=Eigen::VectorXd::Zero(0), 
+          py::arg("x0")=Eigen::VectorXd::Zero(0), 
+          py::arg("y0")=Eigen::VectorXd::Zero(0))
+    .def_static("write", [](const char* filename, int nV, int nC, int nComp, 
+                            const cscWrapper& Q, const Eigen::VectorXd& g, 
+                            const cscWrapper& L, const cscWrapper& R, 
+                            const Eigen::VectorXd& lbL, const Eigen::VectorXd& ubL, 
+                            const Eigen::VectorXd& lbR, const Eigen::VectorXd& ubR, 
+                            const cscWrapper& A, 
+                            const Eigen::VectorXd& lbA, const Eigen::VectorXd& ubA,
+                            const Eigen::VectorXd& lb, const Eigen::VectorXd& ub,  
+                            const Eigen::VectorXd& x0, const Eigen::VectorXd& y0) {
+            return LCQPContainer::write(filename, nV, nC, nComp, 
+                                        Q.getPtr(), g.data(), L.getPtr(), R.getPtr(), 
+                                        getRawPtrFromEigenVectorXd(lbL),
+                                        getRawPtrFromEigenVectorXd(ubL),
+                                        getRawPtrFromEigenVectorXd(lbR),
+                                        getRawPtrFromEigenVectorXd(ubR),
+                                        A.getPtr(),
+                                        getRawPtrFromEigenVectorXd(lbA),
+                                        getRawPtrFromEigenVectorXd(ubA),
+                                        getRawPtrFromEigenVectorXd(lb),
+                                        getRawPtrFromEigenVectorXd(ub),
+                                        getRawPtrFromEigenVectorXd(x0),
+                                        getRawPtrFromEigenVectorXd(y0));
+          },
+          py::arg("filename"), py::arg("nV"), py::arg("nC"), py::arg("nComp"), 
+          py::arg("Q"), py::arg("g"), py::arg("L"), py::arg("R"), 
+          py::arg("lbL")=Eigen::VectorXd::Zero(0), 
+          py::arg("ubL")=Eigen::VectorXd::Zero(0), 
+          py::arg("lbR")=Eigen::VectorXd::Zero(0), 
+          py::arg("ubR")=Eigen::VectorXd::Zero(0), 
+          py::arg("A")=cscWrapper(), 
+          py::arg("lbA")=Eigen::VectorXd::Zero(0), 
+          py::arg("ubA")=Eigen::VectorXd::Zero(0), 
+          py::arg("lb")=Eigen::VectorXd::Zero(0), 
+          py::arg("ub")=Eigen::VectorXd::Zero(0), 
+          py::arg("x0")=Eigen::VectorXd::Zero(0), 
+          py::arg("y0")=Eigen::VectorXd::Zero(0));
 }
 
 } // namespace python
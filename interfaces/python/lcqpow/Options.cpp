@@ -23,6 +23,8 @@ PYBIND11_MODULE(Options, m) {
     .def("setPenaltyUpdateFactor", &Options::setPenaltyUpdateFactor)
     .def("getSolveZeroPenaltyFirst", &Options::getSolveZeroPenaltyFirst)
     .def("setSolveZeroPenaltyFirst", &Options::setSolveZeroPenaltyFirst)
+    .def("getRandomSeed", &Options::getRandomSeed)
+    .def("setRandomSeed", &Options::setRandomSeed)
     .def("getMaxIterations", &Options::getMaxIterations)
     .def("setMaxIterations", &Options::setMaxIterations)
     .def("getMaxPenaltyParameter", &Options::getMaxPenaltyParameter)
@@ -36,6 +38,15 @@ PYBIND11_MODULE(Options, m) {
     .def("setPrintLevel", static_cast<ReturnValue (Options::*)(int)>(&Options::setPrintLevel))
     .def("getStoreSteps", &Options::getStoreSteps)
     .def("setStoreSteps", &Options::setStoreSteps)
+    .def("getStepFile", &Options::getStepFile)
+    .def("setStepFile", &Options::setStepFile)
+    .def("getStepStorage", &Options::getStepStorage)
+    .def("setStepStorage", static_cast<ReturnValue (Options::*)(StepStorage)>(&Options::setStepStorage))
+    .def("setStepStorage", static_cast<ReturnValue (Options::*)(int)>(&Options::setStepStorage))
+    .def("getStepStorageSize", &Options::getStepStorageSize)
+    .def("setStepStorageSize", &Options::setStepStorageSize)
+    .def("getDumpFile", &Options::getDumpFile)
+    .def("setDumpFile", &Options::setDumpFile)
     .def("getQPSolver", &Options::getQPSolver)
     .def("setQPSolver", static_cast<ReturnValue (Options::*)(QPSolver)>(&Options::setQPSolver))
     .def("setQPSolver", static_cast<ReturnValue (Options::*)(int)>(&Options::setQPSolver));
@@ -1,6 +1,8 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "OutputStatistics.hpp"
@@ -20,6 +22,8 @@ PYBIND11_MODULE(OutputStatistics, m) {
     .def("getRhoOpt", &OutputStatistics::getRhoOpt)
     .def("getSolutionStatus", &OutputStatistics::getSolutionStatus)
     .def("getQPSolverExitFlag", &OutputStatistics::getQPSolverExitFlag)
+    .def("getPhaseTime", &OutputStatistics::getPhaseTime)
+    .def("getTimeTotal", &OutputStatistics::getTimeTotal)
     .def("getInnerIters", &OutputStatistics::getInnerItersStdVec)
     .def("getSubproblemIters", &OutputStatistics::getSubproblemItersStdVec)
     .def("getAccuSubproblemIters", &OutputStatistics::getAccuSubproblemItersStdVec)
@@ -28,7 +32,21 @@ PYBIND11_MODULE(OutputStatistics, m) {
     .def("getStatVals", &OutputStatistics::getStatValsStdVec)
     .def("getObjVals", &OutputStatistics::getObjValsStdVec)
     .def("getPhiVals", &OutputStatistics::getPhiValsStdVec)
-    .def("getMeritVals", &OutputStatistics::getMeritValsStdVec);
+    .def("getMeritVals", &OutputStatistics::getMeritValsStdVec)
+    .def("getSubproblemTimes", &OutputStatistics::getSubproblemTimesStdVec)
+    .def("getSubproblemRhoUpdates", &OutputStatistics::getSubproblemRhoUpdatesStdVec)
+    .def("getSubproblemFactorizations", &OutputStatistics::getSubproblemFactorizationsStdVec)
+    .def("getSubproblemPrimalResiduals", &OutputStatistics::getSubproblemPrimalResidualsStdVec)
+    .def("getSubproblemDualResiduals", &OutputStatistics::getSubproblemDualResidualsStdVec)
+    .def("getNumberOfxSteps", &OutputStatistics::getNumberOfxSteps)
+    .def("getxStepIters", &OutputStatistics::getxStepItersStdVec)
+    .def("getxSteps", [](const OutputStatistics& self) {
+            // One row per stored iterate, copied once into the array
+            py::array_t<double> xSteps({ self.getNumberOfxSteps(), self.getxStepLength() });
+            for (int k = 0; k < self.getNumberOfxSteps(); k++)
+              std::copy(self.getxStep(k), self.getxStep(k) + self.getxStepLength(), xSteps.mutable_data(k, 0));
+            return xSteps;
+         });
 }
 
 } // namespace python
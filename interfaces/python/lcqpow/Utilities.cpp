@@ -47,10 +47,13 @@ PYBIND11_MODULE(Utilities, m) {
     .value("FAILED_SWITCH_TO_SPARSE",  ReturnValue::FAILED_SWITCH_TO_SPARSE)
     .value("FAILED_SWITCH_TO_DENSE",  ReturnValue::FAILED_SWITCH_TO_DENSE)
     .value("OSQP_WORKSPACE_NOT_SET_UP",  ReturnValue::OSQP_WORKSPACE_NOT_SET_UP)
+    .value("SOLVER_ABORTED_BY_CALLBACK",  ReturnValue::SOLVER_ABORTED_BY_CALLBACK)
     // Generic errors
     .value("LCQPOBJECT_NOT_SETUP",  ReturnValue::LCQPOBJECT_NOT_SETUP)
     .value("INDEX_OUT_OF_BOUNDS ",  ReturnValue::INDEX_OUT_OF_BOUNDS)
     .value("UNABLE_TO_READ_FILE ",  ReturnValue::UNABLE_TO_READ_FILE)
+    .value("CALLBACKS_DISABLED",  ReturnValue::CALLBACKS_DISABLED)
+    .value("UNABLE_TO_WRITE_FILE",  ReturnValue::UNABLE_TO_WRITE_FILE)
     // Sparse matrices
     .value("INVALID_INDEX_POINTER ",  ReturnValue::INVALID_INDEX_POINTER)
     .value("INVALID_INDEX_ARRAY ",  ReturnValue::INVALID_INDEX_ARRAY)
@@ -75,6 +78,22 @@ PYBIND11_MODULE(Utilities, m) {
     .value("QPOASES_SPARSE", QPSolver::QPOASES_SPARSE)
     .value("OSQP_SPARSE", QPSolver::OSQP_SPARSE)
     .export_values();
+
+  py::enum_<StepStorage>(m, "StepStorage", py::arithmetic())
+    .value("STORE_ALL_STEPS", StepStorage::STORE_ALL_STEPS)
+    .value("STORE_LAST_STEPS", StepStorage::STORE_LAST_STEPS)
+    .value("STORE_SAMPLED_STEPS", StepStorage::STORE_SAMPLED_STEPS)
+    .export_values();
+
+  py::enum_<SolverPhase>(m, "SolverPhase", py::arithmetic())
+    .value("PHASE_SETUP", SolverPhase::PHASE_SETUP)
+    .value("PHASE_QP_SOLVE", SolverPhase::PHASE_QP_SOLVE)
+    .value("PHASE_LINEARIZATION", SolverPhase::PHASE_LINEARIZATION)
+    .value("PHASE_STATIONARITY", SolverPhase::PHASE_STATIONARITY)
+    .value("PHASE_STEP_LENGTH", SolverPhase::PHASE_STEP_LENGTH)
+    .value("PHASE_TERMINATION", SolverPhase::PHASE_TERMINATION)
+    .value("PHASE_BOOKKEEPING", SolverPhase::PHASE_BOOKKEEPING)
+    .export_values();
 }
 
 } // namespace python
@@ -0,0 +1,443 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "ConstraintMatrix.hpp"
+#include "DenseKernels.hpp"
+
+#include <string.h>
+
+namespace LCQPow {
+
+
+    ConstraintMatrix::ConstraintMatrix( ) { }
+
+
+    ConstraintMatrix::ConstraintMatrix( const ConstraintMatrix& rhs )
+    {
+        copy( rhs );
+    }
+
+
+    ConstraintMatrix::~ConstraintMatrix( )
+    {
+        clear( );
+    }
+
+
+    ConstraintMatrix& ConstraintMatrix::operator=( const ConstraintMatrix& rhs )
+    {
+        if ( this != &rhs )
+        {
+            clear( );
+            copy( rhs );
+        }
+
+        return *this;
+    }
+
+
+    void ConstraintMatrix::setUp( int _nV, int _nC, int _nComp, const double* const A, const double* const L, const double* const R )
+    {
+        // Reuse the dense matrix of a previous set up of the same dimensions
+        double* previous = NULL;
+
+        if (Utilities::isNotNullPtr(M) && nV == _nV && nC == _nC && nComp == _nComp) {
+            previous = M;
+            M = NULL;
+        }
+
+        clear( );
+
+        nV = _nV;
+        nC = _nC;
+        nComp = _nComp;
+
+        // Row major storage: the blocks are consecutive row ranges
+        M = Utilities::isNotNullPtr(previous) ? previous : new double[(size_t)getNumberOfRows()*nV];
+
+        if (nC > 0)
+            memcpy(M, A, (size_t)nC*(size_t)nV*sizeof(double));
+
+        memcpy(M + (size_t)nC*(size_t)nV, L, (size_t)nComp*(size_t)nV*sizeof(double));
+        memcpy(M + (size_t)(nC + nComp)*(size_t)nV, R, (size_t)nComp*(size_t)nV*sizeof(double));
+
+        detectSelectors( );
+    }
+
+
+    void ConstraintMatrix::setUp( int _nV, int _nC, int _nComp, const csc* const A, const csc* const L, const csc* const R )
+    {
+        clear( );
+
+        nV = _nV;
+        nC = _nC;
+        nComp = _nComp;
+
+        bool hasA = Utilities::isNotNullPtr(A) && Utilities::isNotNullPtr(A->p);
+
+        // Get number of elements
+        int nnx = L->p[nV] + R->p[nV];
+
+        if (hasA)
+            nnx += A->p[nV];
+
+        double* M_x = (double*)malloc((size_t)nnx*sizeof(double));
+        int* M_i = (int*)malloc((size_t)nnx*sizeof(int));
+        int* M_p = (int*)malloc((size_t)(nV+1)*sizeof(int));
+
+        blockPointers.resize((size_t)(4*nV));
+
+        int index_data = 0;
+        M_p[0] = 0;
+
+        // Iterate over columns and append the rows of A, L and R
+        for (int j = 0; j < nV; j++) {
+            blockPointers[(size_t)(4*j + BLOCK_A)] = index_data;
+
+            if (hasA) {
+                for (int k = A->p[j]; k < A->p[j+1]; k++) {
+                    M_x[index_data] = A->x[k];
+                    M_i[index_data] = A->i[k];
+                    index_data++;
+                }
+            }
+
+            blockPointers[(size_t)(4*j + BLOCK_L)] = index_data;
+
+            for (int k = L->p[j]; k < L->p[j+1]; k++) {
+                M_x[index_data] = L->x[k];
+                M_i[index_data] = nC + L->i[k];
+                index_data++;
+            }
+
+            blockPointers[(size_t)(4*j + BLOCK_R)] = index_data;
+
+            for (int k = R->p[j]; k < R->p[j+1]; k++) {
+                M_x[index_data] = R->x[k];
+                M_i[index_data] = nC + nComp + R->i[k];
+                index_data++;
+            }
+
+            blockPointers[(size_t)(4*j + 3)] = index_data;
+            M_p[j+1] = index_data;
+        }
+
+        M_sparse = Utilities::createCSC(getNumberOfRows(), nV, nnx, M_x, M_i, M_p);
+
+        detectSelectors( );
+    }
+
+
+    ReturnValue ConstraintMatrix::switchToSparseMode( )
+    {
+        if (isSparse())
+            return SUCCESSFUL_RETURN;
+
+        if (Utilities::isNullPtr(M))
+            return FAILED_SWITCH_TO_SPARSE;
+
+        M_sparse = Utilities::dns_to_csc(M, getNumberOfRows(), nV);
+
+        if (Utilities::isNullPtr(M_sparse))
+            return FAILED_SWITCH_TO_SPARSE;
+
+        setBlockPointers( );
+
+        delete[] M;
+        M = NULL;
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue ConstraintMatrix::switchToDenseMode( )
+    {
+        if (!isSparse())
+            return SUCCESSFUL_RETURN;
+
+        M = Utilities::csc_to_dns(M_sparse);
+
+        if (Utilities::isNullPtr(M))
+            return FAILED_SWITCH_TO_DENSE;
+
+        Utilities::ClearSparseMat(&M_sparse);
+        blockPointers.clear();
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    void ConstraintMatrix::clear( )
+    {
+        if (Utilities::isNotNullPtr(M)) {
+            delete[] M;
+            M = NULL;
+        }
+
+        Utilities::ClearSparseMat(&M_sparse);
+        blockPointers.clear();
+
+        for (int b = BLOCK_A; b <= BLOCK_R; b++)
+            selectorColumns[b].clear();
+
+        nV = 0;
+        nC = 0;
+        nComp = 0;
+    }
+
+
+    bool ConstraintMatrix::isSparse( ) const
+    {
+        return Utilities::isNotNullPtr(M_sparse);
+    }
+
+
+    int ConstraintMatrix::getNumberOfRows( ) const
+    {
+        return nC + 2*nComp;
+    }
+
+
+    const double* ConstraintMatrix::getDense( ) const
+    {
+        return M;
+    }
+
+
+    const csc* ConstraintMatrix::getSparse( ) const
+    {
+        return M_sparse;
+    }
+
+
+    const int* ConstraintMatrix::getSelectorColumns( ConstraintBlock block ) const
+    {
+        if (selectorColumns[block].empty())
+            return 0;
+
+        return selectorColumns[block].data();
+    }
+
+
+    void ConstraintMatrix::multiply( ConstraintBlock block, const double* const x, double* y ) const
+    {
+        multiply( block, block, x, y );
+    }
+
+
+    void ConstraintMatrix::multiply( ConstraintBlock first, ConstraintBlock last, const double* const x, double* y ) const
+    {
+        bool hasSelector = false;
+        for (int b = first; b <= last; b++)
+            hasSelector = hasSelector || !selectorColumns[b].empty();
+
+        if (!hasSelector) {
+            multiplyBlocks( first, last, x, y );
+            return;
+        }
+
+        // Gather the entries of x for selector blocks
+        for (int b = first; b <= last; b++) {
+            double* y_b = y + getBlockOffset(b) - getBlockOffset(first);
+
+            if (selectorColumns[b].empty()) {
+                multiplyBlocks( b, b, x, y_b );
+                continue;
+            }
+
+            for (size_t i = 0; i < selectorColumns[b].size(); i++)
+                y_b[i] = x[selectorColumns[b][i]];
+        }
+    }
+
+
+    void ConstraintMatrix::multiplyBlocks( int first, int last, const double* const x, double* y ) const
+    {
+        int offset = getBlockOffset(first);
+        int nRows = getBlockOffset(last + 1) - offset;
+
+        if (isSparse()) {
+            for (int i = 0; i < nRows; i++)
+                y[i] = 0;
+
+            // The entries of consecutive blocks are consecutive within each column
+            for (int j = 0; j < nV; j++) {
+                if (x[j] == 0)
+                    continue;
+
+                for (int k = blockPointers[(size_t)(4*j + first)]; k < blockPointers[(size_t)(4*j + last + 1)]; k++)
+                    y[M_sparse->i[k] - offset] += M_sparse->x[k]*x[j];
+            }
+        } else {
+            DenseKernels::MatrixVectorProduct(1, M + (size_t)offset*(size_t)nV, x, 0, y, nRows, nV);
+        }
+    }
+
+
+    void ConstraintMatrix::addTransposedMultiply( double alpha, const double* const y, double* x ) const
+    {
+        // Treat selector blocks separately
+        if (!selectorColumns[BLOCK_A].empty() || !selectorColumns[BLOCK_L].empty() || !selectorColumns[BLOCK_R].empty()) {
+            for (int b = BLOCK_A; b <= BLOCK_R; b++)
+                addTransposedMultiply( (ConstraintBlock)b, alpha, y + getBlockOffset(b), x );
+
+            return;
+        }
+
+        if (isSparse()) {
+            // Column j of the stacked matrix holds the entries of all blocks
+            for (int j = 0; j < nV; j++) {
+                double tmp = 0;
+
+                for (int k = M_sparse->p[j]; k < M_sparse->p[j+1]; k++)
+                    tmp += M_sparse->x[k]*y[M_sparse->i[k]];
+
+                x[j] += alpha*tmp;
+            }
+        } else {
+            DenseKernels::AddTransposedMatrixVectorProduct(alpha, M, y, x, getNumberOfRows(), nV);
+        }
+    }
+
+
+    void ConstraintMatrix::addTransposedMultiply( ConstraintBlock block, double alpha, const double* const y, double* x ) const
+    {
+        int offset = getBlockOffset(block);
+        int nRows = getBlockOffset(block + 1) - offset;
+
+        // Scatter the entries of y for selector blocks
+        if (!selectorColumns[block].empty()) {
+            for (int i = 0; i < nRows; i++)
+                x[selectorColumns[block][(size_t)i]] += alpha*y[i];
+
+            return;
+        }
+
+        if (isSparse()) {
+            for (int j = 0; j < nV; j++) {
+                double tmp = 0;
+
+                for (int k = blockPointers[(size_t)(4*j + block)]; k < blockPointers[(size_t)(4*j + block + 1)]; k++)
+                    tmp += M_sparse->x[k]*y[M_sparse->i[k] - offset];
+
+                x[j] += alpha*tmp;
+            }
+        } else {
+            DenseKernels::AddTransposedMatrixVectorProduct(alpha, M + (size_t)offset*(size_t)nV, y, x, nRows, nV);
+        }
+    }
+
+
+    void ConstraintMatrix::copy( const ConstraintMatrix& rhs )
+    {
+        nV = rhs.nV;
+        nC = rhs.nC;
+        nComp = rhs.nComp;
+
+        M = Utilities::copyArray(rhs.M, (size_t)rhs.getNumberOfRows()*(size_t)nV);
+
+        if (Utilities::isNotNullPtr(rhs.M_sparse))
+            M_sparse = Utilities::copyCSC(rhs.M_sparse);
+
+        blockPointers = rhs.blockPointers;
+
+        for (int b = BLOCK_A; b <= BLOCK_R; b++)
+            selectorColumns[b] = rhs.selectorColumns[b];
+    }
+
+
+    int ConstraintMatrix::getBlockOffset( int block ) const
+    {
+        if (block <= BLOCK_A)
+            return 0;
+
+        if (block == BLOCK_L)
+            return nC;
+
+        if (block == BLOCK_R)
+            return nC + nComp;
+
+        return nC + 2*nComp;
+    }
+
+
+    void ConstraintMatrix::setBlockPointers( )
+    {
+        blockPointers.resize((size_t)(4*nV));
+
+        for (int j = 0; j < nV; j++) {
+            int k = M_sparse->p[j];
+
+            for (int b = BLOCK_A; b <= BLOCK_R; b++) {
+                blockPointers[(size_t)(4*j + b)] = k;
+
+                while (k < M_sparse->p[j+1] && M_sparse->i[k] < getBlockOffset(b + 1))
+                    k++;
+            }
+
+            blockPointers[(size_t)(4*j + 3)] = M_sparse->p[j+1];
+        }
+    }
+
+
+    void ConstraintMatrix::setSelectorColumn( std::vector<int>& columns, int row, int column, double val )
+    {
+        if (val == 0)
+            return;
+
+        columns[(size_t)row] = (val == 1 && columns[(size_t)row] == -1) ? column : -2;
+    }
+
+
+    void ConstraintMatrix::detectSelectors( )
+    {
+        int nRows = getNumberOfRows();
+
+        // Column of the (single) non-zero entry of each row, -2 if the row is no unit row
+        std::vector<int>& columns = rowColumns;
+        columns.assign((size_t)nRows, -1);
+
+        if (isSparse()) {
+            for (int j = 0; j < nV; j++)
+                for (int k = M_sparse->p[j]; k < M_sparse->p[j+1]; k++)
+                    setSelectorColumn(columns, M_sparse->i[k], j, M_sparse->x[k]);
+        } else {
+            for (int i = 0; i < nRows; i++)
+                for (int j = 0; j < nV; j++)
+                    setSelectorColumn(columns, i, j, M[(size_t)i*(size_t)nV + (size_t)j]);
+        }
+
+        for (int b = BLOCK_A; b <= BLOCK_R; b++) {
+            int offset = getBlockOffset(b);
+            int nBlockRows = getBlockOffset(b + 1) - offset;
+
+            bool isSelector = nBlockRows > 0;
+            for (int i = offset; i < offset + nBlockRows; i++)
+                isSelector = isSelector && columns[(size_t)i] >= 0;
+
+            selectorColumns[b].clear();
+
+            if (isSelector)
+                selectorColumns[b].assign(columns.begin() + offset, columns.begin() + offset + nBlockRows);
+        }
+    }
+}
@@ -0,0 +1,689 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "DenseKernels.hpp"
+
+#include <atomic>
+#include <string.h>
+
+// Runtime dispatch requires the GCC/Clang target attributes
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define LCQPOW_KERNELS_X86
+    #include <immintrin.h>
+#endif
+
+// Optional BLAS backend (Fortran interface, 32 bit integers). qpOASES is built with its BLAS replacement renamed
+// (__AVOID_LA_NAMING_CONFLICTS__, see CMakeLists.txt), i.e. these calls bind to the external BLAS only.
+#ifdef LCQPOW_USE_BLAS
+    extern "C" {
+        void dgemv_(const char* trans, const int* m, const int* n, const double* alpha, const double* A, const int* lda,
+                    const double* x, const int* incx, const double* beta, double* y, const int* incy);
+
+        void dgemm_(const char* transa, const char* transb, const int* m, const int* n, const int* k, const double* alpha,
+                    const double* A, const int* lda, const double* B, const int* ldb, const double* beta, double* C, const int* ldc);
+
+        void dsyr2k_(const char* uplo, const char* trans, const int* n, const int* k, const double* alpha,
+                     const double* A, const int* lda, const double* B, const int* ldb, const double* beta, double* C, const int* ldc);
+
+        void dsymv_(const char* uplo, const int* n, const double* alpha, const double* A, const int* lda,
+                    const double* x, const int* incx, const double* beta, double* y, const int* incy);
+    }
+#endif
+
+namespace LCQPow {
+
+    namespace {
+
+        // Block sizes: a JB segment of a row of the result stays in L1, a KB x JB tile of the right factor in L2
+        const int KB = 64;
+        const int JB = 256;
+        const int IB = 32;
+
+
+        /*
+         *  Vector primitives (implemented once per instruction set).
+         */
+        struct VectorPrimitives {
+            double (*dot)(const double* a, const double* b, int n);                     // a'*b
+            void (*dot4)(const double* const* a, const double* x, int n, double* res);  // res[r] = a[r]'*x, r = 0, ..., 3
+            void (*axpy)(double alpha, const double* x, double* y, int n);              // y += alpha*x
+            void (*axpy4)(const double* alpha, const double* const* x, double* y, int n); // y += sum_r alpha[r]*x[r], r = 0, ..., 3
+        };
+
+
+        double dotScalar(const double* a, const double* b, int n)
+        {
+            double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                s0 += a[i]*b[i];
+                s1 += a[i+1]*b[i+1];
+                s2 += a[i+2]*b[i+2];
+                s3 += a[i+3]*b[i+3];
+            }
+
+            for (; i < n; i++)
+                s0 += a[i]*b[i];
+
+            return (s0 + s1) + (s2 + s3);
+        }
+
+
+        void dot4Scalar(const double* const* a, const double* x, int n, double* res)
+        {
+            double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+            for (int i = 0; i < n; i++) {
+                s0 += a[0][i]*x[i];
+                s1 += a[1][i]*x[i];
+                s2 += a[2][i]*x[i];
+                s3 += a[3][i]*x[i];
+            }
+
+            res[0] = s0;
+            res[1] = s1;
+            res[2] = s2;
+            res[3] = s3;
+        }
+
+
+        void axpyScalar(double alpha, const double* x, double* y, int n)
+        {
+            for (int i = 0; i < n; i++)
+                y[i] += alpha*x[i];
+        }
+
+
+        void axpy4Scalar(const double* alpha, const double* const* x, double* y, int n)
+        {
+            for (int i = 0; i < n; i++)
+                y[i] += alpha[0]*x[0][i] + alpha[1]*x[1][i] + alpha[2]*x[2][i] + alpha[3]*x[3][i];
+        }
+
+
+        const VectorPrimitives scalarPrimitives = { dotScalar, dot4Scalar, axpyScalar, axpy4Scalar };
+
+
+        #ifdef LCQPOW_KERNELS_X86
+
+        __attribute__((target("avx2,fma")))
+        double hsumAVX2(__m256d v)
+        {
+            __m128d lo = _mm256_castpd256_pd128(v);
+            __m128d hi = _mm256_extractf128_pd(v, 1);
+            lo = _mm_add_pd(lo, hi);
+            return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+        }
+
+
+        __attribute__((target("avx2,fma")))
+        double dotAVX2(const double* a, const double* b, int n)
+        {
+            __m256d s0 = _mm256_setzero_pd();
+            __m256d s1 = _mm256_setzero_pd();
+
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+                s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+            }
+
+            for (; i + 4 <= n; i += 4)
+                s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+
+            double ret = hsumAVX2(_mm256_add_pd(s0, s1));
+
+            for (; i < n; i++)
+                ret += a[i]*b[i];
+
+            return ret;
+        }
+
+
+        __attribute__((target("avx2,fma")))
+        void dot4AVX2(const double* const* a, const double* x, int n, double* res)
+        {
+            __m256d s0 = _mm256_setzero_pd();
+            __m256d s1 = _mm256_setzero_pd();
+            __m256d s2 = _mm256_setzero_pd();
+            __m256d s3 = _mm256_setzero_pd();
+
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d xi = _mm256_loadu_pd(x + i);
+                s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a[0] + i), xi, s0);
+                s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a[1] + i), xi, s1);
+                s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a[2] + i), xi, s2);
+                s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a[3] + i), xi, s3);
+            }
+
+            res[0] = hsumAVX2(s0);
+            res[1] = hsumAVX2(s1);
+            res[2] = hsumAVX2(s2);
+            res[3] = hsumAVX2(s3);
+
+            for (; i < n; i++) {
+                res[0] += a[0][i]*x[i];
+                res[1] += a[1][i]*x[i];
+                res[2] += a[2][i]*x[i];
+                res[3] += a[3][i]*x[i];
+            }
+        }
+
+
+        __attribute__((target("avx2,fma")))
+        void axpyAVX2(double alpha, const double* x, double* y, int n)
+        {
+            __m256d a = _mm256_set1_pd(alpha);
+
+            int i = 0;
+            for (; i + 4 <= n; i += 4)
+                _mm256_storeu_pd(y + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+
+            for (; i < n; i++)
+                y[i] += alpha*x[i];
+        }
+
+
+        __attribute__((target("avx2,fma")))
+        void axpy4AVX2(const double* alpha, const double* const* x, double* y, int n)
+        {
+            __m256d a0 = _mm256_set1_pd(alpha[0]);
+            __m256d a1 = _mm256_set1_pd(alpha[1]);
+            __m256d a2 = _mm256_set1_pd(alpha[2]);
+            __m256d a3 = _mm256_set1_pd(alpha[3]);
+
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d yi = _mm256_loadu_pd(y + i);
+                yi = _mm256_fmadd_pd(a0, _mm256_loadu_pd(x[0] + i), yi);
+                yi = _mm256_fmadd_pd(a1, _mm256_loadu_pd(x[1] + i), yi);
+                yi = _mm256_fmadd_pd(a2, _mm256_loadu_pd(x[2] + i), yi);
+                yi = _mm256_fmadd_pd(a3, _mm256_loadu_pd(x[3] + i), yi);
+                _mm256_storeu_pd(y + i, yi);
+            }
+
+            for (; i < n; i++)
+                y[i] += alpha[0]*x[0][i] + alpha[1]*x[1][i] + alpha[2]*x[2][i] + alpha[3]*x[3][i];
+        }
+
+
+        const VectorPrimitives avx2Primitives = { dotAVX2, dot4AVX2, axpyAVX2, axpy4AVX2 };
+
+
+        // The AVX-512 versions handle the remainders with masked loads and stores
+        __attribute__((target("avx512f")))
+        double hsumAVX512(__m512d v)
+        {
+            alignas(64) double tmp[8];
+            _mm512_store_pd(tmp, v);
+            return ((tmp[0] + tmp[1]) + (tmp[2] + tmp[3])) + ((tmp[4] + tmp[5]) + (tmp[6] + tmp[7]));
+        }
+
+
+        __attribute__((target("avx512f")))
+        double dotAVX512(const double* a, const double* b, int n)
+        {
+            __m512d s0 = _mm512_setzero_pd();
+            __m512d s1 = _mm512_setzero_pd();
+
+            int i = 0;
+            for (; i + 16 <= n; i += 16) {
+                s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+                s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), s1);
+            }
+
+            for (; i < n; i += 8) {
+                __mmask8 mask = (__mmask8)((n - i >= 8) ? 0xFF : (1u << (n - i)) - 1);
+                s0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i), s0);
+            }
+
+            return hsumAVX512(_mm512_add_pd(s0, s1));
+        }
+
+
+        __attribute__((target("avx512f")))
+        void dot4AVX512(const double* const* a, const double* x, int n, double* res)
+        {
+            __m512d s0 = _mm512_setzero_pd();
+            __m512d s1 = _mm512_setzero_pd();
+            __m512d s2 = _mm512_setzero_pd();
+            __m512d s3 = _mm512_setzero_pd();
+
+            for (int i = 0; i < n; i += 8) {
+                __mmask8 mask = (__mmask8)((n - i >= 8) ? 0xFF : (1u << (n - i)) - 1);
+                __m512d xi = _mm512_maskz_loadu_pd(mask, x + i);
+                s0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a[0] + i), xi, s0);
+                s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a[1] + i), xi, s1);
+                s2 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a[2] + i), xi, s2);
+                s3 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a[3] + i), xi, s3);
+            }
+
+            res[0] = hsumAVX512(s0);
+            res[1] = hsumAVX512(s1);
+            res[2] = hsumAVX512(s2);
+            res[3] = hsumAVX512(s3);
+        }
+
+
+        __attribute__((target("avx512f")))
+        void axpyAVX512(double alpha, const double* x, double* y, int n)
+        {
+            __m512d a = _mm512_set1_pd(alpha);
+
+            for (int i = 0; i < n; i += 8) {
+                __mmask8 mask = (__mmask8)((n - i >= 8) ? 0xFF : (1u << (n - i)) - 1);
+                __m512d yi = _mm512_maskz_loadu_pd(mask, y + i);
+                yi = _mm512_fmadd_pd(a, _mm512_maskz_loadu_pd(mask, x + i), yi);
+                _mm512_mask_storeu_pd(y + i, mask, yi);
+            }
+        }
+
+
+        __attribute__((target("avx512f")))
+        void axpy4AVX512(const double* alpha, const double* const* x, double* y, int n)
+        {
+            __m512d a0 = _mm512_set1_pd(alpha[0]);
+            __m512d a1 = _mm512_set1_pd(alpha[1]);
+            __m512d a2 = _mm512_set1_pd(alpha[2]);
+            __m512d a3 = _mm512_set1_pd(alpha[3]);
+
+            for (int i = 0; i < n; i += 8) {
+                __mmask8 mask = (__mmask8)((n - i >= 8) ? 0xFF : (1u << (n - i)) - 1);
+                __m512d yi = _mm512_maskz_loadu_pd(mask, y + i);
+                yi = _mm512_fmadd_pd(a0, _mm512_maskz_loadu_pd(mask, x[0] + i), yi);
+                yi = _mm512_fmadd_pd(a1, _mm512_maskz_loadu_pd(mask, x[1] + i), yi);
+                yi = _mm512_fmadd_pd(a2, _mm512_maskz_loadu_pd(mask, x[2] + i), yi);
+                yi = _mm512_fmadd_pd(a3, _mm512_maskz_loadu_pd(mask, x[3] + i), yi);
+                _mm512_mask_storeu_pd(y + i, mask, yi);
+            }
+        }
+
+
+        const VectorPrimitives avx512Primitives = { dotAVX512, dot4AVX512, axpyAVX512, axpy4AVX512 };
+
+        #endif  // LCQPOW_KERNELS_X86
+
+
+        const VectorPrimitives* getPrimitives( KernelInstructionSet isa )
+        {
+            #ifdef LCQPOW_KERNELS_X86
+            if (isa == KERNELS_AVX512)
+                return &avx512Primitives;
+
+            if (isa == KERNELS_AVX2)
+                return &avx2Primitives;
+            #endif
+
+            (void)isa;
+            return &scalarPrimitives;
+        }
+
+
+        KernelInstructionSet getFastestInstructionSet( )
+        {
+            if (DenseKernels::isSupported(KERNELS_AVX512))
+                return KERNELS_AVX512;
+
+            if (DenseKernels::isSupported(KERNELS_AVX2))
+                return KERNELS_AVX2;
+
+            return KERNELS_SCALAR;
+        }
+
+
+        // The instruction set in use (determined on first use, the only state shared by all solver objects)
+        std::atomic<KernelInstructionSet>& activeInstructionSet( )
+        {
+            static std::atomic<KernelInstructionSet> isa( getFastestInstructionSet() );
+            return isa;
+        }
+
+
+        const VectorPrimitives& P( )
+        {
+            return *getPrimitives(activeInstructionSet().load(std::memory_order_relaxed));
+        }
+
+
+        /*
+         *  C[:, j0:j0+len] (+)= sum_k coef(i, k)*B[k, j0:j0+len] for all rows i, where the coefficients are
+         *  A[i*n + k] (MatrixProduct) or A[k*n + i] (TransposedMatrixProduct). The k loop is unrolled by four.
+         */
+        template <bool transposed>
+        void blockedProduct(const VectorPrimitives& prims, const double* const A, const double* const B, double* C, int nRows, int nInner, int n, int p)
+        {
+            for (int jb = 0; jb < p; jb += JB) {
+                int len = Utilities::getMin(JB, p - jb);
+
+                for (int kb = 0; kb < nInner; kb += KB) {
+                    int kEnd = Utilities::getMin(kb + KB, nInner);
+
+                    for (int i = 0; i < nRows; i++) {
+                        double* Ci = C + i*p + jb;
+
+                        int k = kb;
+                        for (; k + 4 <= kEnd; k += 4) {
+                            double coef[4];
+                            for (int r = 0; r < 4; r++)
+                                coef[r] = transposed ? A[(k + r)*n + i] : A[i*n + k + r];
+
+                            if (coef[0] == 0 && coef[1] == 0 && coef[2] == 0 && coef[3] == 0)
+                                continue;
+
+                            const double* rows[4] = { B + k*p + jb, B + (k+1)*p + jb, B + (k+2)*p + jb, B + (k+3)*p + jb };
+                            prims.axpy4(coef, rows, Ci, len);
+                        }
+
+                        for (; k < kEnd; k++) {
+                            double coef = transposed ? A[k*n + i] : A[i*n + k];
+
+                            if (coef != 0)
+                                prims.axpy(coef, B + k*p + jb, Ci, len);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+
+    double DenseKernels::DotProduct(const double* const a, const double* const b, int n)
+    {
+        return P().dot(a, b, n);
+    }
+
+
+    void DenseKernels::MatrixVectorProduct(double alpha, const double* const A, const double* const x, const double* const c, double* y, int m, int n)
+    {
+        #ifdef LCQPOW_USE_BLAS
+        if (m > 0 && n > 0) {
+            // Row major A is the column major A' (n x m)
+            int inc = 1;
+            double beta = Utilities::isNotNullPtr(c) ? 1 : 0;
+
+            if (Utilities::isNotNullPtr(c) && c != y)
+                memcpy(y, c, (size_t)m*sizeof(double));
+
+            dgemv_("T", &n, &m, &alpha, A, &n, x, &inc, &beta, y, &inc);
+            return;
+        }
+        #endif
+
+        const VectorPrimitives& prims = P();
+
+        // Four rows share the loads of x
+        int i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const double* rows[4] = { A + i*n, A + (i+1)*n, A + (i+2)*n, A + (i+3)*n };
+            double res[4];
+            prims.dot4(rows, x, n, res);
+
+            for (int r = 0; r < 4; r++)
+                y[i + r] = alpha*res[r] + (Utilities::isNotNullPtr(c) ? c[i + r] : 0);
+        }
+
+        for (; i < m; i++)
+            y[i] = alpha*prims.dot(A + i*n, x, n) + (Utilities::isNotNullPtr(c) ? c[i] : 0);
+    }
+
+
+    void DenseKernels::AddTransposedMatrixVectorProduct(double alpha, const double* const A, const double* const x, double* y, int m, int n)
+    {
+        #ifdef LCQPOW_USE_BLAS
+        if (m > 0 && n > 0) {
+            int inc = 1;
+            double beta = 1;
+            dgemv_("N", &n, &m, &alpha, A, &n, x, &inc, &beta, y, &inc);
+            return;
+        }
+        #endif
+
+        const VectorPrimitives& prims = P();
+
+        // Rows with a zero coefficient are skipped (e.g. inactive constraints), the others are combined four at a time
+        for (int jb = 0; jb < n; jb += JB*4) {
+            int len = Utilities::getMin(JB*4, n - jb);
+
+            double coef[4];
+            const double* rows[4];
+            int nCollected = 0;
+
+            for (int k = 0; k < m; k++) {
+                if (x[k] == 0)
+                    continue;
+
+                coef[nCollected] = alpha*x[k];
+                rows[nCollected] = A + k*n + jb;
+                nCollected++;
+
+                if (nCollected == 4) {
+                    prims.axpy4(coef, rows, y + jb, len);
+                    nCollected = 0;
+                }
+            }
+
+            for (int r = 0; r < nCollected; r++)
+                prims.axpy(coef[r], rows[r], y + jb, len);
+        }
+    }
+
+
+    void DenseKernels::MatrixProduct(const double* const A, const double* const B, double* C, int m, int n, int p)
+    {
+        if (p == 1) {
+            MatrixVectorProduct(1, A, B, 0, C, m, n);
+            return;
+        }
+
+        #ifdef LCQPOW_USE_BLAS
+        if (m > 0 && n > 0) {
+            // Column major: C' = B'*A'
+            double one = 1, zero = 0;
+            dgemm_("N", "N", &p, &m, &n, &one, B, &p, A, &n, &zero, C, &p);
+            return;
+        }
+        #endif
+
+        memset(C, 0, (size_t)(m*p)*sizeof(double));
+        blockedProduct<false>(P(), A, B, C, m, n, n, p);
+    }
+
+
+    void DenseKernels::TransposedMatrixProduct(const double* const A, const double* const B, double* C, int m, int n, int p, bool accumulate)
+    {
+        if (!accumulate)
+            memset(C, 0, (size_t)(n*p)*sizeof(double));
+
+        if (p == 1) {
+            AddTransposedMatrixVectorProduct(1, A, B, C, m, n);
+            return;
+        }
+
+        #ifdef LCQPOW_USE_BLAS
+        if (m > 0 && n > 0) {
+            // Column major: C' (+)= B'*A (C has been cleared above)
+            double one = 1;
+            dgemm_("N", "T", &p, &n, &m, &one, B, &p, A, &n, &one, C, &p);
+            return;
+        }
+        #endif
+
+        blockedProduct<true>(P(), A, B, C, n, m, n, p);
+    }
+
+
+    void DenseKernels::SymmetrizationProduct(const double* const A, const double* const B, double* C, int m, int n)
+    {
+        #ifdef LCQPOW_USE_BLAS
+        if (m > 0 && n > 0) {
+            // Row major A and B are the column major A' and B' (n x m), the lower triangle (column major) is the upper one (row major)
+            double one = 1, zero = 0;
+            dsyr2k_("L", "N", &n, &m, &one, A, &n, B, &n, &zero, C, &n);
+
+            for (int i = 0; i < n; i++)
+                for (int j = i + 1; j < n; j++)
+                    C[j*n + i] = C[i*n + j];
+
+            return;
+        }
+        #endif
+
+        const VectorPrimitives& prims = P();
+
+        memset(C, 0, (size_t)(n*n)*sizeof(double));
+
+        // Lower triangle, tile by tile: C[i, j] += A[k, i]*B[k, j] + B[k, i]*A[k, j]
+        for (int ib = 0; ib < n; ib += IB) {
+            int iEnd = Utilities::getMin(ib + IB, n);
+
+            for (int jb = 0; jb < iEnd; jb += JB) {
+                int jEnd = Utilities::getMin(jb + JB, n);
+
+                // Two rows of A and B at a time
+                int k = 0;
+                for (; k + 2 <= m; k += 2) {
+                    const double* Ak0 = A + k*n;
+                    const double* Bk0 = B + k*n;
+                    const double* Ak1 = A + (k+1)*n;
+                    const double* Bk1 = B + (k+1)*n;
+                    const double* rows[4] = { Bk0 + jb, Ak0 + jb, Bk1 + jb, Ak1 + jb };
+
+                    for (int i = ib; i < iEnd; i++) {
+                        int len = Utilities::getMin(jEnd, i + 1) - jb;
+                        double coef[4] = { Ak0[i], Bk0[i], Ak1[i], Bk1[i] };
+
+                        if (len <= 0 || (coef[0] == 0 && coef[1] == 0 && coef[2] == 0 && coef[3] == 0))
+                            continue;
+
+                        prims.axpy4(coef, rows, C + i*n + jb, len);
+                    }
+                }
+
+                for (; k < m; k++) {
+                    const double* Ak = A + k*n;
+                    const double* Bk = B + k*n;
+
+                    for (int i = ib; i < iEnd; i++) {
+                        int len = Utilities::getMin(jEnd, i + 1) - jb;
+
+                        if (len <= 0)
+                            continue;
+
+                        if (Ak[i] != 0)
+                            prims.axpy(Ak[i], Bk + jb, C + i*n + jb, len);
+
+                        if (Bk[i] != 0)
+                            prims.axpy(Bk[i], Ak + jb, C + i*n + jb, len);
+                    }
+                }
+            }
+        }
+
+        // Make symmetric
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < i; j++)
+                C[j*n + i] = C[i*n + j];
+    }
+
+
+    double DenseKernels::QuadraticFormProduct(const double* const Q, const double* const p, int n, double* Qp)
+    {
+        #ifdef LCQPOW_USE_BLAS
+        if (n > 0 && Qp != 0) {
+            // Q*p (Q is symmetric)
+            int inc = 1;
+            double one = 1, zero = 0;
+            dsymv_("L", &n, &one, Q, &n, p, &inc, &zero, Qp, &inc);
+
+            return P().dot(Qp, p, n);
+        }
+        #else
+        (void)Qp;
+        #endif
+
+        const VectorPrimitives& prims = P();
+
+        double ret = 0;
+
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const double* rows[4] = { Q + i*n, Q + (i+1)*n, Q + (i+2)*n, Q + (i+3)*n };
+            double res[4];
+            prims.dot4(rows, p, n, res);
+
+            ret += res[0]*p[i] + res[1]*p[i+1] + res[2]*p[i+2] + res[3]*p[i+3];
+        }
+
+        for (; i < n; i++)
+            ret += prims.dot(Q + i*n, p, n)*p[i];
+
+        return ret;
+    }
+
+
+    bool DenseKernels::usesBLAS( )
+    {
+        #ifdef LCQPOW_USE_BLAS
+        return true;
+        #else
+        return false;
+        #endif
+    }
+
+
+    KernelInstructionSet DenseKernels::getInstructionSet( )
+    {
+        return activeInstructionSet().load(std::memory_order_relaxed);
+    }
+
+
+    bool DenseKernels::isSupported( KernelInstructionSet isa )
+    {
+        if (isa == KERNELS_SCALAR)
+            return true;
+
+        #ifdef LCQPOW_KERNELS_X86
+        __builtin_cpu_init();
+
+        if (isa == KERNELS_AVX2)
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+        if (isa == KERNELS_AVX512)
+            return __builtin_cpu_supports("avx512f");
+        #endif
+
+        return false;
+    }
+
+
+    ReturnValue DenseKernels::setInstructionSet( KernelInstructionSet isa )
+    {
+        if (!isSupported(isa))
+            return INVALID_ARGUMENT;
+
+        activeInstructionSet().store(isa, std::memory_order_relaxed);
+
+        return SUCCESSFUL_RETURN;
+    }
+}
@@ -0,0 +1,230 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "LCQBatchSolver.hpp"
+#include "MessageHandler.hpp"
+
+#include <thread>
+
+namespace LCQPow {
+
+
+    LCQBatchSolver::LCQBatchSolver( ) { }
+
+
+    LCQBatchSolver::LCQBatchSolver( const LCQProblem& _lcqp, int _nThreads, bool _hotstart ) : lcqp( _lcqp )
+    {
+        nThreads = _nThreads;
+        hotstart = _hotstart;
+
+        if (nThreads <= 0)
+            nThreads = (int) std::thread::hardware_concurrency();
+
+        if (nThreads <= 0)
+            nThreads = 1;
+
+        nDualsMax = lcqp.nV + lcqp.nC + 2*lcqp.nComp;
+
+        if (lcqp.options.getQPSolver() == QPSolver::OSQP_SPARSE)
+            nDuals = lcqp.nC + 2*lcqp.nComp;
+        else
+            nDuals = nDualsMax;
+    }
+
+
+    ReturnValue LCQBatchSolver::solve(  int _nInstances,
+                                        const double* const _g,
+                                        const double* const _lbA, const double* const _ubA,
+                                        const double* const _lb, const double* const _ub,
+                                        const double* const _x0, const double* const _y0 )
+    {
+        if (_nInstances < 0)
+            return MessageHandler::PrintMessage( INVALID_ARGUMENT, ERROR );
+
+        if (lcqp.nV <= 0 || lcqp.nComp <= 0)
+            return MessageHandler::PrintMessage( LCQPOBJECT_NOT_SETUP, ERROR );
+
+        nInstances = _nInstances;
+        g = _g;
+        lbA = _lbA;
+        ubA = _ubA;
+        lb = _lb;
+        ub = _ub;
+        x0 = _x0;
+        y0 = _y0;
+
+        xOpt.assign((size_t)nInstances*(size_t)lcqp.nV, 0.0);
+        yOpt.assign((size_t)nInstances*(size_t)nDualsMax, 0.0);
+        retVals.assign((size_t)nInstances, NOT_YET_IMPLEMENTED);
+        algoStats.assign((size_t)nInstances, PROBLEM_NOT_SOLVED);
+        stats.assign((size_t)nInstances, OutputStatistics());
+
+        // Snapshot of the template for a replay (the workers do not dump, they would overwrite each other's file)
+        if (Utilities::isNotNullPtr(lcqp.options.getDumpFile())) {
+            ReturnValue dumpRet = lcqp.dumpProblem( lcqp.options.getDumpFile() );
+
+            if (dumpRet != SUCCESSFUL_RETURN)
+                MessageHandler::PrintMessage( dumpRet, WARNING );
+        }
+
+        // Cold started instances are handed out dynamically (their solve times can differ a lot),
+        // hotstarted ones in fixed ranges (the result of an instance depends on the one solved before)
+        std::atomic<int> next( 0 );
+        std::atomic<int>* shared = hotstart ? NULL : &next;
+        int nWorkers = Utilities::getMin(nThreads, nInstances);
+
+        // Messages of the workers go to the sink of the calling thread
+        MessageSink sink = NULL;
+        void* sinkData = NULL;
+        MessageHandler::GetMessageSink( &sink, &sinkData );
+
+        if (nWorkers <= 1) {
+            runWorker( shared, 0, nInstances, sink, sinkData );
+        } else {
+            std::vector<std::thread> workers;
+
+            for (int t = 0; t < nWorkers; t++) {
+                int begin = hotstart ? (int)((long long)t*nInstances/nWorkers) : 0;
+                int end = hotstart ? (int)((long long)(t + 1)*nInstances/nWorkers) : nInstances;
+
+                workers.push_back( std::thread(&LCQBatchSolver::runWorker, this, shared, begin, end, sink, sinkData) );
+            }
+
+            for (size_t t = 0; t < workers.size(); t++)
+                workers[t].join();
+        }
+
+        // Do not keep pointers to user data
+        g = lbA = ubA = lb = ub = x0 = y0 = NULL;
+
+        for (int i = 0; i < nInstances; i++) {
+            if (retVals[(size_t)i] != SUCCESSFUL_RETURN)
+                return retVals[(size_t)i];
+        }
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    void LCQBatchSolver::runWorker( std::atomic<int>* next, int begin, int end, MessageSink sink, void* sinkData )
+    {
+        MessageHandler::SetMessageSink( sink, sinkData );
+
+        // Each worker solves on its own copy of the template (the copy has no subsolver yet), the matrices are shared
+        LCQProblem worker( lcqp, true );
+        worker.options.setDumpFile( NULL );
+
+        // The workers would interleave their iterates in one step file, keep them in the statistics of the instances instead
+        worker.options.setStepFile( NULL );
+
+        int nV = lcqp.nV;
+        int nC = lcqp.nC;
+
+        for (int i = Utilities::isNotNullPtr(next) ? (*next)++ : begin; i < end; i = Utilities::isNotNullPtr(next) ? (*next)++ : i + 1) {
+            size_t k = (size_t)i;
+
+            // Fall back to the data of the template
+            const double* g_i = Utilities::isNotNullPtr(g) ? g + k*(size_t)nV : lcqp.g;
+            const double* lbA_i = Utilities::isNotNullPtr(lbA) ? lbA + k*(size_t)nC : lcqp.lbA;
+            const double* ubA_i = Utilities::isNotNullPtr(ubA) ? ubA + k*(size_t)nC : lcqp.ubA;
+            const double* lb_i = Utilities::isNotNullPtr(lb) ? lb + k*(size_t)nV : lcqp.lb_tmp;
+            const double* ub_i = Utilities::isNotNullPtr(ub) ? ub + k*(size_t)nV : lcqp.ub_tmp;
+            const double* x0_i = Utilities::isNotNullPtr(x0) ? x0 + k*(size_t)nV : lcqp.x0;
+            const double* y0_i = Utilities::isNotNullPtr(y0) ? y0 + k*(size_t)nDualsMax : lcqp.y0;
+
+            ReturnValue ret = worker.setInstanceData( g_i, lbA_i, ubA_i, lb_i, ub_i, x0_i, y0_i );
+
+            // When hotstarting, only the first instance of the worker sets up its subsolver, the following ones only change g and the bounds
+            if (ret == SUCCESSFUL_RETURN)
+                ret = hotstart ? worker.runHotstartedSolver( ) : worker.runSolver( );
+
+            retVals[k] = ret;
+            algoStats[k] = worker.getPrimalSolution( &xOpt[k*(size_t)nV] );
+            worker.getDualSolution( &yOpt[k*(size_t)nDualsMax] );
+            worker.getOutputStatistics( stats[k] );
+        }
+    }
+
+
+    int LCQBatchSolver::getNumberOfInstances( ) const
+    {
+        return nInstances;
+    }
+
+
+    int LCQBatchSolver::getNumberOfPrimals( ) const
+    {
+        return lcqp.nV;
+    }
+
+
+    int LCQBatchSolver::getNumberOfDuals( ) const
+    {
+        return nDuals;
+    }
+
+
+    ReturnValue LCQBatchSolver::getReturnValue( int instance ) const
+    {
+        if (instance < 0 || instance >= nInstances)
+            return INDEX_OUT_OF_BOUNDS;
+
+        return retVals[(size_t)instance];
+    }
+
+
+    AlgorithmStatus LCQBatchSolver::getPrimalSolution( int instance, double* const _xOpt ) const
+    {
+        if (instance < 0 || instance >= nInstances)
+            return PROBLEM_NOT_SOLVED;
+
+        if (Utilities::isNotNullPtr(_xOpt)) {
+            for (int i = 0; i < lcqp.nV; i++)
+                _xOpt[i] = xOpt[(size_t)instance*(size_t)lcqp.nV + (size_t)i];
+        }
+
+        return algoStats[(size_t)instance];
+    }
+
+
+    AlgorithmStatus LCQBatchSolver::getDualSolution( int instance, double* const _yOpt ) const
+    {
+        if (instance < 0 || instance >= nInstances)
+            return PROBLEM_NOT_SOLVED;
+
+        if (Utilities::isNotNullPtr(_yOpt)) {
+            for (int i = 0; i < nDuals; i++)
+                _yOpt[i] = yOpt[(size_t)instance*(size_t)nDualsMax + (size_t)i];
+        }
+
+        return algoStats[(size_t)instance];
+    }
+
+
+    void LCQBatchSolver::getOutputStatistics( int instance, OutputStatistics& _stats ) const
+    {
+        if (instance < 0 || instance >= nInstances)
+            return;
+
+        _stats = stats[(size_t)instance];
+    }
+}
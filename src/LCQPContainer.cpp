@@ -0,0 +1,582 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#include "LCQPContainer.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LCQPow {
+
+    namespace {
+
+        const char CONTAINER_MAGIC[8] = { 'L', 'C', 'Q', 'P', 'O', 'W', '\r', '\n' };
+        const uint32_t CONTAINER_VERSION = 2;
+        const uint32_t CONTAINER_BYTE_ORDER = 0x01020304;
+        const uint32_t CONTAINER_SPARSE = 1;
+        const uint64_t CONTAINER_ALIGNMENT = 64;
+
+
+        // The first 64 bytes of a container
+        struct ContainerHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;
+            int32_t nV;
+            int32_t nC;
+            int32_t nComp;
+            uint32_t flags;
+            uint64_t fileSize;
+            char reserved[24];
+        };
+
+
+        // Position of a section (offset 0 if absent)
+        struct SectionEntry {
+            uint64_t offset;
+            uint64_t count;
+        };
+
+
+        // Data of a section to be written
+        struct SectionData {
+            const void* data;
+            uint64_t count;
+        };
+
+
+        // Values sections of Q, L, R and A, followed by their column pointers and row indices
+        const int MATRIX_SECTIONS[4] = { SECTION_Q, SECTION_L, SECTION_R, SECTION_A };
+
+        // Number of entries of SECTION_OPTIONS
+        const int NUMBER_OF_OPTIONS = 14;
+
+
+        static_assert(sizeof(ContainerHeader) == 64, "The container header must fill one alignment unit.");
+        static_assert(sizeof(int) == 4, "Container indices are 32 bit integers.");
+
+
+        uint64_t alignUp( uint64_t n )
+        {
+            return (n + CONTAINER_ALIGNMENT - 1)/CONTAINER_ALIGNMENT*CONTAINER_ALIGNMENT;
+        }
+
+
+        // Column pointers and row indices are ints, QP solver settings raw bytes, everything else doubles
+        uint64_t entrySize( int section )
+        {
+            if (section == SECTION_QPOASES_OPTIONS || section == SECTION_OSQP_OPTIONS)
+                return 1;
+
+            for (int k = 0; k < 4; k++)
+                if (section == MATRIX_SECTIONS[k] + 1 || section == MATRIX_SECTIONS[k] + 2)
+                    return sizeof(int);
+
+            return sizeof(double);
+        }
+
+
+        uint64_t tableEnd( )
+        {
+            return alignUp(sizeof(ContainerHeader) + NUMBER_OF_SECTIONS*sizeof(SectionEntry));
+        }
+
+
+        // Options in the order of SECTION_OPTIONS (copied, the getters are not const)
+        void getOptionValues( Options options, double* values )
+        {
+            values[0] = options.getStationarityTolerance();
+            values[1] = options.getComplementarityTolerance();
+            values[2] = options.getInitialPenaltyParameter();
+            values[3] = options.getPenaltyUpdateFactor();
+            values[4] = options.getSolveZeroPenaltyFirst();
+            values[5] = options.getPerturbStep();
+            values[6] = options.getRandomSeed();
+            values[7] = options.getMaxIterations();
+            values[8] = options.getMaxPenaltyParameter();
+            values[9] = options.getNDynamicPenalty();
+            values[10] = options.getEtaDynamicPenalty();
+            values[11] = options.getPrintLevel();
+            values[12] = options.getStoreSteps();
+            values[13] = options.getQPSolver();
+        }
+
+
+        void setOptionValues( const double* values, Options& options )
+        {
+            options.setStationarityTolerance( values[0] );
+            options.setComplementarityTolerance( values[1] );
+            options.setInitialPenaltyParameter( values[2] );
+            options.setPenaltyUpdateFactor( values[3] );
+            options.setSolveZeroPenaltyFirst( values[4] != 0 );
+            options.setPerturbStep( values[5] != 0 );
+            options.setRandomSeed( (unsigned int)values[6] );
+            options.setMaxIterations( (int)values[7] );
+            options.setMaxPenaltyParameter( values[8] );
+            options.setNDynamicPenalty( (int)values[9] );
+            options.setEtaDynamicPenalty( values[10] );
+            options.setPrintLevel( (int)values[11] );
+            options.setStoreSteps( values[12] != 0 );
+            options.setQPSolver( (int)values[13] );
+        }
+
+
+        ReturnValue writeContainer( const char* filename, int nV, int nC, int nComp, bool sparse, SectionData* sections, const Options* const options )
+        {
+            // The sections of the options reference these copies
+            Options settings;
+            double optionValues[NUMBER_OF_OPTIONS];
+
+            if (Utilities::isNotNullPtr(options)) {
+                settings = *options;
+                getOptionValues( settings, optionValues );
+
+                sections[SECTION_OPTIONS] = { optionValues, NUMBER_OF_OPTIONS };
+                sections[SECTION_QPOASES_OPTIONS] = { &settings.getqpOASESOptions(), sizeof(qpOASES::Options) };
+
+                if (Utilities::isNotNullPtr(settings.getOSQPOptions()))
+                    sections[SECTION_OSQP_OPTIONS] = { settings.getOSQPOptions(), sizeof(OSQPSettings) };
+            }
+
+            ContainerHeader header;
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC));
+            header.version = CONTAINER_VERSION;
+            header.byteOrder = CONTAINER_BYTE_ORDER;
+            header.nV = nV;
+            header.nC = nC;
+            header.nComp = nComp;
+            header.flags = sparse ? CONTAINER_SPARSE : 0;
+
+            // Layout
+            SectionEntry table[NUMBER_OF_SECTIONS];
+            uint64_t offset = tableEnd();
+
+            for (int k = 0; k < NUMBER_OF_SECTIONS; k++) {
+                table[k].offset = 0;
+                table[k].count = 0;
+
+                if (Utilities::isNullPtr(sections[k].data) || sections[k].count == 0)
+                    continue;
+
+                table[k].offset = offset;
+                table[k].count = sections[k].count;
+                offset = alignUp(offset + sections[k].count*entrySize(k));
+            }
+
+            header.fileSize = offset;
+
+            FILE* file = fopen( filename, "wb" );
+
+            if (file == 0)
+                return UNABLE_TO_WRITE_FILE;
+
+            static const char zeros[CONTAINER_ALIGNMENT] = { 0 };
+            bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(table, sizeof(table), 1, file) == 1;
+            uint64_t position = sizeof(header) + sizeof(table);
+
+            for (int k = 0; k < NUMBER_OF_SECTIONS && written; k++) {
+                if (table[k].offset == 0)
+                    continue;
+
+                written = fwrite(zeros, 1, (size_t)(table[k].offset - position), file) == (size_t)(table[k].offset - position);
+                written = written && fwrite(sections[k].data, (size_t)entrySize(k), (size_t)table[k].count, file) == (size_t)table[k].count;
+                position = table[k].offset + table[k].count*entrySize(k);
+            }
+
+            written = written && fwrite(zeros, 1, (size_t)(header.fileSize - position), file) == (size_t)(header.fileSize - position);
+            written = (fclose(file) == 0) && written;
+
+            return written ? SUCCESSFUL_RETURN : UNABLE_TO_WRITE_FILE;
+        }
+
+
+        // Whether the csc sections of a matrix with m rows are consistent
+        bool isValidCSC( const int* p, const int* i, uint64_t nP, uint64_t nI, uint64_t nX, int m, int n )
+        {
+            if (Utilities::isNullPtr(p) || nP != (uint64_t)n + 1 || p[0] != 0)
+                return false;
+
+            for (int j = 0; j < n; j++)
+                if (p[j + 1] < p[j])
+                    return false;
+
+            uint64_t nnz = (uint64_t)p[n];
+            if (nI != nnz || nX != nnz)
+                return false;
+
+            for (uint64_t k = 0; k < nnz; k++)
+                if (i[k] < 0 || i[k] >= m)
+                    return false;
+
+            return true;
+        }
+    }
+
+
+    LCQPContainer::LCQPContainer( ) { }
+
+
+    LCQPContainer::~LCQPContainer( )
+    {
+        close( );
+    }
+
+
+    ReturnValue LCQPContainer::open( const char* filename )
+    {
+        close( );
+
+        int fd = ::open( filename, O_RDONLY );
+
+        if (fd < 0)
+            return UNABLE_TO_READ_FILE;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t)tableEnd()) {
+            ::close( fd );
+            return UNABLE_TO_READ_FILE;
+        }
+
+        void* data = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+
+        if (data == MAP_FAILED)
+            return UNABLE_TO_READ_FILE;
+
+        mapping = data;
+        mappingSize = (size_t)info.st_size;
+
+        if (!validate()) {
+            close( );
+            return UNABLE_TO_READ_FILE;
+        }
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    void LCQPContainer::close( )
+    {
+        if (Utilities::isNotNullPtr(mapping))
+            munmap( mapping, mappingSize );
+
+        mapping = NULL;
+        mappingSize = 0;
+        nV = 0;
+        nC = 0;
+        nComp = 0;
+        sparse = false;
+    }
+
+
+    bool LCQPContainer::isOpen( ) const
+    {
+        return Utilities::isNotNullPtr(mapping);
+    }
+
+
+    bool LCQPContainer::isSparse( ) const
+    {
+        return sparse;
+    }
+
+
+    int LCQPContainer::getNV( ) const
+    {
+        return nV;
+    }
+
+
+    int LCQPContainer::getNC( ) const
+    {
+        return nC;
+    }
+
+
+    int LCQPContainer::getNComp( ) const
+    {
+        return nComp;
+    }
+
+
+    const void* LCQPContainer::getSection( ContainerSection section, size_t* count ) const
+    {
+        if (count != 0)
+            *count = 0;
+
+        if (!isOpen() || section < 0 || section >= NUMBER_OF_SECTIONS)
+            return NULL;
+
+        const SectionEntry* table = (const SectionEntry*)((const char*)mapping + sizeof(ContainerHeader));
+
+        if (table[section].offset == 0)
+            return NULL;
+
+        if (count != 0)
+            *count = (size_t)table[section].count;
+
+        return (const char*)mapping + table[section].offset;
+    }
+
+
+    ReturnValue LCQPContainer::load( LCQProblem& lcqp ) const
+    {
+        if (!isOpen())
+            return LCQPOBJECT_NOT_SETUP;
+
+        if (lcqp.getNumberOfPrimals() != nV)
+            return INVALID_ARGUMENT;
+
+        if (sparse) {
+            return lcqp.loadLCQPBorrowed(
+                &matrices[0], getDoubles(SECTION_G), &matrices[1], &matrices[2],
+                getDoubles(SECTION_LBL), getDoubles(SECTION_UBL), getDoubles(SECTION_LBR), getDoubles(SECTION_UBR),
+                nC > 0 ? &matrices[3] : 0, getDoubles(SECTION_LBA), getDoubles(SECTION_UBA),
+                getDoubles(SECTION_LB), getDoubles(SECTION_UB), getDoubles(SECTION_X0), getDoubles(SECTION_Y0)
+            );
+        }
+
+        return lcqp.loadLCQPBorrowed(
+            getDoubles(SECTION_Q), getDoubles(SECTION_G), getDoubles(SECTION_L), getDoubles(SECTION_R),
+            getDoubles(SECTION_LBL), getDoubles(SECTION_UBL), getDoubles(SECTION_LBR), getDoubles(SECTION_UBR),
+            getDoubles(SECTION_A), getDoubles(SECTION_LBA), getDoubles(SECTION_UBA),
+            getDoubles(SECTION_LB), getDoubles(SECTION_UB), getDoubles(SECTION_X0), getDoubles(SECTION_Y0)
+        );
+    }
+
+
+    ReturnValue LCQPContainer::getOptions( Options& options ) const
+    {
+        if (!isOpen())
+            return LCQPOBJECT_NOT_SETUP;
+
+        if (Utilities::isNullPtr(getDoubles( SECTION_OPTIONS )))
+            return INVALID_ARGUMENT;
+
+        setOptionValues( getDoubles( SECTION_OPTIONS ), options );
+
+        size_t size = 0;
+        const void* qpOASESOptions = getSection( SECTION_QPOASES_OPTIONS, &size );
+
+        if (Utilities::isNotNullPtr(qpOASESOptions) && size == sizeof(qpOASES::Options)) {
+            qpOASES::Options settings;
+            memcpy((void*)&settings, qpOASESOptions, sizeof(settings));
+            options.setqpOASESOptions( settings );
+        }
+
+        const void* osqpOptions = getSection( SECTION_OSQP_OPTIONS, &size );
+
+        if (Utilities::isNotNullPtr(osqpOptions) && size == sizeof(OSQPSettings)) {
+            OSQPSettings settings;
+            memcpy(&settings, osqpOptions, sizeof(settings));
+            options.setOSQPOptions( &settings );
+        }
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue LCQPContainer::write(   const char* filename, int _nV, int _nC, int _nComp,
+                                        const double* const Q, const double* const g,
+                                        const double* const L, const double* const R,
+                                        const double* const lbL, const double* const ubL,
+                                        const double* const lbR, const double* const ubR,
+                                        const double* const A, const double* const lbA, const double* const ubA,
+                                        const double* const lb, const double* const ub,
+                                        const double* const x0, const double* const y0,
+                                        const Options* const options )
+    {
+        if (_nV <= 0 || _nC < 0 || _nComp <= 0 || Utilities::isNullPtr(Q) || Utilities::isNullPtr(g) ||
+            Utilities::isNullPtr(L) || Utilities::isNullPtr(R) || (_nC > 0 && Utilities::isNullPtr(A)))
+            return INVALID_ARGUMENT;
+
+        uint64_t n = (uint64_t)_nV, m = (uint64_t)_nC, p = (uint64_t)_nComp;
+
+        SectionData sections[NUMBER_OF_SECTIONS];
+        memset(sections, 0, sizeof(sections));
+
+        sections[SECTION_Q] = { Q, n*n };
+        sections[SECTION_G] = { g, n };
+        sections[SECTION_L] = { L, p*n };
+        sections[SECTION_R] = { R, p*n };
+        sections[SECTION_A] = { A, m*n };
+        sections[SECTION_LBL] = { lbL, p };
+        sections[SECTION_UBL] = { ubL, p };
+        sections[SECTION_LBR] = { lbR, p };
+        sections[SECTION_UBR] = { ubR, p };
+        sections[SECTION_LBA] = { lbA, m };
+        sections[SECTION_UBA] = { ubA, m };
+        sections[SECTION_LB] = { lb, n };
+        sections[SECTION_UB] = { ub, n };
+        sections[SECTION_X0] = { x0, n };
+        sections[SECTION_Y0] = { y0, n + m + 2*p };
+
+        return writeContainer( filename, _nV, _nC, _nComp, false, sections, options );
+    }
+
+
+    ReturnValue LCQPContainer::write(   const char* filename, int _nV, int _nC, int _nComp,
+                                        const csc* const Q, const double* const g,
+                                        const csc* const L, const csc* const R,
+                                        const double* const lbL, const double* const ubL,
+                                        const double* const lbR, const double* const ubR,
+                                        const csc* const A, const double* const lbA, const double* const ubA,
+                                        const double* const lb, const double* const ub,
+                                        const double* const x0, const double* const y0,
+                                        const Options* const options )
+    {
+        if (_nV <= 0 || _nC < 0 || _nComp <= 0 || Utilities::isNullPtr(g))
+            return INVALID_ARGUMENT;
+
+        const csc* M[4] = { Q, L, R, _nC > 0 ? A : 0 };
+        const int rows[4] = { _nV, _nComp, _nComp, _nC };
+
+        uint64_t n = (uint64_t)_nV, m = (uint64_t)_nC, p = (uint64_t)_nComp;
+
+        SectionData sections[NUMBER_OF_SECTIONS];
+        memset(sections, 0, sizeof(sections));
+
+        for (int k = 0; k < 4; k++) {
+            if (k == 3 && _nC == 0)
+                continue;
+
+            if (Utilities::isNullPtr(M[k]) || M[k]->m != rows[k] || M[k]->n != _nV || Utilities::isNullPtr(M[k]->p))
+                return INVALID_ARGUMENT;
+
+            uint64_t nnz = (uint64_t)M[k]->p[_nV];
+            sections[MATRIX_SECTIONS[k]] = { M[k]->x, nnz };
+            sections[MATRIX_SECTIONS[k] + 1] = { M[k]->p, n + 1 };
+            sections[MATRIX_SECTIONS[k] + 2] = { M[k]->i, nnz };
+        }
+
+        sections[SECTION_G] = { g, n };
+        sections[SECTION_LBL] = { lbL, p };
+        sections[SECTION_UBL] = { ubL, p };
+        sections[SECTION_LBR] = { lbR, p };
+        sections[SECTION_UBR] = { ubR, p };
+        sections[SECTION_LBA] = { lbA, m };
+        sections[SECTION_UBA] = { ubA, m };
+        sections[SECTION_LB] = { lb, n };
+        sections[SECTION_UB] = { ub, n };
+        sections[SECTION_X0] = { x0, n };
+        sections[SECTION_Y0] = { y0, n + m + 2*p };
+
+        return writeContainer( filename, _nV, _nC, _nComp, true, sections, options );
+    }
+
+
+    bool LCQPContainer::validate( )
+    {
+        const ContainerHeader* header = (const ContainerHeader*)mapping;
+        const SectionEntry* table = (const SectionEntry*)((const char*)mapping + sizeof(ContainerHeader));
+
+        if (memcmp(header->magic, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC)) != 0 || header->version != CONTAINER_VERSION ||
+            header->byteOrder != CONTAINER_BYTE_ORDER || header->fileSize != (uint64_t)mappingSize || (header->flags & ~CONTAINER_SPARSE) != 0)
+            return false;
+
+        if (header->nV <= 0 || header->nC < 0 || header->nComp <= 0)
+            return false;
+
+        nV = header->nV;
+        nC = header->nC;
+        nComp = header->nComp;
+        sparse = (header->flags & CONTAINER_SPARSE) != 0;
+
+        // All sections lie aligned within the file
+        for (int k = 0; k < NUMBER_OF_SECTIONS; k++) {
+            if (table[k].offset == 0)
+                continue;
+
+            if (table[k].offset % CONTAINER_ALIGNMENT != 0 || table[k].offset < tableEnd() || table[k].offset > (uint64_t)mappingSize ||
+                table[k].count > ((uint64_t)mappingSize - table[k].offset)/entrySize(k))
+                return false;
+        }
+
+        // Vectors have their dimension (or are absent)
+        uint64_t n = (uint64_t)nV, m = (uint64_t)nC, p = (uint64_t)nComp;
+        const uint64_t lengths[SECTION_Y0 - SECTION_LBL + 1] = { p, p, p, p, m, m, n, n, n, n + m + 2*p };
+
+        if (table[SECTION_G].offset == 0 || table[SECTION_G].count != n)
+            return false;
+
+        for (int k = SECTION_LBL; k <= SECTION_Y0; k++)
+            if (table[k].offset != 0 && table[k].count != lengths[k - SECTION_LBL])
+                return false;
+
+        if (table[SECTION_OPTIONS].offset != 0 && table[SECTION_OPTIONS].count != (uint64_t)NUMBER_OF_OPTIONS)
+            return false;
+
+        // Matrices
+        const uint64_t rows[4] = { n, p, p, m };
+
+        for (int k = 0; k < 4; k++) {
+            const SectionEntry* values = &table[MATRIX_SECTIONS[k]];
+            const SectionEntry* pointers = &table[MATRIX_SECTIONS[k] + 1];
+            const SectionEntry* indices = &table[MATRIX_SECTIONS[k] + 2];
+
+            if (k == 3 && nC == 0) {
+                if (values->offset != 0 || pointers->offset != 0 || indices->offset != 0)
+                    return false;
+
+                continue;
+            }
+
+            if (!sparse) {
+                if (values->offset == 0 || values->count != rows[k]*n || pointers->offset != 0 || indices->offset != 0)
+                    return false;
+
+                continue;
+            }
+
+            const int* p_k = (const int*)getSection( (ContainerSection)(MATRIX_SECTIONS[k] + 1) );
+            const int* i_k = (const int*)getSection( (ContainerSection)(MATRIX_SECTIONS[k] + 2) );
+
+            if (!isValidCSC(p_k, i_k, pointers->count, indices->count, values->count, (int)rows[k], nV))
+                return false;
+
+            // The QP solvers do not write to the matrices, the csc headers only need mutable pointers
+            matrices[k].m = (int)rows[k];
+            matrices[k].n = nV;
+            matrices[k].nzmax = p_k[nV];
+            matrices[k].nz = -1;
+            matrices[k].p = const_cast<int*>(p_k);
+            matrices[k].i = const_cast<int*>(i_k);
+            matrices[k].x = const_cast<double*>(getDoubles( (ContainerSection)MATRIX_SECTIONS[k] ));
+        }
+
+        return true;
+    }
+
+
+    const double* LCQPContainer::getDoubles( ContainerSection section ) const
+    {
+        return (const double*)getSection( section );
+    }
+}
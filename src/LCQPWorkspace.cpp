@@ -0,0 +1,144 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "LCQPWorkspace.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace LCQPow {
+
+    // Slices start at cache line boundaries (also satisfies the alignment of the vector instructions)
+    static const size_t CACHE_LINE = 64;
+
+
+    LCQPWorkspace::LCQPWorkspace( ) { }
+
+
+    LCQPWorkspace::LCQPWorkspace( const LCQPWorkspace& rhs )
+    {
+        copy( rhs );
+    }
+
+
+    LCQPWorkspace::~LCQPWorkspace( )
+    {
+        clear( );
+    }
+
+
+    LCQPWorkspace& LCQPWorkspace::operator=( const LCQPWorkspace& rhs )
+    {
+        if ( this != &rhs )
+        {
+            clear( );
+            copy( rhs );
+        }
+
+        return *this;
+    }
+
+
+    void LCQPWorkspace::startLayout( )
+    {
+        clear( );
+        layoutPass = true;
+    }
+
+
+    void LCQPWorkspace::allocate( )
+    {
+        size_t size = position;
+
+        clear( );
+
+        if (size == 0)
+            return;
+
+        memory = new char[size + CACHE_LINE]();
+        block = memory + (CACHE_LINE - (size_t)((uintptr_t)memory % CACHE_LINE)) % CACHE_LINE;
+        capacity = size;
+    }
+
+
+    void LCQPWorkspace::rewind( )
+    {
+        position = 0;
+    }
+
+
+    void LCQPWorkspace::clear( )
+    {
+        if (memory != NULL) {
+            delete[] memory;
+            memory = NULL;
+        }
+
+        block = NULL;
+        capacity = 0;
+        position = 0;
+        layoutPass = false;
+    }
+
+
+    double* LCQPWorkspace::getDoubles( size_t n )
+    {
+        return (double*)take(n*sizeof(double));
+    }
+
+
+    int* LCQPWorkspace::getInts( size_t n )
+    {
+        return (int*)take(n*sizeof(int));
+    }
+
+
+    size_t LCQPWorkspace::getSize( ) const
+    {
+        return capacity;
+    }
+
+
+    void LCQPWorkspace::copy( const LCQPWorkspace& rhs )
+    {
+        if (rhs.capacity > 0) {
+            position = rhs.capacity;
+            allocate( );
+            memcpy(block, rhs.block, capacity);
+        }
+    }
+
+
+    void* LCQPWorkspace::take( size_t bytes )
+    {
+        if (bytes == 0 || (!layoutPass && block == NULL))
+            return NULL;
+
+        size_t start = position;
+        position += (bytes + CACHE_LINE - 1)/CACHE_LINE*CACHE_LINE;
+
+        if (layoutPass || position > capacity)
+            return NULL;
+
+        return block + start;
+    }
+}
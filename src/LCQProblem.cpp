@@ -21,7 +21,9 @@
 
 
 #include "LCQProblem.hpp"
+#include "LCQPContainer.hpp"
 #include "Utilities.hpp"
+#include "DenseKernels.hpp"
 #include "MessageHandler.hpp"
 #include "SubsolverQPOASES.hpp"
 #include "SubsolverOSQP.hpp"
@@ -32,11 +34,19 @@
 #include <stdlib.h>
 
 #include <qpOASES.hpp>
+#include <chrono>
 
 using qpOASES::QProblem;
 
 namespace LCQPow {
 
+	// Seconds elapsed since a point in time
+	static double secondsSince( std::chrono::steady_clock::time_point start )
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+
 	LCQProblem::LCQProblem( ) { }
 
 
@@ -66,16 +76,23 @@ namespace LCQPow {
 		nC = _nC;
 		nComp = _nComp;
 
-		// Allocate auxiliar vectors
-		Qk = new double[nV*nV]();
-		gk = new double[nV]();
-		xnew = new double[nV]();
-		yk_A = new double[nC + 2*nComp]();
-		pk = new double[nV]();
-		statk = new double[nV]();
-		constr_statk = new double[nV]();
-		box_statk = new double[nV]();
-		lk_tmp = new double[nV]();
+		// Allocate auxiliar vectors (one block, the iterations do not allocate)
+		workspace.startLayout();
+		carveWorkspace();
+		workspace.allocate();
+		carveWorkspace();
+	}
+
+
+	LCQProblem::LCQProblem( const LCQProblem& rhs )
+	{
+		copy( rhs );
+	}
+
+
+	LCQProblem::LCQProblem( const LCQProblem& rhs, bool shareMatrices )
+	{
+		copy( rhs, shareMatrices );
 	}
 
 
@@ -84,6 +101,18 @@ namespace LCQPow {
 	}
 
 
+	LCQProblem& LCQProblem::operator=( const LCQProblem& rhs )
+	{
+		if ( this != &rhs )
+		{
+			clear();
+			copy( rhs );
+		}
+
+		return *this;
+	}
+
+
 	ReturnValue LCQProblem::loadLCQP(	const double* const _Q, const double* const _g,
 										const double* const _L, const double* const _R,
 										const double* const _lbL, const double* const _ubL,
@@ -92,8 +121,47 @@ namespace LCQPow {
 										const double* const _lb, const double* const _ub,
 										const double* const _x0, const double* const _y0
 										)
+	{
+		if ( nV <= 0 || nComp <= 0 )
+            return( MessageHandler::PrintMessage(ReturnValue::LCQPOBJECT_NOT_SETUP, ERROR) );
+
+		// Reuse the memory of a previous load
+		releaseMatrices( false, false );
+
+		return loadProblemData( _Q, _g, _L, _R, _lbL, _ubL, _lbR, _ubR, _A, _lbA, _ubA, _lb, _ub, _x0, _y0 );
+	}
+
+
+	ReturnValue LCQProblem::loadLCQPBorrowed(	const double* const _Q, const double* const _g,
+												const double* const _L, const double* const _R,
+												const double* const _lbL, const double* const _ubL,
+												const double* const _lbR, const double* const _ubR,
+												const double* const _A, const double* const _lbA, const double* const _ubA,
+												const double* const _lb, const double* const _ub,
+												const double* const _x0, const double* const _y0
+												)
+	{
+		if ( nV <= 0 || nComp <= 0 )
+            return( MessageHandler::PrintMessage(ReturnValue::LCQPOBJECT_NOT_SETUP, ERROR) );
+
+		// Release the matrices of a previous load and only reference the new ones
+		releaseMatrices( false, true );
+
+		return loadProblemData( _Q, _g, _L, _R, _lbL, _ubL, _lbR, _ubR, _A, _lbA, _ubA, _lb, _ub, _x0, _y0 );
+	}
+
+
+	ReturnValue LCQProblem::loadProblemData(	const double* const _Q, const double* const _g,
+												const double* const _L, const double* const _R,
+												const double* const _lbL, const double* const _ubL,
+												const double* const _lbR, const double* const _ubR,
+												const double* const _A, const double* const _lbA, const double* const _ubA,
+												const double* const _lb, const double* const _ub,
+												const double* const _x0, const double* const _y0
+												)
 	{
 		ReturnValue ret;
+		std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
 
 		if ( nV <= 0 || nComp <= 0 )
             return( MessageHandler::PrintMessage(ReturnValue::LCQPOBJECT_NOT_SETUP, ERROR) );
@@ -110,15 +178,7 @@ namespace LCQPow {
 
 		// Only copy lb and ub to temporary variables
 		// Build them once we know what solver is used
-		if (Utilities::isNotNullPtr(_lb)) {
-			lb_tmp = new double[nV];
-			memcpy(lb_tmp, _lb, (size_t) nV*sizeof(double));
-		}
-
-		if (Utilities::isNotNullPtr(_ub)) {
-			ub_tmp = new double[nV];
-			memcpy(ub_tmp, _ub, (size_t) nV*sizeof(double));
-		}
+		setBoxBounds( _lb, _ub );
 
 		if (ret != SUCCESSFUL_RETURN)
 			return MessageHandler::PrintMessage( ret, ERROR );
@@ -139,11 +199,36 @@ namespace LCQPow {
 			return MessageHandler::PrintMessage( ret, ERROR );
 
 		sparseSolver = false;
+		qpSequenceInitialized = false;
+
+		// Counts as setup time of the next solve
+		loadTime = secondsSince( loadStart );
 
 		return ReturnValue::SUCCESSFUL_RETURN;
 	}
 
 
+	/// Reads an optional vector (an empty one if no file is passed)
+	static ReturnValue readOptionalFile( const char* const file, int n, std::vector<double>& data )
+	{
+		data.clear();
+
+		if (Utilities::isNullPtr(file) || n <= 0)
+			return SUCCESSFUL_RETURN;
+
+		data.resize((size_t)n);
+
+		return Utilities::readFromFile( data.data(), n, file );
+	}
+
+
+	/// Data pointer of an optional vector
+	static const double* optionalData( const std::vector<double>& data )
+	{
+		return data.empty() ? 0 : data.data();
+	}
+
+
 	ReturnValue LCQProblem::loadLCQP(	const char* const Q_file, const char* const g_file,
 										const char* const L_file, const char* const R_file,
 										const char* const lbL_file, const char* const ubL_file,
@@ -153,314 +238,312 @@ namespace LCQPow {
 										const char* const x0_file, const char* const y0_file
 										)
 	{
-		ReturnValue ret;
+		if ( nV <= 0 || nComp <= 0 )
+			return MessageHandler::PrintMessage( LCQPOBJECT_NOT_SETUP, ERROR );
+
+		if ( Utilities::isNullPtr(Q_file) || Utilities::isNullPtr(g_file) || Utilities::isNullPtr(L_file) || Utilities::isNullPtr(R_file) )
+			return MessageHandler::PrintMessage( INVALID_ARGUMENT, ERROR );
+
+		// Vectors
+		std::vector<double> _g, _lbL, _ubL, _lbR, _ubR, _lbA, _ubA, _lb, _ub, _x0, _y0;
+
+		ReturnValue ret = readOptionalFile( g_file, nV, _g );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( lbL_file, nComp, _lbL );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( ubL_file, nComp, _ubL );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( lbR_file, nComp, _lbR );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( ubR_file, nComp, _ubR );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( lbA_file, nC, _lbA );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( ubA_file, nC, _ubA );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( lb_file, nV, _lb );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( ub_file, nV, _ub );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( x0_file, nV, _x0 );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( y0_file, nV + nC + 2*nComp, _y0 );
 
-		double* _Q = new double[nV*nV];
-		ret = Utilities::readFromFile( _Q, nV*nV, Q_file );
-		if ( ret != SUCCESSFUL_RETURN ) {
-			delete[] _Q;
+		if (ret != SUCCESSFUL_RETURN)
 			return MessageHandler::PrintMessage( ret, ERROR );
-		}
 
-		double* _g = new double[nV];
-		ret = Utilities::readFromFile( _g, nV, g_file );
-		if ( ret != SUCCESSFUL_RETURN ) {
-			delete[] _g;
-			return MessageHandler::PrintMessage( ret, ERROR );
-		}
+		// Load sparse if all matrices are Matrix Market files (they are not expanded to dense)
+		bool sparse = 	Utilities::getFileFormat(Q_file) == MATRIX_MARKET_FILE &&
+						Utilities::getFileFormat(L_file) == MATRIX_MARKET_FILE &&
+						Utilities::getFileFormat(R_file) == MATRIX_MARKET_FILE &&
+						(Utilities::isNullPtr(A_file) || Utilities::getFileFormat(A_file) == MATRIX_MARKET_FILE);
 
-		double* _L = new double[nComp*nV];
-		ret = Utilities::readFromFile( _L, nComp*nV, L_file );
-		if ( ret != SUCCESSFUL_RETURN ) {
-			delete[] _L;
-			return MessageHandler::PrintMessage( ret, ERROR );
-		}
+		if (sparse) {
+			csc* matrices[4] = { NULL, NULL, NULL, NULL };
+			const char* files[4] = { Q_file, L_file, R_file, A_file };
+			const int rows[4] = { nV, nComp, nComp, nC };
 
-		double* _R = new double[nComp*nV];
-		ret = Utilities::readFromFile( _R, nComp*nV, R_file );
-		if ( ret != SUCCESSFUL_RETURN ) {
-			delete[] _R;
-			return MessageHandler::PrintMessage( ret, ERROR );
-		}
+			for (int k = 0; k < 4 && ret == SUCCESSFUL_RETURN; k++) {
+				if (Utilities::isNullPtr(files[k]))
+					continue;
 
-		double* _lbL = NULL;
-		if (Utilities::isNotNullPtr(lbL_file)) {
-			_lbL = new double[nComp];
-			ret = Utilities::readFromFile( _lbL, nComp, lbL_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _lbL;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
+				ret = Utilities::readMatrixMarket( &matrices[k], files[k] );
 
-		double* _ubL = NULL;
-		if (Utilities::isNotNullPtr(ubL_file)) {
-			_ubL = new double[nComp];
+				if (ret == SUCCESSFUL_RETURN && (matrices[k]->m != rows[k] || matrices[k]->n != nV))
+					ret = INVALID_ARGUMENT;
+			}
 
-			ret = Utilities::readFromFile( _ubL, nComp, ubL_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _ubL;
-				return MessageHandler::PrintMessage( ret, ERROR );
+			if (ret == SUCCESSFUL_RETURN) {
+				ret = loadLCQP( matrices[0], optionalData(_g), matrices[1], matrices[2],
+								optionalData(_lbL), optionalData(_ubL), optionalData(_lbR), optionalData(_ubR),
+								matrices[3], optionalData(_lbA), optionalData(_ubA),
+								optionalData(_lb), optionalData(_ub), optionalData(_x0), optionalData(_y0) );
+			} else {
+				MessageHandler::PrintMessage( ret, ERROR );
 			}
-		}
 
-		double* _lbR = NULL;
-		if (Utilities::isNotNullPtr(lbR_file)) {
-			_lbR = new double[nComp];
+			for (int k = 0; k < 4; k++)
+				Utilities::ClearSparseMat( &matrices[k] );
 
-			ret = Utilities::readFromFile( _lbR, nComp, lbR_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _lbR;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
+			return ret;
 		}
 
-		double* _ubR = NULL;
-		if (Utilities::isNotNullPtr(ubR_file)) {
-			_ubR = new double[nComp];
+		// Dense matrices (stored row by row)
+		std::vector<double> _Q, _L, _R, _A;
 
-			ret = Utilities::readFromFile( _ubR, nComp, ubR_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _ubR;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
+		ret = readOptionalFile( Q_file, nV*nV, _Q );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( L_file, nComp*nV, _L );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( R_file, nComp*nV, _R );
+		if (ret == SUCCESSFUL_RETURN) ret = readOptionalFile( A_file, nC*nV, _A );
 
-		double* _A = NULL;
-		if (Utilities::isNotNullPtr(A_file)) {
-			_A = new double[nC*nV];
-			ret = Utilities::readFromFile( _A, nC*nV, A_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _A;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
+		if (ret != SUCCESSFUL_RETURN)
+			return MessageHandler::PrintMessage( ret, ERROR );
 
-		double* _lbA = NULL;
-		if (Utilities::isNotNullPtr(lbA_file)) {
-			_lbA = new double[nC];
-			ret = Utilities::readFromFile( _lbA, nC, lbA_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _lbA;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
+		return loadLCQP( optionalData(_Q), optionalData(_g), optionalData(_L), optionalData(_R),
+						 optionalData(_lbL), optionalData(_ubL), optionalData(_lbR), optionalData(_ubR),
+						 optionalData(_A), optionalData(_lbA), optionalData(_ubA),
+						 optionalData(_lb), optionalData(_ub), optionalData(_x0), optionalData(_y0) );
+	}
 
-		double* _ubA = NULL;
-		if (Utilities::isNotNullPtr(ubA_file)) {
-			_ubA = new double[nC];
-			ret = Utilities::readFromFile( _ubA, nC, ubA_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _ubA;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
 
-		double* _lb = NULL;
-		if (Utilities::isNotNullPtr(lb_file)) {
-			_lb = new double[nV];
-			ret = Utilities::readFromFile( _lb, nV, lb_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _lb;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
+	ReturnValue LCQProblem::loadLCQP(	const csc* const _Q, const double* const _g,
+										const csc* const _L, const csc* const _R,
+										const double* const _lbL, const double* const _ubL,
+										const double* const _lbR, const double* const _ubR,
+										const csc* const _A, const double* const _lbA, const double* const _ubA,
+										const double* const _lb, const double* const _ub,
+										const double* const _x0, const double* const _y0
+										)
+	{
+		// Reuse the memory of a previous load
+		releaseMatrices( true, false );
 
-		double* _ub = NULL;
-		if (Utilities::isNotNullPtr(ub_file)) {
-			_ub = new double[nV];
-			ret = Utilities::readFromFile( _ub, nV, ub_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _ub;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
+		return loadProblemData( _Q, _g, _L, _R, _lbL, _ubL, _lbR, _ubR, _A, _lbA, _ubA, _lb, _ub, _x0, _y0 );
+	}
 
-		double* _x0 = NULL;
-		if (Utilities::isNotNullPtr(x0_file)) {
-			_x0 = new double[nV];
-			ret = Utilities::readFromFile( _x0, nV, x0_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _x0;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
 
-		double* _y0 = NULL;
-		if (Utilities::isNotNullPtr(y0_file)) {
-			_y0 = new double[nC + 2*nComp];
-			ret = Utilities::readFromFile( _y0, nC + 2*nComp, y0_file );
-			if ( ret != SUCCESSFUL_RETURN ) {
-				delete[] _y0;
-				return MessageHandler::PrintMessage( ret, ERROR );
-			}
-		}
+	ReturnValue LCQProblem::loadLCQPBorrowed(	const csc* const _Q, const double* const _g,
+												const csc* const _L, const csc* const _R,
+												const double* const _lbL, const double* const _ubL,
+												const double* const _lbR, const double* const _ubR,
+												const csc* const _A, const double* const _lbA, const double* const _ubA,
+												const double* const _lb, const double* const _ub,
+												const double* const _x0, const double* const _y0
+												)
+	{
+		// Release the matrices of a previous load and only reference the new ones
+		releaseMatrices( true, true );
+
+		return loadProblemData( _Q, _g, _L, _R, _lbL, _ubL, _lbR, _ubR, _A, _lbA, _ubA, _lb, _ub, _x0, _y0 );
+	}
+
+
+	ReturnValue LCQProblem::loadProblemData(	const csc* const _Q, const double* const _g,
+												const csc* const _L, const csc* const _R,
+												const double* const _lbL, const double* const _ubL,
+												const double* const _lbR, const double* const _ubR,
+												const csc* const _A, const double* const _lbA, const double* const _ubA,
+												const double* const _lb, const double* const _ub,
+												const double* const _x0, const double* const _y0
+												)
+	{
+		ReturnValue ret;
+		std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
 
-		// Fill vaues
 		ret = setQ( _Q );
-		delete[] _Q;
 
 		if (ret != SUCCESSFUL_RETURN)
 			return MessageHandler::PrintMessage( ret, ERROR );
 
 		ret = setG( _g );
-		delete[] _g;
 
 		if (ret != SUCCESSFUL_RETURN)
 			return MessageHandler::PrintMessage( ret, ERROR );
 
-		// Only copy lb and ub to temporary variables
-		// Build them once we know what solver is used
-		if (Utilities::isNotNullPtr(_lb)) {
-			lb_tmp = new double[nV];
-			memcpy(lb_tmp, _lb, (size_t) nV*sizeof(double));
-			delete[] _lb;
-		}
-
-		if (Utilities::isNotNullPtr(_ub)) {
-			ub_tmp = new double[nV];
-			memcpy(ub_tmp, _ub, (size_t) nV*sizeof(double));
-			delete[] _ub;
-		}
-
-		if (ret != SUCCESSFUL_RETURN)
-			return MessageHandler::PrintMessage( ret, ERROR);
-
 		ret = setConstraints( _L, _R, _A, _lbA, _ubA );
 
-		delete[] _L; delete[] _R;
+		if (ret != SUCCESSFUL_RETURN)
+			return MessageHandler::PrintMessage( ret, ERROR );
 
-		if (Utilities::isNotNullPtr(_A)) {
-			delete[] _A;
-			_A = NULL;
-		}
+		ret = setComplementarityBounds( _lbL, _ubL, _lbR, _ubR );
 
-		if (Utilities::isNotNullPtr(_lbA)) {
-			delete[] _lbA;
-			_lbA = NULL;
-		}
+		if (ret != SUCCESSFUL_RETURN)
+			return MessageHandler::PrintMessage( ret, ERROR );
 
-		if (Utilities::isNotNullPtr(_ubA)) {
-			delete[] _ubA;
-			_ubA = NULL;
-		}
+		ret = setInitialGuess( _x0, _y0 );
 
 		if (ret != SUCCESSFUL_RETURN)
 			return MessageHandler::PrintMessage( ret, ERROR );
 
-		ret = setComplementarityBounds( _lbL, _ubL, _lbR, _ubR );
+		// Only copy lb and ub to temporary variables
+		// Build them once we know what solver is used
+		setBoxBounds( _lb, _ub );
 
-		if (Utilities::isNotNullPtr(_lbL)) {
-			delete[] _lbL;
-			_lbL = NULL;
-		}
+		sparseSolver = true;
+		qpSequenceInitialized = false;
 
-		if (Utilities::isNotNullPtr(_ubL)) {
-			delete[] _ubL;
-			_ubL = NULL;
-		}
+		// Symbolic phase of Qk = Q + rho*C
+		setQkPattern();
 
-		if (Utilities::isNotNullPtr(_lbR)) {
-			delete[] _lbR;
-			_lbR = NULL;
-		}
+		// Counts as setup time of the next solve
+		loadTime = secondsSince( loadStart );
 
-		if (Utilities::isNotNullPtr(_ubR)) {
-			delete[] _ubR;
-			_ubR = NULL;
+		return ReturnValue::SUCCESSFUL_RETURN;
+	}
+
+
+	ReturnValue LCQProblem::runSolver( )
+	{
+		// Snapshot of the problem for a replay (not part of the solve time)
+		if (Utilities::isNotNullPtr(options.getDumpFile())) {
+			ReturnValue dumpRet = dumpProblem( options.getDumpFile() );
+
+			if (dumpRet != SUCCESSFUL_RETURN)
+				MessageHandler::PrintMessage( dumpRet, WARNING );
 		}
 
-		if (ret != SUCCESSFUL_RETURN)
-			return MessageHandler::PrintMessage( ret, ERROR );
+		startTiming( );
 
-		ret = setInitialGuess( _x0, _y0 );
+		// Initialize variables
+		ReturnValue ret = initializeSolver();
+		finishPhase( PHASE_SETUP );
 
-		if (Utilities::isNotNullPtr(_x0)) delete[] _x0;
-		if (Utilities::isNotNullPtr(_y0)) delete[] _y0;
+		// The time of the load belongs to this solve
+		stats.updatePhaseTime( PHASE_SETUP, loadTime );
+		stats.updateTimeTotal( loadTime );
+		loadTime = 0;
 
-		if (ret != SUCCESSFUL_RETURN)
+		if (ret != SUCCESSFUL_RETURN) {
+			finishTiming( );
 			return MessageHandler::PrintMessage( ret, ERROR );
+		}
 
-		sparseSolver = false;
+		ret = runHomotopy( true );
 
-		return ReturnValue::SUCCESSFUL_RETURN;
+		if (hasIterationCallback())
+			notifyIterationCallback( EVENT_TERMINATION, ret );
+
+		closeStepFile( );
+		finishTiming( );
+
+		return ret;
 	}
 
 
-	ReturnValue LCQProblem::loadLCQP(	const csc* const _Q, const double* const _g,
-										const csc* const _L, const csc* const _R,
-										const double* const _lbL, const double* const _ubL,
-										const double* const _lbR, const double* const _ubR,
-										const csc* const _A, const double* const _lbA, const double* const _ubA,
-										const double* const _lb, const double* const _ub,
-										const double* const _x0, const double* const _y0
-										)
+	ReturnValue LCQProblem::resolve( const double* const _x0, const double* const _y0 )
 	{
-		ReturnValue ret;
-
-		ret = setQ( _Q );
+		if ( Utilities::isNullPtr(xk) )
+			return MessageHandler::PrintMessage( LCQPOBJECT_NOT_SETUP, ERROR );
 
+		// Start at the previous solution if no new initial guess is passed
+		ReturnValue ret = setInitialGuess( Utilities::isNotNullPtr(_x0) ? _x0 : xk, _y0 );
 		if (ret != SUCCESSFUL_RETURN)
 			return MessageHandler::PrintMessage( ret, ERROR );
 
-		ret = setG( _g );
+		return runHotstartedSolver( );
+	}
 
-		if (ret != SUCCESSFUL_RETURN)
-			return MessageHandler::PrintMessage( ret, ERROR );
 
-		ret = setConstraints( _L, _R, _A, _lbA, _ubA );
+	ReturnValue LCQProblem::runHotstartedSolver( )
+	{
+		// Cold start if there is no QP sequence to continue
+		if (!qpSequenceInitialized)
+			return runSolver( );
 
-		if (ret != SUCCESSFUL_RETURN)
-			return MessageHandler::PrintMessage( ret, ERROR );
+		startTiming( );
 
-		ret = setComplementarityBounds( _lbL, _ubL, _lbR, _ubR );
+		// Initialize variables (but keep the subsolver)
+		ReturnValue ret = initializeSolver( true );
+		finishPhase( PHASE_SETUP );
 
-		if (ret != SUCCESSFUL_RETURN)
+		if (ret != SUCCESSFUL_RETURN) {
+			finishTiming( );
 			return MessageHandler::PrintMessage( ret, ERROR );
+		}
 
-		ret = setInitialGuess( _x0, _y0 );
+		ret = runHomotopy( false );
 
-		if (ret != SUCCESSFUL_RETURN)
-			return MessageHandler::PrintMessage( ret, ERROR );
+		if (hasIterationCallback())
+			notifyIterationCallback( EVENT_TERMINATION, ret );
 
-		// Only copy lb and ub to temporary variables
-		// Build them once we know what solver is used
-		if (Utilities::isNotNullPtr(_lb)) {
-			lb_tmp = new double[nV];
-			memcpy(lb_tmp, _lb, (size_t) nV*sizeof(double));
-		}
+		closeStepFile( );
+		finishTiming( );
 
-		if (Utilities::isNotNullPtr(_ub)) {
-			ub_tmp = new double[nV];
-			memcpy(ub_tmp, _ub, (size_t) nV*sizeof(double));
-		}
+		return ret;
+	}
 
-		sparseSolver = true;
 
-		return ReturnValue::SUCCESSFUL_RETURN;
+	ReturnValue LCQProblem::updateLinearTerm( const double* const _g )
+	{
+		if ( nV <= 0 || Utilities::isNullPtr(g) )
+			return MessageHandler::PrintMessage( LCQPOBJECT_NOT_SETUP, ERROR );
+
+		if ( Utilities::isNullPtr(_g) )
+			return MessageHandler::PrintMessage( INVALID_OBJECTIVE_LINEAR_TERM, ERROR );
+
+		memcpy(g, _g, (size_t)nV*sizeof(double));
+
+		return SUCCESSFUL_RETURN;
 	}
 
 
-	ReturnValue LCQProblem::runSolver( )
+	ReturnValue LCQProblem::updateBounds(	const double* const _lb, const double* const _ub,
+											const double* const _lbA, const double* const _ubA,
+											const double* const _lbL, const double* const _ubL,
+											const double* const _lbR, const double* const _ubR )
 	{
-		// Initialize variables
-		ReturnValue ret = initializeSolver();
+		if ( nV <= 0 || nComp <= 0 || Utilities::isNullPtr(lbA) || Utilities::isNullPtr(ubA) )
+			return MessageHandler::PrintMessage( LCQPOBJECT_NOT_SETUP, ERROR );
+
+		setConstraintBounds( _lbA, _ubA );
+
+		// Box bounds are built once we know what solver is used
+		setBoxBounds( _lb, _ub );
+
+		ReturnValue ret = setComplementarityBounds( _lbL, _ubL, _lbR, _ubR );
+
 		if (ret != SUCCESSFUL_RETURN)
 			return MessageHandler::PrintMessage( ret, ERROR );
 
+		return SUCCESSFUL_RETURN;
+	}
+
+
+	ReturnValue LCQProblem::runHomotopy( bool initialSolve )
+	{
+		ReturnValue ret;
+
 		// Initialization strategy
 		if (options.getSolveZeroPenaltyFirst()) {
 
 			// Zero penalty, i.e. pen-linearization = 0, i.e. gk = g
 			memcpy(gk, g, (size_t)nV*sizeof(double));
-			ret = solveQPSubproblem( true );
+			finishPhase( PHASE_LINEARIZATION );
+
+			ret = solveQPSubproblem( initialSolve );
+			finishPhase( PHASE_QP_SOLVE );
+
 			if (ret != SUCCESSFUL_RETURN) {
 				return MessageHandler::PrintMessage( ret, ERROR );
 			}
 		} else {
 			// Linearize penalty function at initial guess
 			updateLinearization();
-			ret = solveQPSubproblem( true );
+			finishPhase( PHASE_LINEARIZATION );
+
+			ret = solveQPSubproblem( initialSolve );
+			finishPhase( PHASE_QP_SOLVE );
+
 			if (ret != SUCCESSFUL_RETURN) {
 				return MessageHandler::PrintMessage( ret, ERROR );
 			}
@@ -468,6 +551,7 @@ namespace LCQPow {
 
 		// Initialize Qk = Q + rhok*C
 		setQk();
+		finishPhase( PHASE_SETUP );
 
 		// Initialize stats.rho_opt
 		stats.updateRhoOpt( rho );
@@ -477,9 +561,11 @@ namespace LCQPow {
 
 			// Update xk, Qk, stationarity
 			updateStep( );
+			finishPhase( PHASE_STEP_LENGTH );
 
 			// Update gradient of Lagrangian
 			updateStationarity( );
+			finishPhase( PHASE_STATIONARITY );
 
 			// Print iteration
 			printIteration( );
@@ -489,32 +575,49 @@ namespace LCQPow {
 				storeSteps( );
 			}
 
+			// Report the iteration
+			if (hasIterationCallback() && !notifyIterationCallback( EVENT_ITERATION ))
+				return SOLVER_ABORTED_BY_CALLBACK;
+
 			// Update the total iteration counter
 			updateTotalIter();
 
 			// Update inner iterate counter
 			innerIter++;
+			finishPhase( PHASE_BOOKKEEPING );
 
 			// Perform Dynamic Leyffer Strategy
-			if (leyfferCheckPositive( )) {
+			bool leyfferPositive = leyfferCheckPositive( );
+			finishPhase( PHASE_TERMINATION );
+
+			if (leyfferPositive) {
 				updatePenalty( );
 
 				// Update iterate counters
 				updateOuterIter();
 				innerIter = 0;
+
+				if (hasIterationCallback() && !notifyIterationCallback( EVENT_PENALTY_UPDATE ))
+					return SOLVER_ABORTED_BY_CALLBACK;
 			}
 
 			// gk = new linearization + g
 			updateLinearization();
+			finishPhase( PHASE_LINEARIZATION );
 
 			// Terminate, update pen, or continue inner loop
-			if (stationarityCheck()) {
-				if (complementarityCheck()) {
+			bool stationary = stationarityCheck();
+			bool complementary = stationary && complementarityCheck();
+			finishPhase( PHASE_TERMINATION );
+
+			if (stationary) {
+				if (complementary) {
 					// Switch from penalized to LCQP duals
 					transformDuals();
 
 					// Determine C-,M-,S-Stationarity
 					determineStationarityType();
+					finishPhase( PHASE_TERMINATION );
 
 					// Update output statistics
 					stats.updateSolutionStatus( algoStat );
@@ -530,6 +633,10 @@ namespace LCQPow {
 					// Update iterate counters
 					updateOuterIter();
 					innerIter = 0;
+					finishPhase( PHASE_LINEARIZATION );
+
+					if (hasIterationCallback() && !notifyIterationCallback( EVENT_PENALTY_UPDATE ))
+						return SOLVER_ABORTED_BY_CALLBACK;
 				}
 			}
 
@@ -543,9 +650,12 @@ namespace LCQPow {
 
 			// gk = new linearization + g
 			updateLinearization();
+			finishPhase( PHASE_LINEARIZATION );
 
 			// Step computation
 			ret = solveQPSubproblem( false );
+			finishPhase( PHASE_QP_SOLVE );
+
 			if (ret != SUCCESSFUL_RETURN) {
 				return MessageHandler::PrintMessage( ret, ERROR );
 			}
@@ -556,6 +666,7 @@ namespace LCQPow {
 
 			// Step length computation
 			getOptimalStepLength( );
+			finishPhase( PHASE_STEP_LENGTH );
 		}
 	}
 
@@ -569,58 +680,31 @@ namespace LCQPow {
 		if ( Utilities::isNullPtr(A_new) && nC > 0)
 			return INVALID_CONSTRAINT_MATRIX;
 
-		// Set up new constraint matrix (A; L; R)
-		A = new double[(nC + 2*nComp)*nV];
-
-		for (int i = 0; i < nC*nV; i++)
-			A[i] = A_new[i];
-
-		for (int i = 0; i < nComp*nV; i++)
-			A[i + nC*nV] = L_new[i];
+		if ( Utilities::isNullPtr(L_new) || Utilities::isNullPtr(R_new) )
+			return INVALID_COMPLEMENTARITY_MATRIX;
 
-		for (int i = 0; i < nComp*nV; i++)
-			A[i + nC*nV + nComp*nV] = R_new[i];
+		// Set up new constraint matrix (A; L; R)
+		constraints->setUp(nV, nC, nComp, A_new, L_new, R_new);
 
 		// Set up new constraint bounds (lbA; 0; 0) & (ubA; INFINITY; INFINITY)
-		lbA = new double[nC + 2*nComp];
-		ubA = new double[nC + 2*nComp];
+		if (Utilities::isNullPtr(lbA))
+			lbA = new double[nC + 2*nComp];
 
-		if (Utilities::isNotNullPtr(lbA_new)) 
-		{
-			for (int i = 0; i < nC; i++)
-				lbA[i] = lbA_new[i];
-		}
-		else
-		{
-			for (int i = 0; i < nC; i++)
-				lbA[i] = -INFINITY;
-		}
+		if (Utilities::isNullPtr(ubA))
+			ubA = new double[nC + 2*nComp];
 
-		if (Utilities::isNotNullPtr(ubA_new)) 
-		{
-			for (int i = 0; i < nC; i++)
-				ubA[i] = ubA_new[i];
-		}
-		else
-		{
-			for (int i = 0; i < nC; i++)
-				ubA[i] = INFINITY;
-		}
-
-		// Set complementarities
-		if ( Utilities::isNullPtr(L_new) || Utilities::isNullPtr(R_new) )
-			return INVALID_COMPLEMENTARITY_MATRIX;
+		setConstraintBounds( lbA_new, ubA_new );
 
-		L = new double[nComp*nV];
-		R = new double[nComp*nV];
+		if (Utilities::isNullPtr(C))
+			C = new double[(size_t)nV*(size_t)nV];
 
-		for (int i = 0; i < nComp*nV; i++) {
-			L[i] = L_new[i];
-			R[i] = R_new[i];
-		}
+		if (Utilities::isNullPtr(Qk))
+			Qk = new double[(size_t)nV*(size_t)nV];
 
-		C = new double[nV*nV];
-		Utilities::MatrixSymmetrizationProduct(L, R, C, nComp, nV);
+		if (hasSelectorComplementarities())
+			Utilities::SelectorSymmetrizationProduct(constraints->getSelectorColumns(BLOCK_L), constraints->getSelectorColumns(BLOCK_R), C, nComp, nV);
+		else
+			Utilities::MatrixSymmetrizationProduct(L_new, R_new, C, nComp, nV);
 
 		return SUCCESSFUL_RETURN;
 	}
@@ -630,67 +714,33 @@ namespace LCQPow {
 											const csc* const A_new, const double* const lbA_new, const double* const ubA_new
 											)
 	{
-		// Create sparse matrices
-		L_sparse = Utilities::copyCSC(L_new);
-		R_sparse = Utilities::copyCSC(R_new);
-
-		// Get number of elements
-		int tmpA_nnx = L_sparse->p[nV] + R_sparse->p[nV];
-
-		if (Utilities::isNotNullPtr(A_new)) {
-			tmpA_nnx += Utilities::isNotNullPtr(A_new->p) ? A_new->p[nV] : 0;
-		}
-
-		// Data array
-		double* tmpA_data = (double*)malloc((size_t)tmpA_nnx*sizeof(double));
+		// Set up new constraint matrix (A; L; R)
+		constraints->setUp(nV, nC, nComp, A_new, L_new, R_new);
 
-		// Row indices
-		int* tmpA_i = (int*)malloc((size_t)tmpA_nnx*sizeof(int));
+		// Set up new constraint bounds (lbA; 0; 0) & (ubA; INFINITY; INFINITY)
+		if (Utilities::isNullPtr(lbA))
+			lbA = new double[nC + 2*nComp];
 
-		// Column pointers
-		int* tmpA_p = (int*)malloc((size_t)(nV+1)*sizeof(int));
+		if (Utilities::isNullPtr(ubA))
+			ubA = new double[nC + 2*nComp];
 
-		int index_data = 0;
-		tmpA_p[0] = 0;
+		setConstraintBounds( lbA_new, ubA_new );
 
-		// Iterate over columns
-		for (int i = 0; i < nV; i++) {
-			tmpA_p[i+1] = tmpA_p[i];
-
-			// First handle rows of A
-			if (Utilities::isNotNullPtr(A_new)) {
-				for (int j = A_new->p[i]; j < A_new->p[i+1]; j++) {
-					tmpA_data[index_data] = A_new->x[j];
-					tmpA_i[index_data] = A_new->i[j];
-					index_data++;
-					tmpA_p[i+1]++;
-				}
-			}
-
-			// Then rows of L
-			for (int j = L_sparse->p[i]; j < L_sparse->p[i+1]; j++) {
-				tmpA_data[index_data] = L_sparse->x[j];
-				tmpA_i[index_data] = nC + L_sparse->i[j];
-				index_data++;
-				tmpA_p[i+1]++;
-			}
+		if (hasSelectorComplementarities())
+			C_sparse = Utilities::SelectorSymmetrizationProduct(constraints->getSelectorColumns(BLOCK_L), constraints->getSelectorColumns(BLOCK_R), nComp, nV);
+		else
+			C_sparse = Utilities::MatrixSymmetrizationProduct(L_new, R_new);
 
-			// Then rows of R
-			for (int j = R_sparse->p[i]; j < R_sparse->p[i+1]; j++) {
-				tmpA_data[index_data] = R_sparse->x[j];
-				tmpA_i[index_data] = nC + nComp + R_sparse->i[j];
-				index_data++;
-				tmpA_p[i+1]++;
-			}
+		if (Utilities::isNullPtr(C_sparse)) {
+			return FAILED_SYM_COMPLEMENTARITY_MATRIX;
 		}
 
-		// Create sparse matrix
-		A_sparse = Utilities::createCSC(nC + 2*nComp, nV, tmpA_nnx, tmpA_data, tmpA_i, tmpA_p);
+		return SUCCESSFUL_RETURN;
+	}
 
-		// Set up new constraint bounds (lbA; 0; 0) & (ubA; INFINITY; INFINITY)
-		lbA = new double[nC + 2*nComp];
-		ubA = new double[nC + 2*nComp];
 
+	void LCQProblem::setConstraintBounds( const double* const lbA_new, const double* const ubA_new )
+	{
 		if (Utilities::isNotNullPtr(lbA_new)) 
 		{
 			for (int i = 0; i < nC; i++)
@@ -712,33 +762,42 @@ namespace LCQPow {
 			for (int i = 0; i < nC; i++)
 				ubA[i] = INFINITY;
 		}
-
-		C_sparse = Utilities::MatrixSymmetrizationProduct(L_sparse, R_sparse);
-
-		if (Utilities::isNullPtr(C_sparse)) {
-			return FAILED_SYM_COMPLEMENTARITY_MATRIX;
-		}
-
-		return SUCCESSFUL_RETURN;
 	}
 
 
 	ReturnValue LCQProblem::setComplementarityBounds(const double* const lbL_new, const double* const ubL_new, const double* const lbR_new, const double* const ubR_new) {
 
+		// Reuse existing bound vectors and drop them if no bounds are passed (e.g. on updateBounds)
 		if (Utilities::isNotNullPtr(lbL_new )) {
-			lbL = new double[nComp];
+			if (Utilities::isNullPtr(lbL))
+				lbL = new double[nComp];
+		} else if (Utilities::isNotNullPtr(lbL)) {
+			delete[] lbL;
+			lbL = NULL;
 		}
 
 		if (Utilities::isNotNullPtr(ubL_new )) {
-			ubL = new double[nComp];
+			if (Utilities::isNullPtr(ubL))
+				ubL = new double[nComp];
+		} else if (Utilities::isNotNullPtr(ubL)) {
+			delete[] ubL;
+			ubL = NULL;
 		}
 
 		if (Utilities::isNotNullPtr(lbR_new )) {
-			lbR = new double[nComp];
+			if (Utilities::isNullPtr(lbR))
+				lbR = new double[nComp];
+		} else if (Utilities::isNotNullPtr(lbR)) {
+			delete[] lbR;
+			lbR = NULL;
 		}
 
 		if (Utilities::isNotNullPtr(ubR_new )) {
-			ubR = new double[nComp];
+			if (Utilities::isNullPtr(ubR))
+				ubR = new double[nComp];
+		} else if (Utilities::isNotNullPtr(ubR)) {
+			delete[] ubR;
+			ubR = NULL;
 		}
 
 		// Bounds on Lx
@@ -790,99 +849,221 @@ namespace LCQPow {
 		if (nV <= 0)
 			return LCQPOBJECT_NOT_SETUP;
 
-		Q_sparse = Utilities::copyCSC(Q_new);
+		// Borrowed data is never written to
+		if (borrowedData)
+			Q_sparse = const_cast<csc*>(Q_new);
+		else
+			Utilities::assignCSC(Q_new, &Q_sparse);
 
 		return ReturnValue::SUCCESSFUL_RETURN;
 	}
 
 
-	void LCQProblem::setQk( )
+	void LCQProblem::setQkPattern( )
 	{
-		if (sparseSolver) {
-			std::vector<double> Qk_data;
-			std::vector<int> Qk_row;
-			int* Qk_p = (int*)malloc((size_t)(nV+1)*sizeof(int));
-			Qk_p[0] = 0;
+		Utilities::ClearSparseMat(&Qk_sparse);
 
-			// Iterate over columns
-			for (int j = 0; j < nV; j++) {
-				Qk_p[j+1] = Qk_p[j];
+		std::shared_ptr<QkPattern> pattern = std::make_shared<QkPattern>();
+		std::vector<int>& Qk_indices_of_Q = pattern->indices_of_Q;
+		std::vector<int>& Qk_indices_of_C = pattern->indices_of_C;
+		Qk_indices_of_Q.assign((size_t)Q_sparse->p[nV], 0);
+		Qk_indices_of_C.assign((size_t)C_sparse->p[nV], 0);
 
-				int idx_Q = Q_sparse->p[j];
-				int idx_C = C_sparse->p[j];
+		std::vector<int> Qk_row;
+		int* Qk_p = (int*)malloc((size_t)(nV+1)*sizeof(int));
+		Qk_p[0] = 0;
 
-				while (idx_Q < Q_sparse->p[j+1] || idx_C < C_sparse->p[j+1]) {
-					// Only elements of Q left in this column
-					if (idx_Q < Q_sparse->p[j+1] && idx_C >= C_sparse->p[j+1]) {
-						Qk_data.push_back(Q_sparse->x[idx_Q]);
-						Qk_row.push_back(Q_sparse->i[idx_Q]);
+		// Iterate over columns and merge the (sorted) row indices of Q and C
+		for (int j = 0; j < nV; j++) {
+			Qk_p[j+1] = Qk_p[j];
 
-						idx_Q++;
-					}
+			int idx_Q = Q_sparse->p[j];
+			int idx_C = C_sparse->p[j];
 
-					// Only elements of C left in this column
-					else if (idx_Q >= Q_sparse->p[j+1] && idx_C < C_sparse->p[j+1]) {
-						Qk_data.push_back(rho*C_sparse->x[idx_C]);
-						Qk_row.push_back(C_sparse->i[idx_C]);
+			while (idx_Q < Q_sparse->p[j+1] || idx_C < C_sparse->p[j+1]) {
+				// Only elements of Q left in this column, or element of Q is in higher row than C
+				if (idx_C >= C_sparse->p[j+1] || (idx_Q < Q_sparse->p[j+1] && Q_sparse->i[idx_Q] < C_sparse->i[idx_C])) {
+					Qk_row.push_back(Q_sparse->i[idx_Q]);
+					Qk_indices_of_Q[(size_t)idx_Q] = Qk_p[j+1];
 
-						Qk_indices_of_C.push_back(Qk_p[j+1]);
+					idx_Q++;
+				}
 
-						idx_C++;
-					}
+				// Only elements of C left in this column, or element of C is in higher row than Q
+				else if (idx_Q >= Q_sparse->p[j+1] || Q_sparse->i[idx_Q] > C_sparse->i[idx_C]) {
+					Qk_row.push_back(C_sparse->i[idx_C]);
+					Qk_indices_of_C[(size_t)idx_C] = Qk_p[j+1];
 
-					// Element of Q is in higher row than C
-					else if (Q_sparse->i[idx_Q] < C_sparse->i[idx_C]) {
-						Qk_data.push_back(Q_sparse->x[idx_Q]);
-						Qk_row.push_back(Q_sparse->i[idx_Q]);
+					idx_C++;
+				}
 
-						idx_Q++;
-					}
+				// Both share this entry: store it only once
+				else {
+					Qk_row.push_back(Q_sparse->i[idx_Q]);
+					Qk_indices_of_Q[(size_t)idx_Q] = Qk_p[j+1];
+					Qk_indices_of_C[(size_t)idx_C] = Qk_p[j+1];
 
-					// Element of C are in higher row than Q
-					else if (Q_sparse->i[idx_Q] > C_sparse->i[idx_C]) {
-						Qk_data.push_back(rho*C_sparse->x[idx_C]);
-						Qk_row.push_back(C_sparse->i[idx_C]);
+					idx_Q++;
+					idx_C++;
+				}
 
-						Qk_indices_of_C.push_back(Qk_p[j+1]);
+				Qk_p[j+1]++;
+			}
+		}
 
-						idx_C++;
-					}
+		int Qk_nnx = Qk_p[nV];
+		double* Qk_x = (double*)calloc((size_t)Qk_nnx, sizeof(double));
+		int* Qk_i =  (int*)malloc((size_t)Qk_nnx*sizeof(int));
 
-					// Add both and update index only once!
-					else {
-						Qk_data.push_back(Q_sparse->x[idx_Q] + rho*C_sparse->x[idx_C]);
-						Qk_row.push_back(Q_sparse->i[idx_Q]);
+		for (size_t i = 0; i < (size_t) Qk_nnx; i++)
+			Qk_i[i] = Qk_row[i];
 
-						idx_Q++;
-						idx_C++;
+		Qk_sparse = Utilities::createCSC(nV, nV, Qk_nnx, Qk_x, Qk_i, Qk_p);
 
-						Qk_indices_of_C.push_back(Qk_p[j+1]);
-					}
+		// C does not change with the penalty parameter
+		pattern->C_on_Qk.assign((size_t)Qk_nnx, 0);
 
-					Qk_p[j+1]++;
-				}
-			}
+		for (size_t k = 0; k < Qk_indices_of_C.size(); k++)
+			pattern->C_on_Qk[(size_t)Qk_indices_of_C[k]] = C_sparse->x[k];
 
-			int Qk_nnx = (int) Qk_data.size();
-			double* Qk_x = (double*)malloc((size_t)Qk_nnx*sizeof(double));
-			int* Qk_i =  (int*)malloc((size_t)Qk_nnx*sizeof(int));
+		Qk_pattern = pattern;
+	}
 
-			for (size_t i = 0; i < (size_t) Qk_nnx; i++) {
-				Qk_x[i] = Qk_data[i];
-				Qk_i[i] = Qk_row[i];
-			}
 
-			Qk_sparse = Utilities::createCSC(nV, nV, Qk_nnx, Qk_x, Qk_i, Qk_p);
+	void LCQProblem::setQk( )
+	{
+		if (sparseSolver) {
+			// The symbolic phase is usually performed at load time
+			if (Utilities::isNullPtr(Qk_sparse))
+				setQkPattern();
+
+			// Numeric phase: Qk = Q + rho*C on the fixed union pattern
+			for (int k = 0; k < Qk_sparse->p[nV]; k++)
+				Qk_sparse->x[k] = 0;
 
-			Qk_data.clear();
-			Qk_row.clear();
+			const std::vector<int>& Qk_indices_of_Q = Qk_pattern->indices_of_Q;
+			const std::vector<int>& Qk_indices_of_C = Qk_pattern->indices_of_C;
+
+			for (size_t k = 0; k < Qk_indices_of_Q.size(); k++)
+				Qk_sparse->x[Qk_indices_of_Q[k]] = Q_sparse->x[k];
+
+			for (size_t k = 0; k < Qk_indices_of_C.size(); k++)
+				Qk_sparse->x[Qk_indices_of_C[k]] += rho*C_sparse->x[k];
 		} else {
 			Utilities::WeightedMatrixAdd(1, Q, rho, C, Qk, nV, nV);
 		}
+
+		// Also bounds the round-off accumulated by the updates along the steps
+		resetEvaluation();
+	}
+
+
+	bool LCQProblem::hasSelectorComplementarities( ) const
+	{
+		return Utilities::isNotNullPtr(constraints->getSelectorColumns(BLOCK_L)) && Utilities::isNotNullPtr(constraints->getSelectorColumns(BLOCK_R));
+	}
+
+
+	void LCQProblem::multiplyQkAndC( const double* const v, double* Qkv, double* Cv ) const
+	{
+		// C*v = L'*(R*v) + R'*(L*v) costs O(nComp) for selector matrices
+		if (hasSelectorComplementarities()) {
+			const int* const l = constraints->getSelectorColumns(BLOCK_L);
+			const int* const r = constraints->getSelectorColumns(BLOCK_R);
+
+			if (sparseSolver)
+				Utilities::TransponsedMatrixMultiplication(Qk_sparse, v, Qkv);
+			else
+				DenseKernels::MatrixVectorProduct(1, Qk, v, 0, Qkv, nV, nV);
+
+			for (int j = 0; j < nV; j++)
+				Cv[j] = 0;
+
+			for (int i = 0; i < nComp; i++) {
+				Cv[l[i]] += v[r[i]];
+				Cv[r[i]] += v[l[i]];
+			}
+
+			return;
+		}
+
+		if (sparseSolver) {
+			const std::vector<double>& C_on_Qk = Qk_pattern->C_on_Qk;
+
+			// Qk and C are symmetric: compute column-wise dot products over the pattern of Qk (contains the one of C)
+			for (int j = 0; j < nV; j++) {
+				double tmpQk = 0;
+				double tmpC = 0;
+
+				for (int k = Qk_sparse->p[j]; k < Qk_sparse->p[j+1]; k++) {
+					double vi = v[Qk_sparse->i[k]];
+					tmpQk += Qk_sparse->x[k]*vi;
+					tmpC += C_on_Qk[(size_t)k]*vi;
+				}
+
+				Qkv[j] = tmpQk;
+				Cv[j] = tmpC;
+			}
+		} else {
+			DenseKernels::MatrixVectorProduct(1, Qk, v, 0, Qkv, nV, nV);
+			DenseKernels::MatrixVectorProduct(1, C, v, 0, Cv, nV, nV);
+		}
+	}
+
+
+	void LCQProblem::evaluateIterate( )
+	{
+		if (iterateEvaluated)
+			return;
+
+		multiplyQkAndC(xk, Qkxk, Cxk);
+		constraints->multiply(BLOCK_L, BLOCK_R, xk, LRxk);
+		iterateEvaluated = true;
+		iterateUpdated = false;
+
+		evaluatePhi();
+	}
+
+
+	void LCQProblem::evaluatePhi( )
+	{
+		// Equals phi_const + g_phi'*xk + xk'*C*xk/2, but without cancellation
+		phik = 0;
+
+		for (int i = 0; i < nComp; i++) {
+			double resL = LRxk[i];
+			double resR = LRxk[nComp + i];
+
+			if (Utilities::isNotNullPtr(lbL))
+				resL -= lbL[i];
+
+			if (Utilities::isNotNullPtr(lbR))
+				resR -= lbR[i];
+
+			phik += resL*resR;
+		}
+	}
+
+
+	void LCQProblem::evaluateStep( )
+	{
+		if (!stepEvaluated) {
+			multiplyQkAndC(pk, Qkpk, Cpk);
+			constraints->multiply(BLOCK_L, BLOCK_R, pk, LRpk);
+			stepEvaluated = true;
+		}
+	}
+
+
+	void LCQProblem::resetEvaluation( )
+	{
+		iterateEvaluated = false;
+		stepEvaluated = false;
+		iterateUpdated = false;
 	}
 
 
-	ReturnValue LCQProblem::initializeSolver( )
+	ReturnValue LCQProblem::initializeSolver( bool reuseSubsolver )
 	{
 		ReturnValue ret = SUCCESSFUL_RETURN;
 		if (options.getQPSolver() == QPSolver::QPOASES_DENSE) {
@@ -903,8 +1084,9 @@ namespace LCQPow {
 			if (ret != SUCCESSFUL_RETURN)
 				return ret;
 
-			Subsolver tmp(nV, nC + 2*nComp, Q, A);
-			subsolver = tmp;
+			// A reset object passes the new matrices to its subsolver (if their dimensions did not change)
+			if (!reuseSubsolver && !(keepSubsolver && subsolver.updateMatrices(nV, nC + 2*nComp, Q, constraints->getDense())))
+				subsolver.setUp(nV, nC + 2*nComp, Q, constraints->getDense());
 		} else if (options.getQPSolver() == QPSolver::QPOASES_SPARSE) {
 			nDuals = nV + nC + 2*nComp;
 			boxDualOffset = nV;
@@ -923,77 +1105,79 @@ namespace LCQPow {
 			if (ret != SUCCESSFUL_RETURN)
 				return ret;
 
-			Subsolver tmp(nV, nC + 2*nComp, Q_sparse, A_sparse, options.getQPSolver());
-			subsolver = tmp;
+			// A reset object passes the new matrices to its subsolver (if their patterns did not change)
+			if (!reuseSubsolver && !(keepSubsolver && subsolver.updateMatrices(nV, nC + 2*nComp, Q_sparse, constraints->getSparse(), options.getQPSolver()))) {
+				ret = subsolver.setUp(nV, nC + 2*nComp, Q_sparse, constraints->getSparse(), options.getQPSolver());
+
+				if (ret != SUCCESSFUL_RETURN)
+					return ret;
+			}
 
 		} else if (options.getQPSolver() == QPSolver::OSQP_SPARSE) {
-			if (Utilities::isNotNullPtr(lb) || Utilities::isNotNullPtr(ub)) {
-				return INVALID_OSQP_BOX_CONSTRAINTS;
+			if (Utilities::isNotNullPtr(lb_tmp) || Utilities::isNotNullPtr(ub_tmp)) {
+				return ReturnValue::INVALID_OSQP_BOX_CONSTRAINTS;
 			}
 
 			nDuals = nC + 2*nComp;
 			boxDualOffset = 0;
 
-			// If solving with OSQP we ignore the dual guess on the box constraints
-			if (Utilities::isNotNullPtr(yk)) {
-				double* yk_tmp = new double[nDuals];
-
-				// Shift the duals
-				for (int i = 0; i < nDuals; i++)
-					yk_tmp[i] = yk[nV + i];
-
-				delete[] yk;
-				yk = new double[nDuals];
-				memcpy(yk, yk_tmp, (size_t)nDuals);
-				delete[] yk_tmp;
-			}
-
 			if (!sparseSolver) {
 				return DENSE_SPARSE_MISSMATCH;
 			}
 
-			if (Utilities::isNotNullPtr(lb_tmp) || Utilities::isNotNullPtr(ub_tmp)) {
-				return ReturnValue::INVALID_OSQP_BOX_CONSTRAINTS;
+			// Box constraints might remain from a previous run with qpOASES
+			if (Utilities::isNotNullPtr(lb)) {
+				delete[] lb;
+				lb = NULL;
+			}
+
+			if (Utilities::isNotNullPtr(ub)) {
+				delete[] ub;
+				ub = NULL;
 			}
 
-			Subsolver tmp(nV, nDuals, Q_sparse, A_sparse, options.getQPSolver());
-			subsolver = tmp;
+			// A reset object passes the new matrices to its subsolver (if their patterns did not change)
+			if (!reuseSubsolver && !(keepSubsolver && subsolver.updateMatrices(nV, nDuals, Q_sparse, constraints->getSparse(), options.getQPSolver()))) {
+				ret = subsolver.setUp(nV, nDuals, Q_sparse, constraints->getSparse(), options.getQPSolver());
+
+				if (ret != SUCCESSFUL_RETURN)
+					return ret;
+			}
 		} else {
 			return ReturnValue::NOT_YET_IMPLEMENTED;
 		}
 
-		// Linear objective component
-		g_tilde = new double[nV];
-		memcpy(g_tilde, g, (size_t)nV*sizeof(double));
+		// A new (or updated) subsolver must initialize its QP sequence
+		if (!reuseSubsolver)
+			qpSequenceInitialized = false;
 
-		// Phi expressions
-		if (Utilities::isNotNullPtr(lbL) || Utilities::isNotNullPtr(lbR)) 
-			phi_const = Utilities::DotProduct(lbL, lbR, nComp);
+		keepSubsolver = false;
 
-		// g_phi
-		if (Utilities::isNotNullPtr(lbL) || Utilities::isNotNullPtr(lbR)) {
-			g_phi = new double[nV]();
+		// Every run starts at the initial guess
+		memcpy(xk, x0, (size_t)nV*sizeof(double));
+		resetEvaluation();
 
-			// (R'*lb_L contribution)
-			if (Utilities::isNotNullPtr(lbL)) {
-				if (sparseSolver)
-					Utilities::AddTransponsedMatrixMultiplication(R_sparse, lbL, g_phi);
-				else
-					Utilities::AddTransponsedMatrixMultiplication(R, lbL, g_phi, nComp, nV, 1);
-			}
+		// If solving with OSQP we ignore the dual guess on the box constraints
+		if (Utilities::isNotNullPtr(y0)) {
+			for (int i = 0; i < nDuals; i++)
+				yk[i] = y0[nV - boxDualOffset + i];
+		}
 
-			// (L'*lb_R contribution)
-			if (Utilities::isNotNullPtr(lbR)) {
-				if (sparseSolver)
-					Utilities::AddTransponsedMatrixMultiplication(L_sparse, lbR, g_phi);
-				else
-					Utilities::AddTransponsedMatrixMultiplication(L, lbR, g_phi, nComp, nV, 1);
-			}
+		// Linear objective component
+		memcpy(g_tilde, g, (size_t)nV*sizeof(double));
 
-			// Sign must be negative (really have 0 <= Lx - lbL and 0 <= Rx - lbR)
-			for (int i = 0; i < nV; i++)
-				g_phi[i] = -g_phi[i];
-		}
+		// g_phi (zero if no complementarity lower bounds are given)
+		for (int i = 0; i < nV; i++)
+			g_phi[i] = 0;
+
+		// Signs are negative (really have 0 <= Lx - lbL and 0 <= Rx - lbR)
+		// (-R'*lb_L contribution)
+		if (Utilities::isNotNullPtr(lbL))
+			constraints->addTransposedMultiply(BLOCK_R, -1, lbL, g_phi);
+
+		// (-L'*lb_R contribution)
+		if (Utilities::isNotNullPtr(lbR))
+			constraints->addTransposedMultiply(BLOCK_L, -1, lbR, g_phi);
 
 		// Initialize variables and counters
 		alphak = 1;
@@ -1009,28 +1193,55 @@ namespace LCQPow {
 		else
 			subsolver.setOptions(options.getOSQPOptions());
 
-		// Reset output statistics
+		// Reset output statistics and Leyffer history (the history only grows, the iterations do not allocate)
 		stats.reset();
+		stats.setStepCapacity( options.getStepStorage() == StepStorage::STORE_LAST_STEPS ? options.getStepStorageSize() : 0 );
 
-		// Set seed
-		srand( (unsigned int)time( NULL ) );
+		// Stream the iterates of this solve to the step file
+		stepWriter.close();
 
-		// Clean up temporary box constraints
-		if (Utilities::isNotNullPtr(lb_tmp)) {
-			delete[] lb_tmp;
-			lb_tmp = NULL;
-		}
+		if (options.getStoreSteps() && Utilities::isNotNullPtr(options.getStepFile())) {
+			ret = stepWriter.open( options.getStepFile() );
 
-		if (Utilities::isNotNullPtr(ub_tmp)) {
-			delete[] ub_tmp;
-			ub_tmp = NULL;
+			if (ret != SUCCESSFUL_RETURN)
+				return ret;
 		}
 
+		if (complHistory.size() < (size_t)std::max(options.getNDynamicPenalty(), 0))
+			complHistory.resize((size_t)options.getNDynamicPenalty());
+
+		complHistoryLength = 0;
+		complHistoryOldest = 0;
+
+		// Restart the perturbations (equal problems and options yield equal iterates on any thread)
+		perturbationCounter = 0;
+
 		// Print new line before printing anything else (might not have been printed by other users...)
 		if (options.getPrintLevel() > PrintLevel::NONE)
-			printf("\n");
+			MessageHandler::Print("\n");
+
+		return ret;
+	}
+
+
+	ReturnValue LCQProblem::setInstanceData(	const double* const _g,
+												const double* const _lbA, const double* const _ubA,
+												const double* const _lb, const double* const _ub,
+												const double* const _x0, const double* const _y0 )
+	{
+		if ( nV <= 0 || nComp <= 0 || Utilities::isNullPtr(g) || Utilities::isNullPtr(lbA) || Utilities::isNullPtr(ubA) )
+			return LCQPOBJECT_NOT_SETUP;
+
+		if ( Utilities::isNullPtr(_g) )
+			return INVALID_OBJECTIVE_LINEAR_TERM;
+
+		memcpy(g, _g, (size_t)nV*sizeof(double));
+
+		setConstraintBounds( _lbA, _ubA );
+
+		setBoxBounds( _lb, _ub );
 
-		return ret;
+		return setInitialGuess( _x0, _y0 );
 	}
 
 
@@ -1042,27 +1253,40 @@ namespace LCQPow {
 			return SUCCESSFUL_RETURN;
 		}
 
-		Q_sparse = Utilities::dns_to_csc(Q, nV, nV);
-		A_sparse = Utilities::dns_to_csc(A, nC + 2*nComp, nV);
+		// Shared matrices are not converted
+		if (sharedMatrices)
+			return FAILED_SWITCH_TO_SPARSE;
 
-		L_sparse = Utilities::dns_to_csc(L, nComp, nV);
-		R_sparse = Utilities::dns_to_csc(R, nComp, nV);
+		Q_sparse = Utilities::dns_to_csc(Q, nV, nV);
 		C_sparse = Utilities::dns_to_csc(C, nV, nV);
 
 		// Make sure that all sparse matrices are not null pointer
-		if (Utilities::isNullPtr(Q_sparse) || Utilities::isNullPtr(A_sparse) || Utilities::isNullPtr(L_sparse) || Utilities::isNullPtr(R_sparse) || Utilities::isNullPtr(C_sparse)) {
+		if (Utilities::isNullPtr(Q_sparse) || Utilities::isNullPtr(C_sparse)) {
 			return FAILED_SWITCH_TO_SPARSE;
 		}
 
-		// Clean up dense data (only if succeeded)
-		delete[] Q; Q = NULL;
-		delete[] A; A = NULL;
-		delete[] L; L = NULL;
-		delete[] R; R = NULL;
+		ReturnValue ret = constraints->switchToSparseMode();
+
+		if (ret != SUCCESSFUL_RETURN)
+			return ret;
+
+		// Clean up dense data (only if succeeded, borrowed matrices are only dropped)
+		if (!borrowedData)
+			delete[] Q;
+
+		Q = NULL;
 		delete[] C; C = NULL;
+		delete[] Qk; Qk = NULL;
+
+		// The sparse matrices are owned
+		borrowedData = false;
 
 		// Toggle sparsity flag
 		sparseSolver = true;
+		qpSequenceInitialized = false;
+
+		// Symbolic phase of Qk = Q + rho*C
+		setQkPattern();
 
 		return SUCCESSFUL_RETURN;
 	}
@@ -1076,27 +1300,41 @@ namespace LCQPow {
 			return SUCCESSFUL_RETURN;
 		}
 
-		Q = Utilities::csc_to_dns(Q_sparse);
-		A = Utilities::csc_to_dns(A_sparse);
+		// Shared matrices are not converted
+		if (sharedMatrices)
+			return FAILED_SWITCH_TO_DENSE;
 
-		L = Utilities::csc_to_dns(L_sparse);
-		R = Utilities::csc_to_dns(R_sparse);
+		Q = Utilities::csc_to_dns(Q_sparse);
 		C = Utilities::csc_to_dns(C_sparse);
 
 		// Make sure that all sparse matrices are not null pointer
-		if (Utilities::isNullPtr(Q) || Utilities::isNullPtr(A) || Utilities::isNullPtr(L) || Utilities::isNullPtr(R) || Utilities::isNullPtr(C)) {
+		if (Utilities::isNullPtr(Q) || Utilities::isNullPtr(C)) {
 			return FAILED_SWITCH_TO_DENSE;
 		}
 
-		// Clean up sparse data (only if succeeded)
+		if (Utilities::isNullPtr(Qk))
+			Qk = new double[(size_t)nV*(size_t)nV];
+
+		ReturnValue ret = constraints->switchToDenseMode();
+
+		if (ret != SUCCESSFUL_RETURN)
+			return ret;
+
+		// Clean up sparse data (only if succeeded, borrowed matrices are only dropped)
+		if (borrowedData)
+			Q_sparse = NULL;
+
 		Utilities::ClearSparseMat(&C_sparse);
-		Utilities::ClearSparseMat(&A_sparse);
 		Utilities::ClearSparseMat(&Q_sparse);
-		Utilities::ClearSparseMat(&L_sparse);
-		Utilities::ClearSparseMat(&R_sparse);
+		Utilities::ClearSparseMat(&Qk_sparse);
+		Qk_pattern.reset();
+
+		// The dense matrices are owned
+		borrowedData = false;
 
 		// Toggle sparsity flag
 		sparseSolver = false;
+		qpSequenceInitialized = false;
 
 		return SUCCESSFUL_RETURN;
 	}
@@ -1104,35 +1342,33 @@ namespace LCQPow {
 
 	void LCQProblem::updateLinearization()
 	{
-		if (sparseSolver) {
-			Utilities::AffineLinearTransformation(rho, C_sparse, xk, g_tilde, gk, nV);
-		} else {
-			Utilities::AffineLinearTransformation(rho, C, xk, g_tilde, gk, nV, nV);
-		}
+		// gk = rho*C*xk + g_tilde
+		evaluateIterate();
+		Utilities::WeightedVectorAdd(rho, Cxk, 1, g_tilde, gk, nV);
 	}
 
 
 	ReturnValue LCQProblem::solveQPSubproblem(bool initialSolve)
 	{
 		// First solve convex subproblem
-		ReturnValue ret = subsolver.solve( initialSolve, qpIterk, qpSolverExitFlag, gk, lbA, ubA, xk, yk, lb, ub );
+		// The dual iterate is only passed as initial guess if the user provided one
+		const double* const yGuess = Utilities::isNotNullPtr(y0) ? yk : 0;
+		std::chrono::steady_clock::time_point qpStart = std::chrono::steady_clock::now();
+		ReturnValue ret = subsolver.solve( initialSolve, qpIterk, qpSolverExitFlag, gk, lbA, ubA, xk, yGuess, lb, ub );
+		qpSolveTime = secondsSince(qpStart);
+		subsolver.getSolveStatistics(qpRhoUpdates, qpFactorizations);
 
 		// Update stats
 		stats.updateSubproblemIter(qpIterk);
 		stats.updateQPSolverExitFlag(qpSolverExitFlag);
 
-		// If no initial guess was passed, then need to allocate memory
-		if (Utilities::isNullPtr(xk)) {
-			xk = new double[nV];
-		}
-
-		if (Utilities::isNullPtr(yk)) {
-			yk = new double[nDuals];
+		// Return on error (a failed QP sequence can not be hotstarted)
+		if (ret != SUCCESSFUL_RETURN) {
+			qpSequenceInitialized = false;
+			return ret;
 		}
 
-		// Return on error
-		if (ret != SUCCESSFUL_RETURN)
-			return ret;
+		qpSequenceInitialized = true;
 
 		// Update xnew, yk
 		subsolver.getSolution(xnew, yk);
@@ -1141,15 +1377,64 @@ namespace LCQPow {
 		for (int i = 0; i < nC + 2*nComp; i++)
 			yk_A[i] = yk[boxDualOffset + i];
 
+		// The residuals are only reported with the stored steps
+		if (options.getStoreSteps())
+			evaluateQPResiduals();
+
 		// Update pk
 		Utilities::WeightedVectorAdd(1, xnew, -1, xk, pk, nV);
+		stepEvaluated = false;
 
 		return SUCCESSFUL_RETURN;
 	}
 
 
+	void LCQProblem::evaluateQPResiduals( )
+	{
+		// Primal residual: violation of lbA <= [A; L; R]*xnew <= ubA and lb <= xnew <= ub
+		constraints->multiply(BLOCK_A, BLOCK_R, xnew, qpAx);
+
+		qpPrimalResidual = 0;
+		for (int i = 0; i < nC + 2*nComp; i++) {
+			qpPrimalResidual = std::max(qpPrimalResidual, lbA[i] - qpAx[i]);
+			qpPrimalResidual = std::max(qpPrimalResidual, qpAx[i] - ubA[i]);
+		}
+
+		for (int i = 0; i < nV; i++) {
+			if (Utilities::isNotNullPtr(lb))
+				qpPrimalResidual = std::max(qpPrimalResidual, lb[i] - xnew[i]);
+
+			if (Utilities::isNotNullPtr(ub))
+				qpPrimalResidual = std::max(qpPrimalResidual, xnew[i] - ub[i]);
+		}
+
+		// Dual residual: Q*xnew + gk - [A; L; R]'*yk_A - yk_x
+		if (sparseSolver)
+			Utilities::MatrixMultiplication(Q_sparse, xnew, qpResidual);
+		else
+			DenseKernels::MatrixVectorProduct(1, Q, xnew, 0, qpResidual, nV, nV);
+
+		Utilities::WeightedVectorAdd(1, qpResidual, 1, gk, qpResidual, nV);
+		constraints->addTransposedMultiply(-1, yk_A, qpResidual);
+
+		if (boxDualOffset > 0)
+			Utilities::WeightedVectorAdd(1, qpResidual, -1, yk, qpResidual, nV);
+
+		qpDualResidual = Utilities::MaxAbs(qpResidual, nV);
+	}
+
+
 	bool LCQProblem::stationarityCheck( ) {
-		return Utilities::MaxAbs(statk, nV) < options.getStationarityTolerance();
+		if (statNormk >= options.getStationarityTolerance())
+			return false;
+
+		// Confirm with products evaluated from scratch (the updates along the steps accumulate round-off)
+		if (iterateUpdated) {
+			resetEvaluation();
+			updateStationarity();
+		}
+
+		return statNormk < options.getStationarityTolerance();
 	}
 
 
@@ -1164,69 +1449,49 @@ namespace LCQPow {
 		if (sparseSolver) {
 			return lin + Utilities::QuadraticFormProduct(Q_sparse, xk, nV)/2.0;
 		} else {
-			return lin + Utilities::QuadraticFormProduct(Q, xk, nV)/2.0;
+			return lin + Utilities::QuadraticFormProduct(Q, xk, nV, Qxk)/2.0;
 		}
 	}
 
 
 	double LCQProblem::getPhi( ) {
-		double phi_lin = 0;
-
-		// Linear term
-		if (Utilities::isNotNullPtr(g_phi))
-			phi_lin += Utilities::DotProduct(g_phi, xk, nV);
-
-		// Quadratic term
-		if (sparseSolver) {
-			return phi_const + phi_lin + Utilities::QuadraticFormProduct(C_sparse, xk, nV)/2.0;
-		} else {
-			return phi_const + phi_lin + Utilities::QuadraticFormProduct(C, xk, nV)/2.0;
-		}
+		evaluateIterate();
+		return phik;
 	}
 
 
 	double LCQProblem::getMerit( ) {
-		double lin = Utilities::DotProduct(g, xk, nV);
-
-		if (sparseSolver) {
-			return lin + Utilities::QuadraticFormProduct(Qk_sparse, xk, nV)/2.0;
-		} else {
-			return lin + Utilities::QuadraticFormProduct(Qk, xk, nV)/2.0;
-		}
+		evaluateIterate();
+		return Utilities::DotProduct(g, xk, nV) + Utilities::DotProduct(Qkxk, xk, nV)/2.0;
 	}
 
 
 	void LCQProblem::updatePenalty( ) {
 		// Clear Leyffer history
-		if (options.getNDynamicPenalty() > 0)
-			complHistory.clear();
+		if (options.getNDynamicPenalty() > 0) {
+			complHistoryLength = 0;
+			complHistoryOldest = 0;
+		}
 
 		rho *= options.getPenaltyUpdateFactor();
 		stats.updateRhoOpt( rho );
 
 		// On penalty update also update Qk = Q + rhok C
-		updateQk();
+		setQk();
 
 		// Update g_tilde = g + rho*g_phi
-		if (Utilities::isNotNullPtr(g_phi)) {
-			Utilities::WeightedVectorAdd(1.0, g, rho, g_phi, g_tilde, nV);
-		}
+		Utilities::WeightedVectorAdd(1.0, g, rho, g_phi, g_tilde, nV);
 	}
 
 
 	void LCQProblem::getOptimalStepLength( ) {
 
-		double qk;
+		evaluateIterate();
+		evaluateStep();
 
-		if (sparseSolver) {
-			qk = Utilities::QuadraticFormProduct(Qk_sparse, pk, nV);
-			Utilities::AffineLinearTransformation(1, Qk_sparse, xk, g_tilde, lk_tmp, nV);
-		} else {
-			qk = Utilities::QuadraticFormProduct(Qk, pk, nV);
-			Utilities::AffineLinearTransformation(1, Qk, xk, g_tilde, lk_tmp, nV, nV);
-		}
-
-		double lk = Utilities::DotProduct(pk, lk_tmp, nV);
+		// qk = pk'*Qk*pk, lk = pk'*(Qk*xk + g_tilde)
+		double qk = Utilities::DotProduct(pk, Qkpk, nV);
+		double lk = Utilities::DotProduct(pk, Qkxk, nV) + Utilities::DotProduct(pk, g_tilde, nV);
 
 		alphak = 1;
 
@@ -1240,27 +1505,29 @@ namespace LCQPow {
 	void LCQProblem::updateStep( ) {
 		// xk = xk + alphak*pk
 		Utilities::WeightedVectorAdd(1, xk, alphak, pk, xk, nV);
+
+		// All cached products are linear in xk: update them along the step instead of a full sweep
+		if (iterateEvaluated && stepEvaluated) {
+			Utilities::WeightedVectorAdd(1, Qkxk, alphak, Qkpk, Qkxk, nV);
+			Utilities::WeightedVectorAdd(1, Cxk, alphak, Cpk, Cxk, nV);
+			Utilities::WeightedVectorAdd(1, LRxk, alphak, LRpk, LRxk, 2*nComp);
+			iterateUpdated = true;
+
+			evaluatePhi();
+		} else {
+			iterateEvaluated = false;
+		}
 	}
 
 
 	void LCQProblem::updateStationarity( ) {
 		// stat = Qk*xk + g - A'*yk_A - yk_x
 		// 1) Objective contribution: Qk*xk + g
-		if (sparseSolver) {
-			Utilities::AffineLinearTransformation(1, Qk_sparse, xk, g_tilde, statk, nV);
-		} else {
-			Utilities::AffineLinearTransformation(1, Qk, xk, g_tilde, statk, nV, nV);
-		}
-
-		// 2) Constraint contribution: A'*yk
-		// Utilities::TransponsedMatrixMultiplication(A, yk_A, constr_statk, nC + 2*nComp, nV, 1);
-		if (sparseSolver) {
-			Utilities::TransponsedMatrixMultiplication(A_sparse, yk_A, constr_statk);
-		} else {
-			Utilities::TransponsedMatrixMultiplication(A, yk_A, constr_statk, nC + 2*nComp, nV, 1);
-		}
+		evaluateIterate();
+		Utilities::WeightedVectorAdd(1, Qkxk, 1, g_tilde, statk, nV);
 
-		Utilities::WeightedVectorAdd(1, statk, -1, constr_statk, statk, nV);
+		// 2) Constraint contribution: -A'*yk (one pass over the blocks A, L and R)
+		constraints->addTransposedMultiply(-1, yk_A, statk);
 
 		// 3) Box constraint contribution
 		if (Utilities::isNotNullPtr(lb) || Utilities::isNotNullPtr(ub)) {
@@ -1269,6 +1536,8 @@ namespace LCQPow {
 
 			Utilities::WeightedVectorAdd(1, statk, -1, box_statk, statk, nV);
 		}
+
+		statNormk = Utilities::MaxAbs(statk, nV);
 	}
 
 
@@ -1284,15 +1553,15 @@ namespace LCQPow {
 		double complCur = getPhi();
 
 		// Don't perform in first getNDynamicPenalty steps
-		if (complHistory.size() < n) {
-			complHistory.push_back(complCur);
+		if (complHistoryLength < n) {
+			complHistory[complHistoryLength++] = complCur;
 			return false;
 		}
 
 		// Don't increase penalty if already at satisfactory level
 		if (complementarityCheck()) {
-			complHistory.pop_front();
-			complHistory.push_back(complCur);
+			complHistory[complHistoryOldest] = complCur;
+			complHistoryOldest = (complHistoryOldest + 1) % n;
 			return false;
 		}
 
@@ -1305,27 +1574,14 @@ namespace LCQPow {
 			}
 		}
 
-		// Update history vector
-		complHistory.pop_front();
-		complHistory.push_back(complCur);
+		// Update history (ring buffer, replace the oldest value)
+		complHistory[complHistoryOldest] = complCur;
+		complHistoryOldest = (complHistoryOldest + 1) % n;
 
 		return retFlag;
 	}
 
 
-	void LCQProblem::updateQk( ) {
-		// Smart update in sparse case
-		if (sparseSolver) {
-			double factor = rho*(1 - 1.0/options.getPenaltyUpdateFactor());
-			for (size_t j = 0; j < Qk_indices_of_C.size(); j++) {
-				Qk_sparse->x[Qk_indices_of_C[j]] += factor*C_sparse->x[j];
-			}
-		} else {
-			Utilities::WeightedMatrixAdd(1, Q, rho, C, Qk, nV, nV);
-		}
-	}
-
-
 	void LCQProblem::updateOuterIter( ) {
 		outerIter++;
 		stats.updateIterOuter(1);
@@ -1340,83 +1596,182 @@ namespace LCQPow {
 
 	void LCQProblem::perturbGradient( ) {
 
-		int randNum;
-		for (int i = 0; i < nV; i++) {
-			// Random number -1, 0, 1
-			randNum = (rand() % 3) - 1;
+		// Random numbers -1, 0, 1 (all coordinates at once)
+		Utilities::AddRandomPerturbation(gk, nV, options.getRandomSeed(), perturbationCounter, Utilities::EPS);
+		perturbationCounter += (unsigned long long)nV;
+	}
+
+
+	void LCQProblem::perturbStep( ) {
+
+		// Random numbers -1, 0, 1 (all coordinates at once)
+		Utilities::AddRandomPerturbation(xk, nV, options.getRandomSeed(), perturbationCounter, Utilities::EPS);
+		perturbationCounter += (unsigned long long)nV;
+
+		resetEvaluation();
+	}
 
-			gk[i] += randNum*Utilities::EPS;
+
+	void LCQProblem::closeStepFile( )
+	{
+		if (stepWriter.isOpen() && stepWriter.close() != SUCCESSFUL_RETURN)
+			MessageHandler::PrintMessage( UNABLE_TO_WRITE_FILE, WARNING );
+	}
+
+
+	/// Rows first, ..., first + rows - 1 of a csc matrix (the returned header references the passed arrays)
+	static csc getRows( const csc* const M, int first, int rows, std::vector<double>& x, std::vector<int>& i, std::vector<int>& p )
+	{
+		x.clear();
+		i.clear();
+		p.assign(1, 0);
+
+		for (int j = 0; j < M->n; j++) {
+			for (int k = M->p[j]; k < M->p[j+1]; k++) {
+				if (M->i[k] >= first && M->i[k] < first + rows) {
+					x.push_back(M->x[k]);
+					i.push_back(M->i[k] - first);
+				}
+			}
+
+			p.push_back((int)x.size());
 		}
+
+		csc block;
+		block.m = rows;
+		block.n = M->n;
+		block.nzmax = (int)x.size();
+		block.nz = -1;
+		block.x = x.data();
+		block.i = i.data();
+		block.p = p.data();
+
+		return block;
 	}
 
 
-	void LCQProblem::perturbStep( ) {
+	ReturnValue LCQProblem::dumpProblem( const char* const filename )
+	{
+		if ( Utilities::isNullPtr(g) || Utilities::isNullPtr(lbA) || Utilities::isNullPtr(ubA) || Utilities::isNullPtr(x0) )
+			return LCQPOBJECT_NOT_SETUP;
 
-		int randNum;
-		for (int i = 0; i < nV; i++) {
-			// Random number -1, 0, 1
-			randNum = (rand() % 3) - 1;
+		// The blocks of the stacked matrix [A; L; R] are consecutive rows
+		if (!sparseSolver) {
+			const double* const M = constraints->getDense();
 
-			xk[i] += randNum*Utilities::EPS;
+			return LCQPContainer::write(
+				filename, nV, nC, nComp, Q, g, M + (size_t)nC*(size_t)nV, M + (size_t)(nC + nComp)*(size_t)nV, lbL, ubL, lbR, ubR,
+				nC > 0 ? M : 0, lbA, ubA, lb_tmp, ub_tmp, x0, y0, &options
+			);
 		}
+
+		std::vector<double> x[3];
+		std::vector<int> i[3], p[3];
+
+		const csc* const M = constraints->getSparse();
+		csc A_block = getRows(M, 0, nC, x[0], i[0], p[0]);
+		csc L_block = getRows(M, nC, nComp, x[1], i[1], p[1]);
+		csc R_block = getRows(M, nC + nComp, nComp, x[2], i[2], p[2]);
+
+		return LCQPContainer::write(
+			filename, nV, nC, nComp, Q_sparse, g, &L_block, &R_block, lbL, ubL, lbR, ubR,
+			nC > 0 ? &A_block : 0, lbA, ubA, lb_tmp, ub_tmp, x0, y0, &options
+		);
 	}
 
 
 	void LCQProblem::storeSteps( ) {
+		// Every k-th iterate if sampled
+		bool sampled = options.getStepStorage() != StepStorage::STORE_SAMPLED_STEPS ||
+			stats.getNumberOfTrackedSteps() % options.getStepStorageSize() == 0;
+
+		if (sampled && stepWriter.isOpen())
+			stepWriter.write( xk, nV );
+
 		stats.updateTrackingVectors(
-			xk,
+			sampled && !stepWriter.isOpen() ? xk : NULL,
 			innerIter,
 			qpIterk,
 			alphak,
 			Utilities::MaxAbs(pk, nV),
-			Utilities::MaxAbs(statk, nV),
+			statNormk,
 			getObj(),
 			getPhi(),
 			getMerit(),
 			nV
 		);
+
+		stats.updateSubproblemTrackingVectors(
+			qpSolveTime,
+			qpRhoUpdates,
+			qpFactorizations,
+			qpPrimalResidual,
+			qpDualResidual
+		);
+	}
+
+
+	bool LCQProblem::hasIterationCallback( ) const
+	{
+		#ifdef LCQPOW_NO_CALLBACKS
+		return false;
+		#else
+		return iterationCallback != NULL;
+		#endif
+	}
+
+
+	bool LCQProblem::notifyIterationCallback( CallbackEvent event, ReturnValue status )
+	{
+		IterationData data;
+
+		data.totalIter = totalIter;
+		data.outerIter = outerIter;
+		data.innerIter = innerIter;
+		data.subproblemIter = qpIterk;
+		data.rho = rho;
+		data.stepLength = alphak;
+		data.stepSize = Utilities::MaxAbs(pk, nV);
+		data.statNorm = statNormk;
+		data.phi = getPhi();
+		data.merit = getMerit();
+		data.nV = nV;
+		data.nDuals = nDuals;
+		data.x = xk;
+		data.y = yk;
+		data.p = pk;
+		data.stat = statk;
+		data.status = status;
+
+		return iterationCallback( event, data, iterationCallbackData );
 	}
 
 
 	void LCQProblem::transformDuals( ) {
 
-		double* tmp = new double[nComp];
+		evaluateIterate();
 
 		// y_L = y - rho*R*xk
-		if (sparseSolver) {
-			Utilities::MatrixMultiplication(R_sparse, xk, tmp);
-		} else {
-			Utilities::MatrixMultiplication(R, xk, tmp, nComp, nV, 1);
-		}
-
 		for (int i = 0; i < nComp; i++) {
-			yk[boxDualOffset + nC + i] = yk[boxDualOffset + nC + i] - rho*tmp[i];
+			yk[boxDualOffset + nC + i] = yk[boxDualOffset + nC + i] - rho*LRxk[nComp + i];
 		}
 
 		// y_R = y - rho*L*xk
-		if (sparseSolver) {
-			Utilities::MatrixMultiplication(L_sparse, xk, tmp);
-		} else {
-			Utilities::MatrixMultiplication(L, xk, tmp, nComp, nV, 1);
-		}
-
 		for (int i = 0; i < nComp; i++) {
-			yk[boxDualOffset + nC + nComp + i] = yk[boxDualOffset + nC + nComp + i] - rho*tmp[i];
+			yk[boxDualOffset + nC + nComp + i] = yk[boxDualOffset + nC + nComp + i] - rho*LRxk[i];
 		}
-
-		// clear memory
-		delete[] tmp;
 	}
 
 
 	void LCQProblem::determineStationarityType( ) {
 
-		std::vector<int> weakComp = getWeakComplementarities( );
+		int nWeakComp = getWeakComplementarities( );
 
 		bool s_stationary = true;
 		bool m_stationary = true;
 
-		for (int i : weakComp) {
+		for (int j = 0; j < nWeakComp; j++) {
+			int i = weakComp[j];
 			double dualProd = yk_A[nC + i]*yk_A[nC + nComp + i];
 			double dualMin = std::min(yk_A[nC + i], yk_A[nC + nComp + i]);
 
@@ -1453,32 +1808,42 @@ namespace LCQPow {
 	}
 
 
-	std::vector<int> LCQProblem::getWeakComplementarities( )
+	int LCQProblem::getWeakComplementarities( )
 	{
-		double* Lx = new double[nComp];
-		double* Rx = new double[nComp];
+		evaluateIterate();
 
-		if (sparseSolver) {
-			Utilities::MatrixMultiplication(L_sparse, xk, Lx);
-			Utilities::MatrixMultiplication(R_sparse, xk, Rx);
-		} else {
-			Utilities::MatrixMultiplication(L, xk, Lx, nComp, nV, 1);
-			Utilities::MatrixMultiplication(R, xk, Rx, nComp, nV, 1);
-		}
-
-		std::vector<int> indices;
+		int nWeakComp = 0;
 
 		for (int i = 0; i < nComp; i++) {
-			if (Lx[i] <= options.getComplementarityTolerance())
-				if (Rx[i] <= options.getComplementarityTolerance())
-					indices.push_back(i);
+			if (LRxk[i] <= options.getComplementarityTolerance())
+				if (LRxk[nComp + i] <= options.getComplementarityTolerance())
+					weakComp[nWeakComp++] = i;
 		}
 
-		// Free memory
-		delete[] Lx;
-		delete[] Rx;
+		return nWeakComp;
+	}
+
+
+	void LCQProblem::reset( )
+	{
+		// Drop the QP sequence, but keep the subsolver for the next solve
+		qpSequenceInitialized = false;
+		keepSubsolver = true;
+
+		// Restart from the initial guess
+		if (Utilities::isNotNullPtr(xk) && Utilities::isNotNullPtr(x0))
+			memcpy(xk, x0, (size_t)nV*sizeof(double));
+
+		resetEvaluation();
+
+		alphak = 1;
+		outerIter = 0;
+		innerIter = 0;
+		totalIter = 0;
+		algoStat = AlgorithmStatus::PROBLEM_NOT_SOLVED;
 
-		return indices;
+		stats.reset();
+		closeStepFile();
 	}
 
 
@@ -1522,6 +1887,26 @@ namespace LCQPow {
 	}
 
 
+	const OutputStatistics& LCQProblem::getOutputStatistics( ) const
+	{
+		return stats;
+	}
+
+
+	ReturnValue LCQProblem::setIterationCallback( IterationCallback callback, void* userData )
+	{
+		#ifdef LCQPOW_NO_CALLBACKS
+		if (Utilities::isNotNullPtr(callback))
+			return MessageHandler::PrintMessage( CALLBACKS_DISABLED, ERROR );
+		#endif
+
+		iterationCallback = callback;
+		iterationCallbackData = userData;
+
+		return SUCCESSFUL_RETURN;
+	}
+
+
 	/*
 	 *	 p r i n t I t e r a t i o n
 	 */
@@ -1542,37 +1927,39 @@ namespace LCQPow {
 
 		const char* sep = " | ";
 
+		// Compose the line first, it is printed as one message
+		char line[256];
+		size_t len = 0;
+
 		// Print outer iterate
-		printf("%6d", outerIter);
+		len += (size_t)snprintf(line + len, sizeof(line) - len, "%6d", outerIter);
 
 		// Print innter iterate
 		if (options.getPrintLevel() >= PrintLevel::INNER_LOOP_ITERATES)
-			printf("%s%*d", sep, 6, innerIter);
+			len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%*d", sep, 6, innerIter);
 
 		// Print stationarity violation
-		double tmpdbl = Utilities::MaxAbs(statk, nV);
-		printf("%s%10.3g", sep, tmpdbl);
+		len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%10.3g", sep, statNormk);
 
 		// Print complementarity violation
-		printf("%s%10.3g", sep, getPhi());
+		len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%10.3g", sep, getPhi());
 
 		// Print current penalty parameter
-		printf("%s%10.3g", sep, rho);
+		len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%10.3g", sep, rho);
 
 		// Print infinity norm of computed full step
-		tmpdbl = Utilities::MaxAbs(pk, nV);
-		printf("%s%10.3g", sep, tmpdbl);
+		len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%10.3g", sep, Utilities::MaxAbs(pk, nV));
 
 		if (options.getPrintLevel() >= PrintLevel::INNER_LOOP_ITERATES) {
 			// Print optimal step length
-			printf("%s%10.3g", sep, alphak);
+			len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%10.3g", sep, alphak);
 
 			// Print number of qpOASES iterations
-			printf("%s%6d", sep, qpIterk);
+			len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%6d", sep, qpIterk);
 		}
 
 		// Print new line
-		printf(" \n");
+		MessageHandler::Print("%s \n", line);
 	}
 
 
@@ -1590,21 +1977,10 @@ namespace LCQPow {
 		const char* sl = "   alpha  ";
 		const char* subIt = "sub it";
 
-		printf("%s",outer);
-
 		if (options.getPrintLevel() >= PrintLevel::INNER_LOOP_ITERATES)
-			printf("%s%s", sep, inner);
-
-		printf("%s%s", sep, stat);
-		printf("%s%s", sep, comp);
-		printf("%s%s", sep, pen);
-		printf("%s%s", sep, np);
-
-		if (options.getPrintLevel() >= PrintLevel::INNER_LOOP_ITERATES) {
-			printf("%s%s%s%s", sep, sl, sep, subIt);
-		}
-
-		printf(" \n");
+			MessageHandler::Print("%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s \n", outer, sep, inner, sep, stat, sep, comp, sep, pen, sep, np, sep, sl, sep, subIt);
+		else
+			MessageHandler::Print("%s%s%s%s%s%s%s%s%s \n", outer, sep, stat, sep, comp, sep, pen, sep, np);
 
 		printLine();
 	}
@@ -1618,32 +1994,165 @@ namespace LCQPow {
 		const char* dSep = "----------";
 		const char* node = "-+-";
 
-		printf("%s", iSep);
-
-		// Print innter iterate
 		if (options.getPrintLevel() >= PrintLevel::INNER_LOOP_ITERATES)
-			printf("%s%s", node, iSep);
+			MessageHandler::Print("%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s-\n", iSep, node, iSep, node, dSep, node, dSep, node, dSep, node, dSep, node, dSep, node, iSep);
+		else
+			MessageHandler::Print("%s%s%s%s%s%s%s%s%s-\n", iSep, node, dSep, node, dSep, node, dSep, node, dSep);
+	}
 
-		printf("%s%s", node, dSep);
-		printf("%s%s", node, dSep);
-		printf("%s%s", node, dSep);
-		printf("%s%s", node, dSep);
 
-		if (options.getPrintLevel() >= PrintLevel::INNER_LOOP_ITERATES) {
-			printf("%s%s%s%s", node, dSep, node, iSep);
-		}
+	void LCQProblem::startTiming( )
+	{
+		solveStart = std::chrono::steady_clock::now();
+		phaseStart = solveStart;
+	}
+
+
+	void LCQProblem::finishPhase( SolverPhase phase )
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		stats.updatePhaseTime( phase, std::chrono::duration<double>(now - phaseStart).count() );
+		phaseStart = now;
+	}
 
-		printf("-\n");
+
+	void LCQProblem::finishTiming( )
+	{
+		// Time not attributed yet (e.g. on early returns)
+		finishPhase( PHASE_BOOKKEEPING );
+		stats.updateTimeTotal( std::chrono::duration<double>(phaseStart - solveStart).count() );
+	}
+
+
+	void LCQProblem::carveWorkspace( )
+	{
+		// Only vectors (the dense Qk is allocated with C, the sparse one holds its own pattern)
+		size_t n = (size_t)nV;
+		size_t nA = (size_t)(nC + 2*nComp);
+
+		gk = workspace.getDoubles(n);
+		g_tilde = workspace.getDoubles(n);
+		g_phi = workspace.getDoubles(n);
+		xnew = workspace.getDoubles(n);
+		pk = workspace.getDoubles(n);
+		yk_A = workspace.getDoubles(nA);
+		statk = workspace.getDoubles(n);
+		box_statk = workspace.getDoubles(n);
+		Qkxk = workspace.getDoubles(n);
+		Cxk = workspace.getDoubles(n);
+		Qkpk = workspace.getDoubles(n);
+		Cpk = workspace.getDoubles(n);
+		LRxk = workspace.getDoubles(2*(size_t)nComp);
+		LRpk = workspace.getDoubles(2*(size_t)nComp);
+		qpResidual = workspace.getDoubles(n);
+		qpAx = workspace.getDoubles(nA);
+		Qxk = workspace.getDoubles(n);
+		weakComp = workspace.getInts((size_t)nComp);
 	}
 
 
 	/// Clear allocated memory
+	void LCQProblem::copy( const LCQProblem& rhs, bool shareMatrices )
+	{
+		nV = rhs.nV;
+		nC = rhs.nC;
+		nComp = rhs.nComp;
+		nDuals = rhs.nDuals;
+		boxDualOffset = rhs.boxDualOffset;
+
+		int nA = nC + 2*nComp;
+		int nDualsMax = nV + nC + 2*nComp;
+
+		// Problem data (borrowed matrices are shared, as well as all matrices if requested)
+		sharedMatrices = shareMatrices;
+		borrowedData = rhs.borrowedData && !sharedMatrices;
+
+		if (borrowedData || sharedMatrices)
+			Q = rhs.Q;
+		else
+			Q = Utilities::copyArray(rhs.Q, (size_t)nV*(size_t)nV);
+
+		g = Utilities::copyArray(rhs.g, nV);
+		lb = Utilities::copyArray(rhs.lb, nV);
+		ub = Utilities::copyArray(rhs.ub, nV);
+		lb_tmp = Utilities::copyArray(rhs.lb_tmp, nV);
+		ub_tmp = Utilities::copyArray(rhs.ub_tmp, nV);
+		lbA = Utilities::copyArray(rhs.lbA, nA);
+		ubA = Utilities::copyArray(rhs.ubA, nA);
+
+		if (sharedMatrices) {
+			constraints = rhs.constraints;
+			C = rhs.C;
+		} else {
+			constraints = std::make_shared<ConstraintMatrix>( *rhs.constraints );
+			C = Utilities::copyArray(rhs.C, (size_t)nV*(size_t)nV);
+		}
+
+		Qk = Utilities::copyArray(rhs.Qk, (size_t)nV*(size_t)nV);
+		lbL = Utilities::copyArray(rhs.lbL, nComp);
+		ubL = Utilities::copyArray(rhs.ubL, nComp);
+		lbR = Utilities::copyArray(rhs.lbR, nComp);
+		ubR = Utilities::copyArray(rhs.ubR, nComp);
+
+		// Iterates and auxiliar vectors (the copied workspace hands out the same slices)
+		workspace = rhs.workspace;
+		carveWorkspace();
+
+		rho = rhs.rho;
+		x0 = Utilities::copyArray(rhs.x0, nV);
+		y0 = Utilities::copyArray(rhs.y0, nDualsMax);
+		xk = Utilities::copyArray(rhs.xk, nV);
+		yk = Utilities::copyArray(rhs.yk, nDualsMax);
+		alphak = rhs.alphak;
+		statNormk = rhs.statNormk;
+		phik = rhs.phik;
+		iterateEvaluated = rhs.iterateEvaluated;
+		stepEvaluated = rhs.stepEvaluated;
+		iterateUpdated = rhs.iterateUpdated;
+
+		outerIter = rhs.outerIter;
+		innerIter = rhs.innerIter;
+		totalIter = rhs.totalIter;
+		qpIterk = rhs.qpIterk;
+		qpSolverExitFlag = rhs.qpSolverExitFlag;
+		algoStat = rhs.algoStat;
+
+		// Sparse data (the symbolic phase of Qk is copied, not recomputed)
+		sparseSolver = rhs.sparseSolver;
+
+		if (borrowedData || sharedMatrices)
+			Q_sparse = rhs.Q_sparse;
+		else if (Utilities::isNotNullPtr(rhs.Q_sparse))
+			Q_sparse = Utilities::copyCSC(rhs.Q_sparse);
+
+		if (sharedMatrices)
+			C_sparse = rhs.C_sparse;
+		else if (Utilities::isNotNullPtr(rhs.C_sparse))
+			C_sparse = Utilities::copyCSC(rhs.C_sparse);
+
+		// The values of Qk depend on the penalty parameter, its pattern does not
+		if (Utilities::isNotNullPtr(rhs.Qk_sparse)) Qk_sparse = Utilities::copyCSC(rhs.Qk_sparse);
+		Qk_pattern = rhs.Qk_pattern;
+
+		// The subsolver is not copied (it is set up on each call of runSolver)
+		qpSequenceInitialized = false;
+		keepSubsolver = false;
+		complHistory = rhs.complHistory;
+		complHistoryLength = rhs.complHistoryLength;
+		complHistoryOldest = rhs.complHistoryOldest;
+		perturbationCounter = rhs.perturbationCounter;
+		loadTime = rhs.loadTime;
+		stats = rhs.stats;
+		options = rhs.options;
+		iterationCallback = rhs.iterationCallback;
+		iterationCallbackData = rhs.iterationCallbackData;
+	}
+
+
 	void LCQProblem::clear( )
 	{
-		if (Utilities::isNotNullPtr(Q)) {
-			delete[] Q;
-			Q = NULL;
-		}
+		closeStepFile();
+		clearMatrices();
 
 		if (Utilities::isNotNullPtr(g)) {
 			delete[] g;
@@ -1670,11 +2179,6 @@ namespace LCQPow {
 			ub_tmp = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(A)) {
-			delete[] A;
-			A = NULL;
-		}
-
 		if (Utilities::isNotNullPtr(lbA)) {
 			delete[] lbA;
 			lbA = NULL;
@@ -1685,21 +2189,6 @@ namespace LCQPow {
 			ubA = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(L)) {
-			delete[] L;
-			L = NULL;
-		}
-
-		if (Utilities::isNotNullPtr(R)) {
-			delete[] R;
-			R = NULL;
-		}
-
-		if (Utilities::isNotNullPtr(C)) {
-			delete[] C;
-			C = NULL;
-		}
-
 		if (Utilities::isNotNullPtr(lbL)) {
 			delete[] lbL;
 			lbL = NULL;
@@ -1720,19 +2209,14 @@ namespace LCQPow {
 			ubR = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(g_phi)) {
-			delete[] g_phi;
-			g_phi = NULL;
-		}
-
-		if (Utilities::isNotNullPtr(gk)) {
-			delete[] gk;
-			gk = NULL;
+		if (Utilities::isNotNullPtr(x0)) {
+			delete[] x0;
+			x0 = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(g_tilde)) {
-			delete[] g_tilde;
-			g_tilde = NULL;
+		if (Utilities::isNotNullPtr(y0)) {
+			delete[] y0;
+			y0 = NULL;
 		}
 
 		if (Utilities::isNotNullPtr(xk)) {
@@ -1745,52 +2229,98 @@ namespace LCQPow {
 			yk = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(yk_A)) {
-			delete[] yk_A;
-			yk_A = NULL;
+		// Release the auxiliar vectors (resets their pointers)
+		workspace.clear();
+		carveWorkspace();
+
+		Utilities::ClearSparseMat(&Qk_sparse);
+	}
+
+
+	void LCQProblem::releaseMatrices( bool sparseLoad, bool borrowedLoad )
+	{
+		// Shared matrices belong to the object they are shared with
+		if (sharedMatrices) {
+			Q = NULL;
+			Q_sparse = NULL;
+			C = NULL;
+			C_sparse = NULL;
+			constraints = std::make_shared<ConstraintMatrix>();
+			sharedMatrices = false;
+		}
+
+		// Borrowed matrices belong to the user
+		if (borrowedData) {
+			Q = NULL;
+			Q_sparse = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(xnew)) {
-			delete[] xnew;
-			xnew = NULL;
+		borrowedData = borrowedLoad;
+
+		if ((sparseLoad || borrowedLoad) && Utilities::isNotNullPtr(Q)) {
+			delete[] Q;
+			Q = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(pk)) {
-			delete[] pk;
-			pk = NULL;
+		if (sparseLoad && Utilities::isNotNullPtr(C)) {
+			delete[] C;
+			C = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(Qk)) {
+		if (sparseLoad && Utilities::isNotNullPtr(Qk)) {
 			delete[] Qk;
 			Qk = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(statk)) {
-			delete[] statk;
-			statk = NULL;
+		if (!sparseLoad || borrowedLoad)
+			Utilities::ClearSparseMat(&Q_sparse);
+
+		if (!sparseLoad)
+			Utilities::ClearSparseMat(&Qk_sparse);
+
+		// The pattern of C depends on the ones of L and R (rebuilt on every load)
+		Utilities::ClearSparseMat(&C_sparse);
+	}
+
+
+	void LCQProblem::clearMatrices( )
+	{
+		// Shared matrices belong to the object they are shared with
+		if (sharedMatrices) {
+			Q = NULL;
+			Q_sparse = NULL;
+			C = NULL;
+			C_sparse = NULL;
+			constraints = std::make_shared<ConstraintMatrix>();
+			sharedMatrices = false;
+		}
+
+		// Borrowed matrices belong to the user
+		if (borrowedData) {
+			Q = NULL;
+			Q_sparse = NULL;
+			borrowedData = false;
 		}
 
-		if (Utilities::isNotNullPtr(constr_statk)) {
-			delete[] constr_statk;
-			constr_statk = NULL;
+		if (Utilities::isNotNullPtr(Q)) {
+			delete[] Q;
+			Q = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(box_statk)) {
-			delete[] box_statk;
-			box_statk = NULL;
+		constraints->clear();
+
+		if (Utilities::isNotNullPtr(C)) {
+			delete[] C;
+			C = NULL;
 		}
 
-		if (Utilities::isNotNullPtr(lk_tmp)) {
-			delete[] lk_tmp;
-			lk_tmp = NULL;
+		if (Utilities::isNotNullPtr(Qk)) {
+			delete[] Qk;
+			Qk = NULL;
 		}
 
 		Utilities::ClearSparseMat(&C_sparse);
-		Utilities::ClearSparseMat(&A_sparse);
 		Utilities::ClearSparseMat(&Q_sparse);
-		Utilities::ClearSparseMat(&Qk_sparse);
-		Utilities::ClearSparseMat(&L_sparse);
-		Utilities::ClearSparseMat(&R_sparse);
 	}
 }
 
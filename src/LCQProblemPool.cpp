@@ -0,0 +1,302 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "LCQProblemPool.hpp"
+#include "MessageHandler.hpp"
+
+#include <cassert>
+
+namespace LCQPow {
+
+
+    LCQProblemPool::LCQProblemPool( ) { }
+
+
+    LCQProblemPool::LCQProblemPool( const Options& _options, int _maxIdle, int _maxIdlePerShape ) : options( _options )
+    {
+        maxIdle = _maxIdle > 0 ? _maxIdle : 0;
+        maxIdlePerShape = _maxIdlePerShape > 0 ? _maxIdlePerShape : 0;
+    }
+
+
+    LCQProblemPool::~LCQProblemPool( )
+    {
+        // Acquired objects are still in use, deleting them would leave their users with dangling pointers
+        assert( acquired.empty() );
+
+        clear( );
+    }
+
+
+    LCQProblem* LCQProblemPool::acquire( const LCQProblemShape& shape )
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+
+            // The most recently released object of this shape
+            for (std::list< std::pair<LCQProblemShape, LCQProblem*> >::iterator it = idle.begin(); it != idle.end(); ++it) {
+                if (isSameShape(it->first, shape)) {
+                    LCQProblem* lcqp = it->second;
+                    idle.erase(it);
+
+                    acquired[lcqp] = shape;
+                    nReused++;
+
+                    return lcqp;
+                }
+            }
+        }
+
+        // Construct outside of the lock
+        LCQProblem* lcqp = create( shape );
+
+        if (Utilities::isNullPtr(lcqp))
+            return NULL;
+
+        std::lock_guard<std::mutex> lock( mutex );
+        acquired[lcqp] = shape;
+        nCreated++;
+
+        return lcqp;
+    }
+
+
+    ReturnValue LCQProblemPool::release( LCQProblem* lcqp )
+    {
+        if (Utilities::isNullPtr(lcqp))
+            return INVALID_ARGUMENT;
+
+        LCQProblemShape shape;
+
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+
+            std::map<const LCQProblem*, LCQProblemShape>::iterator it = acquired.find(lcqp);
+
+            if (it == acquired.end())
+                return INVALID_ARGUMENT;
+
+            shape = it->second;
+            acquired.erase(it);
+        }
+
+        // Reset outside of the lock (the object is owned by the caller until it is idle)
+        lcqp->reset( );
+
+        std::list<LCQProblem*> evicted;
+
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            addIdle( shape, lcqp, evicted );
+        }
+
+        for (std::list<LCQProblem*>::iterator it = evicted.begin(); it != evicted.end(); ++it)
+            delete *it;
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue LCQProblemPool::warmUp( const LCQProblemShape& shape, int number )
+    {
+        std::list<LCQProblem*> evicted;
+
+        for (int k = 0; k < number; k++) {
+            LCQProblem* lcqp = create( shape );
+
+            if (Utilities::isNullPtr(lcqp))
+                return MessageHandler::PrintMessage( INVALID_ARGUMENT, ERROR );
+
+            std::lock_guard<std::mutex> lock( mutex );
+            nCreated++;
+            addIdle( shape, lcqp, evicted );
+        }
+
+        for (std::list<LCQProblem*>::iterator it = evicted.begin(); it != evicted.end(); ++it)
+            delete *it;
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    void LCQProblemPool::clear( )
+    {
+        std::list< std::pair<LCQProblemShape, LCQProblem*> > evicted;
+
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            evicted.swap(idle);
+        }
+
+        for (std::list< std::pair<LCQProblemShape, LCQProblem*> >::iterator it = evicted.begin(); it != evicted.end(); ++it)
+            delete it->second;
+    }
+
+
+    int LCQProblemPool::getNumberOfIdle( ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return (int) idle.size();
+    }
+
+
+    int LCQProblemPool::getNumberOfIdle( const LCQProblemShape& shape ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        int number = 0;
+        for (std::list< std::pair<LCQProblemShape, LCQProblem*> >::const_iterator it = idle.begin(); it != idle.end(); ++it)
+            if (isSameShape(it->first, shape))
+                number++;
+
+        return number;
+    }
+
+
+    int LCQProblemPool::getNumberOfCreated( ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return nCreated;
+    }
+
+
+    int LCQProblemPool::getNumberOfReused( ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return nReused;
+    }
+
+
+    size_t LCQProblemPool::getFingerprint( const csc* const Q, const csc* const L, const csc* const R, const csc* const A )
+    {
+        // FNV-1a over the dimensions and index arrays of all matrices
+        size_t hash = (size_t)14695981039346656037ULL;
+        const csc* matrices[4] = { Q, L, R, A };
+
+        for (int k = 0; k < 4; k++) {
+            const csc* M = matrices[k];
+
+            size_t header[3] = { (size_t)k, 0, 0 };
+            if (Utilities::isNotNullPtr(M) && Utilities::isNotNullPtr(M->p)) {
+                header[1] = (size_t)M->m;
+                header[2] = (size_t)M->n;
+            }
+
+            for (int h = 0; h < 3; h++)
+                hash = (hash ^ header[h])*(size_t)1099511628211ULL;
+
+            if (header[2] == 0)
+                continue;
+
+            for (int j = 0; j <= M->n; j++)
+                hash = (hash ^ (size_t)M->p[j])*(size_t)1099511628211ULL;
+
+            for (int i = 0; i < M->p[M->n]; i++)
+                hash = (hash ^ (size_t)M->i[i])*(size_t)1099511628211ULL;
+        }
+
+        // 0 is reserved for dense problems
+        return hash != 0 ? hash : 1;
+    }
+
+
+    LCQProblem* LCQProblemPool::create( const LCQProblemShape& shape )
+    {
+        if (shape.nV <= 0 || shape.nC < 0 || shape.nComp <= 0)
+            return NULL;
+
+        LCQProblem* lcqp = new LCQProblem( shape.nV, shape.nC, shape.nComp );
+        Options objectOptions( options );
+
+        // Objects are solved concurrently, each one writes its own files
+        if (Utilities::isNotNullPtr(objectOptions.getDumpFile()) || Utilities::isNotNullPtr(objectOptions.getStepFile())) {
+            int id = getObjectId();
+
+            if (Utilities::isNotNullPtr(objectOptions.getDumpFile()))
+                objectOptions.setDumpFile( getObjectFile(objectOptions.getDumpFile(), id).c_str() );
+
+            if (Utilities::isNotNullPtr(objectOptions.getStepFile()))
+                objectOptions.setStepFile( getObjectFile(objectOptions.getStepFile(), id).c_str() );
+        }
+
+        lcqp->setOptions( objectOptions );
+
+        return lcqp;
+    }
+
+
+    int LCQProblemPool::getObjectId( )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return nNumbered++;
+    }
+
+
+    std::string LCQProblemPool::getObjectFile( const char* const file, int id )
+    {
+        std::string name( file );
+        std::string number = "." + std::to_string(id);
+
+        // Keep the extension (it selects the file format)
+        size_t dot = name.find_last_of('.');
+        size_t slash = name.find_last_of("/\\");
+
+        if (dot == std::string::npos || dot == 0 || (slash != std::string::npos && dot < slash + 2))
+            return name + number;
+
+        return name.insert(dot, number);
+    }
+
+
+    void LCQProblemPool::addIdle( const LCQProblemShape& shape, LCQProblem* lcqp, std::list<LCQProblem*>& evicted )
+    {
+        idle.push_front( std::make_pair(shape, lcqp) );
+
+        // Evict the least recently released object of this shape
+        int number = 0;
+        std::list< std::pair<LCQProblemShape, LCQProblem*> >::iterator oldest = idle.end();
+
+        for (std::list< std::pair<LCQProblemShape, LCQProblem*> >::iterator it = idle.begin(); it != idle.end(); ++it) {
+            if (isSameShape(it->first, shape)) {
+                number++;
+                oldest = it;
+            }
+        }
+
+        if (number > maxIdlePerShape) {
+            evicted.push_back(oldest->second);
+            idle.erase(oldest);
+        }
+
+        // Evict the least recently released objects of any shape
+        while ((int) idle.size() > maxIdle) {
+            evicted.push_back(idle.back().second);
+            idle.pop_back();
+        }
+    }
+
+
+    bool LCQProblemPool::isSameShape( const LCQProblemShape& a, const LCQProblemShape& b )
+    {
+        return a.nV == b.nV && a.nC == b.nC && a.nComp == b.nComp && a.fingerprint == b.fingerprint;
+    }
+}
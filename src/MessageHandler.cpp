@@ -22,22 +22,34 @@
 
 #include "MessageHandler.hpp"
 
+#include <stdarg.h>
+#include <stdio.h>
+#include <string>
+
 
 namespace LCQPow {
 
+    // The sink of each thread (NULL: stdout)
+    static thread_local MessageSink threadSink = NULL;
+    static thread_local void* threadSinkData = NULL;
+
+
     ReturnValue MessageHandler::PrintMessage( ReturnValue ret, MessageType type ) {
 
-        // Print the message type
+        const char* prefix = "";
+        const char* text = "";
+
+        // The message type
         switch (type) {
             case MESSAGE:
                 break;
 
             case WARNING:
-                printf("WARNING: ");
+                prefix = "WARNING: ";
                 break;
 
             case ERROR:
-                printf("ERROR: ");
+                prefix = "ERROR: ";
                 break;
             
             default:
@@ -49,163 +61,176 @@ namespace LCQPow {
                 break;
 
             case NOT_YET_IMPLEMENTED:
-                printf("This method has not yet been implemented.\n");
+                text = "This method has not yet been implemented.\n";
                 break;
 
             case LCQPOBJECT_NOT_SETUP:
-                printf("The LCQP object has not been set up correctly.\n");
+                text = "The LCQP object has not been set up correctly.\n";
                 break;
 
             case INDEX_OUT_OF_BOUNDS:
-                printf("Index out of bounds.\n");
+                text = "Index out of bounds.\n";
                 break;
 
             case SUBPROBLEM_SOLVER_ERROR:
-                printf("The subproblem solver produced an error.\n");
+                text = "The subproblem solver produced an error.\n";
                 break;
 
             case UNABLE_TO_READ_FILE:
-                printf("Unable to read file.\n");
+                text = "Unable to read file.\n";
                 break;
 
             case MAX_ITERATIONS_REACHED:
-                printf("Maximum number of iterations reached.\n");
+                text = "Maximum number of iterations reached.\n";
                 break;
 
             case MAX_PENALTY_REACHED:
-                printf("Maxium penalty value reached.\n");
+                text = "Maxium penalty value reached.\n";
                 break;
 
             case INITIAL_SUBPROBLEM_FAILED:
-                printf("Failed to solve initial QP.\n");
+                text = "Failed to solve initial QP.\n";
+                break;
+
+            case SOLVER_ABORTED_BY_CALLBACK:
+                text = "The solve was aborted by the iteration callback.\n";
+                break;
+
+            case CALLBACKS_DISABLED:
+                text = "The library was built without iteration callbacks.\n";
+                break;
+
+            case UNABLE_TO_WRITE_FILE:
+                text = "Unable to write file.\n";
                 break;
 
             case INVALID_ARGUMENT:
-                printf("Invalid argument passed.\n");
+                text = "Invalid argument passed.\n";
                 break;
 
             case INVALID_NUMBER_OF_OPTIM_VARS:
-                printf("Invalid optimization variable dimension passed (required to be > 0).\n");
+                text = "Invalid optimization variable dimension passed (required to be > 0).\n";
                 break;
 
             case INVALID_NUMBER_OF_COMP_VARS:
-                printf("Invalid complementarity dimension passed (required to be > 0).\n");
+                text = "Invalid complementarity dimension passed (required to be > 0).\n";
                 break;
 
             case INVALID_NUMBER_OF_CONSTRAINT_VARS:
-                printf("Invalid number of optimization variables passed (required to be >= 0).\n");
+                text = "Invalid number of optimization variables passed (required to be >= 0).\n";
                 break;
 
             case INVALID_QPSOLVER:
-                printf("Invalid QPSolver passed.\n");
+                text = "Invalid QPSolver passed.\n";
                 break;
 
             case INVALID_COMPLEMENTARITY_TOLERANCE:
-                printf("Ignoring invalid complementarity tolerance.\n");
+                text = "Ignoring invalid complementarity tolerance.\n";
                 break;
 
             case INVALID_INITIAL_PENALTY_VALUE:
-                printf("Invalid argument passed (initial penalty value).\n");
+                text = "Invalid argument passed (initial penalty value).\n";
                 break;
 
             case INVALID_PENALTY_UPDATE_VALUE:
-                printf("Ignoring invalid penalty update value.\n");
+                text = "Ignoring invalid penalty update value.\n";
                 break;
 
             case INVALID_MAX_ITERATIONS_VALUE:
-                printf("Ignoring invalid number of maximum iterations.\n");
+                text = "Ignoring invalid number of maximum iterations.\n";
                 break;
 
             case INVALID_MAX_RHO_VALUE:
-                printf("Ignoring invalid number of maximum penalty value.\n");
+                text = "Ignoring invalid number of maximum penalty value.\n";
                 break;
 
             case DENSE_SPARSE_MISSMATCH:
-                printf("The solver was initialized with dense (sparse) matrices but a sparse (dense) method was chosen.\n");
+                text = "The solver was initialized with dense (sparse) matrices but a sparse (dense) method was chosen.\n";
                 break;
 
             case INVALID_STATIONARITY_TOLERANCE:
-                printf("Ignoring invalid stationarity tolerance.\n");
+                text = "Ignoring invalid stationarity tolerance.\n";
                 break;
 
             case INVALID_INDEX_POINTER:
-                printf("Invalid index pointer passed in csc format.\n");
+                text = "Invalid index pointer passed in csc format.\n";
                 break;
 
             case INVALID_INDEX_ARRAY:
-                printf("Invalid index array passed in csc format.\n");
+                text = "Invalid index array passed in csc format.\n";
                 break;
 
             case INVALID_OSQP_BOX_CONSTRAINTS:
-                printf("Invalid constraints passed to OSQP solver: This solver does not handle box constraints, please pass them through linear constraints.\n");
+                text = "Invalid constraints passed to OSQP solver: This solver does not handle box constraints, please pass them through linear constraints.\n";
                 break;
 
             case INVALID_TOTAL_ITER_COUNT:
-                printf("Invalid total number of iterations delta passed to output statistics (must be non-negative integer).\n");
+                text = "Invalid total number of iterations delta passed to output statistics (must be non-negative integer).\n";
                 break;
 
             case INVALID_TOTAL_OUTER_ITER:
-                printf("Invalid total number of outer iterations delta passed to output statistics (must be non-negative integer).\n");
+                text = "Invalid total number of outer iterations delta passed to output statistics (must be non-negative integer).\n";
                 break;
 
             case IVALID_SUBPROBLEM_ITER:
-                printf("Invalid total number of subproblem solver iterates delta passed to output statistics (must be non-negative integer).\n");
+                text = "Invalid total number of subproblem solver iterates delta passed to output statistics (must be non-negative integer).\n";
                 break;
 
             case INVALID_RHO_OPT:
-                printf("Invalid rho value at solution passed to output statistics (must be positive double).\n");
+                text = "Invalid rho value at solution passed to output statistics (must be positive double).\n";
                 break;
 
             case INVALID_PRINT_LEVEL_VALUE:
-                printf("Ignoring invalid integer to be parsed to print level passed (must be in range of enum).\n");
+                text = "Ignoring invalid integer to be parsed to print level passed (must be in range of enum).\n";
                 break;
 
             case INVALID_OBJECTIVE_LINEAR_TERM:
-                printf("Invalid objective linear term passed (must be a double array of length n).\n");
+                text = "Invalid objective linear term passed (must be a double array of length n).\n";
                 break;
 
             case INVALID_CONSTRAINT_MATRIX:
-                printf("Invalid constraint matrix passed (matrix was null pointer but number of constraints is positive).\n");
+                text = "Invalid constraint matrix passed (matrix was null pointer but number of constraints is positive).\n";
                 break;
 
             case INVALID_COMPLEMENTARITY_MATRIX:
-                printf("Invalid complementarity matrix passed (can not be null pointer).\n");
+                text = "Invalid complementarity matrix passed (can not be null pointer).\n";
                 break;
 
             case INVALID_ETA_VALUE:
-                printf("Invalid etaDynamicPenalty value, which describes the fraction of loss required for complementarity progress (must be in (0,1)).");
+                text = "Invalid etaDynamicPenalty value, which describes the fraction of loss required for complementarity progress (must be in (0,1)).";
                 break;
 
             case OSQP_INITIAL_PRIMAL_GUESS_FAILED:
-                printf("OSQP failed to use the primal initial guess.\n");
+                text = "OSQP failed to use the primal initial guess.\n";
                 break;
 
             case OSQP_INITIAL_DUAL_GUESS_FAILED:
-                printf("OSQP failed to use the dual initial guess.\n");
+                text = "OSQP failed to use the dual initial guess.\n";
                 break;
 
             case INVALID_LOWER_COMPLEMENTARITY_BOUND:
-                printf("Lower complementarity bound must be bounded below.\n");
+                text = "Lower complementarity bound must be bounded below.\n";
                 break;
 
             case FAILED_SYM_COMPLEMENTARITY_MATRIX:
-                printf("Failed to compute the symmetric complementarity matrix C.\n");
+                text = "Failed to compute the symmetric complementarity matrix C.\n";
                 break;
 
             case FAILED_SWITCH_TO_SPARSE:
-                printf("Failed to switch to sparse mode (a to be created sparse matrix was nullpointer).\n");
+                text = "Failed to switch to sparse mode (a to be created sparse matrix was nullpointer).\n";
                 break;
 
             case FAILED_SWITCH_TO_DENSE:
-                printf("Failed to switch to dense mode (an array to be created was nullpointer).\n");
+                text = "Failed to switch to dense mode (an array to be created was nullpointer).\n";
                 break;
 
             case OSQP_WORKSPACE_NOT_SET_UP:
-                printf("OSQP Workspace is not set up (please check for OSQP errors).\n");
+                text = "OSQP Workspace is not set up (please check for OSQP errors).\n";
                 break;
         }
 
-        fflush(stdout);
+        if (prefix[0] != '\0' || text[0] != '\0')
+            Print("%s%s", prefix, text);
 
         return ret;
     }
@@ -213,35 +238,87 @@ namespace LCQPow {
 
     AlgorithmStatus MessageHandler::PrintSolution( AlgorithmStatus algoStat ) {
 
-        if ( algoStat != PROBLEM_NOT_SOLVED)
-            printf("\n\n#################################\n");
+        const char* text = "";
 
         switch (algoStat) {
             case PROBLEM_NOT_SOLVED:
-                printf("The LCQP has not been solved.\n");
+                text = "The LCQP has not been solved.\n";
                 break;
 
             case W_STATIONARY_SOLUTION:
-                printf("## W-Stationary solution found ##\n");
+                text = "## W-Stationary solution found ##\n";
                 break;
 
             case C_STATIONARY_SOLUTION:
-                printf("## C-Stationary solution found ##\n");
+                text = "## C-Stationary solution found ##\n";
                 break;
 
             case M_STATIONARY_SOLUTION:
-                printf("## M-Stationary solution found ##\n");
+                text = "## M-Stationary solution found ##\n";
                 break;
 
             case S_STATIONARY_SOLUTION:
-                printf("## S-Stationary solution found ##\n");
+                text = "## S-Stationary solution found ##\n";
                 break;
         }
 
         if ( algoStat != PROBLEM_NOT_SOLVED)
-            printf("#################################\n\n");
+            Print("\n\n#################################\n%s#################################\n\n", text);
+        else
+            Print("%s", text);
 
         return algoStat;
     }
+
+
+    void MessageHandler::Print( const char* format, ... ) {
+
+        // Format the complete message first (most messages fit into the buffer on the stack)
+        char buffer[512];
+        std::string large;
+        const char* message = buffer;
+
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        if (length < 0)
+            return;
+
+        if ((size_t)length >= sizeof(buffer)) {
+            large.resize((size_t)length + 1);
+
+            va_start(args, format);
+            vsnprintf(&large[0], large.size(), format, args);
+            va_end(args);
+
+            message = large.c_str();
+        }
+
+        if (threadSink != NULL) {
+            threadSink(message, threadSinkData);
+            return;
+        }
+
+        // A single call, i.e. stdio's stream lock keeps the message in one piece
+        fputs(message, stdout);
+        fflush(stdout);
+    }
+
+
+    void MessageHandler::SetMessageSink( MessageSink sink, void* userData ) {
+        threadSink = sink;
+        threadSinkData = sink != NULL ? userData : NULL;
+    }
+
+
+    void MessageHandler::GetMessageSink( MessageSink* sink, void** userData ) {
+        if (sink != NULL)
+            *sink = threadSink;
+
+        if (userData != NULL)
+            *userData = threadSinkData;
+    }
 }
 
@@ -64,12 +64,17 @@ namespace LCQPow {
         penaltyUpdateFactor = rhs.penaltyUpdateFactor;
         solveZeroPenaltyFirst = rhs.solveZeroPenaltyFirst;
         perturbStep = rhs.perturbStep;
+        randomSeed = rhs.randomSeed;
         maxIterations = rhs.maxIterations;
         maxPenaltyParameter = rhs.maxPenaltyParameter;
         nDynamicPenalty = rhs.nDynamicPenalty;
         etaDynamicPenalty = rhs.etaDynamicPenalty;
         printLevel = rhs.printLevel;
         storeSteps = rhs.storeSteps;
+        stepFile = rhs.stepFile;
+        stepStorage = rhs.stepStorage;
+        stepStorageSize = rhs.stepStorageSize;
+        dumpFile = rhs.dumpFile;
         qpSolver = rhs.qpSolver;
         qpOASES_opts = rhs.qpOASES_opts;
 
@@ -155,6 +160,17 @@ namespace LCQPow {
     }
 
 
+    unsigned int Options::getRandomSeed( ) {
+        return randomSeed;
+    }
+
+
+    ReturnValue Options::setRandomSeed( unsigned int val ) {
+        randomSeed = val;
+        return ReturnValue::SUCCESSFUL_RETURN;
+    }
+
+
     int Options::getMaxIterations( ) {
         return maxIterations;
     }
@@ -239,6 +255,62 @@ namespace LCQPow {
     }
 
 
+    const char* Options::getStepFile( ) {
+        return stepFile.empty() ? NULL : stepFile.c_str();
+    }
+
+
+    ReturnValue Options::setStepFile( const char* val ) {
+        stepFile = Utilities::isNotNullPtr(val) ? val : "";
+        return ReturnValue::SUCCESSFUL_RETURN;
+    }
+
+
+    StepStorage Options::getStepStorage( ) {
+        return stepStorage;
+    }
+
+
+    ReturnValue Options::setStepStorage( StepStorage val ) {
+        stepStorage = val;
+        return ReturnValue::SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue Options::setStepStorage( int val ) {
+        if (val < StepStorage::STORE_ALL_STEPS || val > StepStorage::STORE_SAMPLED_STEPS)
+            return (MessageHandler::PrintMessage(INVALID_ARGUMENT,WARNING));
+
+        stepStorage = (StepStorage) val;
+        return ReturnValue::SUCCESSFUL_RETURN;
+    }
+
+
+    int Options::getStepStorageSize( ) {
+        return stepStorageSize;
+    }
+
+
+    ReturnValue Options::setStepStorageSize( int val ) {
+        if (val < 1)
+            return (MessageHandler::PrintMessage(INVALID_ARGUMENT,WARNING));
+
+        stepStorageSize = val;
+        return ReturnValue::SUCCESSFUL_RETURN;
+    }
+
+
+    const char* Options::getDumpFile( ) {
+        return dumpFile.empty() ? NULL : dumpFile.c_str();
+    }
+
+
+    ReturnValue Options::setDumpFile( const char* val ) {
+        dumpFile = Utilities::isNotNullPtr(val) ? val : "";
+        return ReturnValue::SUCCESSFUL_RETURN;
+    }
+
+
     QPSolver Options::getQPSolver( ) {
         return qpSolver;
     }
@@ -302,6 +374,7 @@ namespace LCQPow {
         solveZeroPenaltyFirst = true;
 
         perturbStep = true;
+        randomSeed = 0;
 
         maxIterations = 1000;
         maxPenaltyParameter = 1e8;
@@ -313,6 +386,12 @@ namespace LCQPow {
 
         storeSteps = false;
 
+        stepFile.clear();
+        dumpFile.clear();
+
+        stepStorage = StepStorage::STORE_ALL_STEPS;
+        stepStorageSize = 100;
+
         qpSolver = QPSolver::QPOASES_DENSE;
 
 		// Initialize some deault subproblem solver options
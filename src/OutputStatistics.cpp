@@ -21,6 +21,7 @@
 
 
 #include "OutputStatistics.hpp"
+#include <algorithm>
 #include <vector>
 
 namespace LCQPow {
@@ -37,7 +38,16 @@ namespace LCQPow {
         status = rhs.status;
         qpSolver_exit_flag = rhs.qpSolver_exit_flag;        
 
+        for (int k = 0; k < NUMBER_OF_PHASES; k++)
+            phaseTimes[k] = rhs.phaseTimes[k];
+
+        timeTotal = rhs.timeTotal;
+
         xSteps = rhs.xSteps;
+        xStepIters = rhs.xStepIters;
+        xStepLength = rhs.xStepLength;
+        xStepCapacity = rhs.xStepCapacity;
+        xStepFirst = rhs.xStepFirst;
 
         innerIters = rhs.innerIters;
         subproblemIters = rhs.subproblemIters;
@@ -48,6 +58,11 @@ namespace LCQPow {
         objVals = rhs.objVals;
         phiVals = rhs.phiVals;
         meritVals = rhs.meritVals;
+        subproblemTimes = rhs.subproblemTimes;
+        subproblemRhoUpdates = rhs.subproblemRhoUpdates;
+        subproblemFactorizations = rhs.subproblemFactorizations;
+        subproblemPrimalResiduals = rhs.subproblemPrimalResiduals;
+        subproblemDualResiduals = rhs.subproblemDualResiduals;
 
         return *this;
     }
@@ -62,10 +77,16 @@ namespace LCQPow {
         status = PROBLEM_NOT_SOLVED;
         qpSolver_exit_flag = 0;
 
-        for (size_t i = 0; i < xSteps.size(); i++) 
-            xSteps[i].clear();
+        for (int k = 0; k < NUMBER_OF_PHASES; k++)
+            phaseTimes[k] = 0.0;
+
+        timeTotal = 0.0;
 
+        // Keeps the capacity of the stored iterates for the next solve
         xSteps.clear();
+        xStepIters.clear();
+        xStepLength = 0;
+        xStepFirst = 0;
         innerIters.clear();
         subproblemIters.clear();
         accuSubproblemIters.clear();
@@ -75,6 +96,22 @@ namespace LCQPow {
         objVals.clear();
         phiVals.clear();
         meritVals.clear();
+        subproblemTimes.clear();
+        subproblemRhoUpdates.clear();
+        subproblemFactorizations.clear();
+        subproblemPrimalResiduals.clear();
+        subproblemDualResiduals.clear();
+    }
+
+
+    void OutputStatistics::setStepCapacity( int capacity )
+    {
+        xStepCapacity = capacity > 0 ? capacity : 0;
+
+        xSteps.clear();
+        xStepIters.clear();
+        xStepLength = 0;
+        xStepFirst = 0;
     }
 
 
@@ -128,6 +165,24 @@ namespace LCQPow {
     }
 
 
+    ReturnValue OutputStatistics::updatePhaseTime( SolverPhase phase, double seconds )
+    {
+        if (phase < 0 || phase >= NUMBER_OF_PHASES || seconds < 0) return INVALID_ARGUMENT;
+
+        phaseTimes[phase] += seconds;
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue OutputStatistics::updateTimeTotal( double seconds )
+    {
+        if (seconds < 0) return INVALID_ARGUMENT;
+
+        timeTotal += seconds;
+        return SUCCESSFUL_RETURN;
+    }
+
+
     ReturnValue OutputStatistics::updateTrackingVectors(
                 double* thisxSteps,  
                 int thisInnerIter,
@@ -141,10 +196,23 @@ namespace LCQPow {
                 int nV
             )
     {
-        std::vector<double> xkStored;
-        for (int i = 0; i < nV; i++)
-            xkStored.push_back(thisxSteps[i]);
-        xSteps.push_back(xkStored);
+        if (Utilities::isNotNullPtr(thisxSteps)) {
+            if (xStepIters.size() == 0)
+                xStepLength = nV;
+
+            if (nV != xStepLength)
+                return INVALID_ARGUMENT;
+
+            if (xStepCapacity == 0 || (int)xStepIters.size() < xStepCapacity) {
+                xSteps.insert(xSteps.end(), thisxSteps, thisxSteps + nV);
+                xStepIters.push_back(getNumberOfTrackedSteps());
+            } else {
+                // Overwrite the oldest iterate
+                std::copy(thisxSteps, thisxSteps + nV, xSteps.begin() + (size_t)xStepFirst*nV);
+                xStepIters[(size_t)xStepFirst] = getNumberOfTrackedSteps();
+                xStepFirst = (xStepFirst + 1) % xStepCapacity;
+            }
+        }
 
         innerIters.push_back(thisInnerIter);
         subproblemIters.push_back(thisSubproblemIter);
@@ -164,6 +232,24 @@ namespace LCQPow {
     }
 
 
+    ReturnValue OutputStatistics::updateSubproblemTrackingVectors(
+                double solveTime,
+                int rhoUpdates,
+                int factorizations,
+                double primalResidual,
+                double dualResidual
+            )
+    {
+        subproblemTimes.push_back(solveTime);
+        subproblemRhoUpdates.push_back(rhoUpdates);
+        subproblemFactorizations.push_back(factorizations);
+        subproblemPrimalResiduals.push_back(primalResidual);
+        subproblemDualResiduals.push_back(dualResidual);
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
     int OutputStatistics::getIterTotal( ) const
     {
         return iterTotal;
@@ -200,6 +286,21 @@ namespace LCQPow {
     }
 
 
+    double OutputStatistics::getPhaseTime( SolverPhase phase ) const
+    {
+        if (phase < 0 || phase >= NUMBER_OF_PHASES)
+            return 0.0;
+
+        return phaseTimes[phase];
+    }
+
+
+    double OutputStatistics::getTimeTotal( ) const
+    {
+        return timeTotal;
+    }
+
+
     int* OutputStatistics::getInnerIters( ) const
     {
         if(innerIters.size() == 0)
@@ -369,9 +470,90 @@ namespace LCQPow {
     }
 
 
+    int OutputStatistics::getNumberOfTrackedSteps( ) const
+    {
+        return (int)statVals.size();
+    }
+
+
+    int OutputStatistics::getNumberOfxSteps( ) const
+    {
+        return (int)xStepIters.size();
+    }
+
+
+    int OutputStatistics::getxStepLength( ) const
+    {
+        return xStepLength;
+    }
+
+
+    const double* OutputStatistics::getxStep( int k ) const
+    {
+        if (k < 0 || k >= getNumberOfxSteps())
+            return NULL;
+
+        size_t slot = (size_t)((xStepFirst + k) % getNumberOfxSteps());
+        return xSteps.data() + slot*(size_t)xStepLength;
+    }
+
+
+    int OutputStatistics::getxStepIter( int k ) const
+    {
+        if (k < 0 || k >= getNumberOfxSteps())
+            return -1;
+
+        return xStepIters[(size_t)((xStepFirst + k) % getNumberOfxSteps())];
+    }
+
+
+    std::vector<int> OutputStatistics::getxStepItersStdVec( ) const
+    {
+        std::vector<int> iters((size_t)getNumberOfxSteps());
+        for (int k = 0; k < getNumberOfxSteps(); k++)
+            iters[(size_t)k] = getxStepIter(k);
+
+        return iters;
+    }
+
+
     std::vector<std::vector<double>> OutputStatistics::getxStepsStdVec( ) const
     {
-        return xSteps;
+        std::vector<std::vector<double>> steps((size_t)getNumberOfxSteps());
+        for (int k = 0; k < getNumberOfxSteps(); k++)
+            steps[(size_t)k].assign(getxStep(k), getxStep(k) + xStepLength);
+
+        return steps;
+    }
+
+
+    std::vector<double> OutputStatistics::getSubproblemTimesStdVec( ) const
+    {
+        return subproblemTimes;
+    }
+
+
+    std::vector<int> OutputStatistics::getSubproblemRhoUpdatesStdVec( ) const
+    {
+        return subproblemRhoUpdates;
+    }
+
+
+    std::vector<int> OutputStatistics::getSubproblemFactorizationsStdVec( ) const
+    {
+        return subproblemFactorizations;
+    }
+
+
+    std::vector<double> OutputStatistics::getSubproblemPrimalResidualsStdVec( ) const
+    {
+        return subproblemPrimalResiduals;
+    }
+
+
+    std::vector<double> OutputStatistics::getSubproblemDualResidualsStdVec( ) const
+    {
+        return subproblemDualResiduals;
     }
 
 }
@@ -22,6 +22,7 @@
 #include "Subsolver.hpp"
 #include "MessageHandler.hpp"
 #include <cstring>
+#include <utility>
 
 extern "C" {
     #include <osqp.h>
@@ -34,28 +35,17 @@ namespace LCQPow {
 
 
     Subsolver::Subsolver(   int nV, int nC,
-                            double* Q, double* A )
+                            const double* const Q, const double* const A )
     {
-        qpSolver = QPSolver::QPOASES_DENSE;
-
-        SubsolverQPOASES tmp(nV, nC, Q, A);
-        solverQPOASES = tmp;
+        setUp(nV, nC, Q, A);
     }
 
 
     Subsolver::Subsolver(   int nV, int nC,
-                            csc* Q, csc* A,
+                            const csc* const Q, const csc* const A,
                             QPSolver _qpSolver )
     {
-        qpSolver = _qpSolver;
-
-        if (qpSolver == QPSolver::QPOASES_SPARSE) {
-            SubsolverQPOASES tmp(nV, nC, Q, A);
-            solverQPOASES = tmp;
-        } else if (qpSolver == QPSolver::OSQP_SPARSE) {
-            SubsolverOSQP tmp(Q, A);
-            solverOSQP = tmp;
-        } else {
+        if (setUp(nV, nC, Q, A, _qpSolver) != SUCCESSFUL_RETURN) {
             MessageHandler::PrintMessage( INVALID_QPSOLVER, ERROR );
 
             // Must abort here (since we can't return an error).
@@ -70,6 +60,12 @@ namespace LCQPow {
     }
 
 
+    Subsolver::Subsolver(Subsolver&& rhs)
+    {
+        move( rhs );
+    }
+
+
     Subsolver& Subsolver::operator=(const Subsolver& rhs)
     {
         if ( this != &rhs )
@@ -81,6 +77,95 @@ namespace LCQPow {
     }
 
 
+    Subsolver& Subsolver::operator=(Subsolver&& rhs)
+    {
+        if ( this != &rhs )
+            {
+                move( rhs );
+            }
+
+        return *this;
+    }
+
+
+    void Subsolver::setUp( int nV, int nC, const double* const Q, const double* const A )
+    {
+        // Release the workspace of a previous OSQP set up
+        if (qpSolver == QPSolver::OSQP_SPARSE)
+            solverOSQP.clear();
+
+        qpSolver = QPSolver::QPOASES_DENSE;
+
+        solverQPOASES.setUp(nV, nC, Q, A);
+    }
+
+
+    ReturnValue Subsolver::setUp( int nV, int nC, const csc* const Q, const csc* const A, QPSolver _qpSolver )
+    {
+        if (_qpSolver == QPSolver::QPOASES_SPARSE) {
+            // Release the workspace of a previous OSQP set up
+            if (qpSolver == QPSolver::OSQP_SPARSE)
+                solverOSQP.clear();
+
+            solverQPOASES.setUp(nV, nC, Q, A);
+        } else if (_qpSolver == QPSolver::OSQP_SPARSE) {
+            // Release the data and QP sequence of a previous qpOASES set up
+            if (qpSolver != QPSolver::OSQP_SPARSE)
+                solverQPOASES = SubsolverQPOASES();
+
+            solverOSQP.setUp(Q, A);
+        } else {
+            return INVALID_QPSOLVER;
+        }
+
+        qpSolver = _qpSolver;
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    bool Subsolver::updateMatrices( int nV, int nC, const double* const Q, const double* const A )
+    {
+        if (qpSolver != QPSolver::QPOASES_DENSE)
+            return false;
+
+        return solverQPOASES.updateMatrices(nV, nC, Q, A);
+    }
+
+
+    bool Subsolver::updateMatrices( int nV, int nC, const csc* const Q, const csc* const A, QPSolver _qpSolver )
+    {
+        if (qpSolver != _qpSolver)
+            return false;
+
+        if (qpSolver == QPSolver::QPOASES_SPARSE)
+            return solverQPOASES.updateMatrices(nV, nC, Q, A);
+
+        if (qpSolver == QPSolver::OSQP_SPARSE)
+            return solverOSQP.updateMatrices(Q, A);
+
+        return false;
+    }
+
+
+    int Subsolver::getNumberOfSetups( ) const
+    {
+        if (qpSolver == QPSolver::OSQP_SPARSE)
+            return solverOSQP.getNumberOfSetups();
+
+        return 0;
+    }
+
+
+    void Subsolver::getSolveStatistics( int& rhoUpdates, int& factorizations ) const
+    {
+        if (qpSolver == QPSolver::OSQP_SPARSE)
+            solverOSQP.getSolveStatistics( rhoUpdates, factorizations );
+        else
+            solverQPOASES.getSolveStatistics( rhoUpdates, factorizations );
+    }
+
+
     void Subsolver::getSolution( double* x, double* y )
     {
         if (qpSolver == QPSolver::QPOASES_DENSE || qpSolver == QPSolver::QPOASES_SPARSE) {
@@ -127,11 +212,18 @@ namespace LCQPow {
         qpSolver = rhs.qpSolver;
 
         if (qpSolver == QPSolver::QPOASES_DENSE || qpSolver == QPSolver::QPOASES_SPARSE) {
-            SubsolverQPOASES tmp( rhs.solverQPOASES );
-            solverQPOASES = tmp;
+            solverQPOASES = rhs.solverQPOASES;
         } else if (qpSolver == QPSolver::OSQP_SPARSE) {
-            SubsolverOSQP tmp( rhs.solverOSQP );
-            solverOSQP = tmp;
+            solverOSQP = rhs.solverOSQP;
         }
     }
+
+
+    void Subsolver::move(Subsolver& rhs)
+    {
+        qpSolver = rhs.qpSolver;
+
+        solverQPOASES = std::move(rhs.solverQPOASES);
+        solverOSQP = std::move(rhs.solverOSQP);
+    }
 }
\ No newline at end of file
@@ -25,6 +25,8 @@ extern "C" {
     #include <osqp.h>
 }
 
+#include <vector>
+
 
 namespace LCQPow {
     SubsolverOSQP::SubsolverOSQP( ) {
@@ -36,19 +38,82 @@ namespace LCQPow {
 
     SubsolverOSQP::SubsolverOSQP(   const csc* const _Q, const csc* const _A)
     {
+        setUp(_Q, _A);
+    }
+
+
+    SubsolverOSQP::SubsolverOSQP(const SubsolverOSQP& rhs)
+    {
+        copy( rhs );
+    }
+
+
+    SubsolverOSQP::SubsolverOSQP(SubsolverOSQP&& rhs)
+    {
+        move( rhs );
+    }
+
+
+    void SubsolverOSQP::setUp( const csc* const _Q, const csc* const _A )
+    {
+        clear();
+
         // Store dimensions
         nV = _Q->n;
         nC = _A->m;
 
-        // Copy matrices
+        // OSQP expects the upper triangular part of Q
         Q = Utilities::copyCSC(_Q, true);
-        A = Utilities::copyCSC(_A);
+
+        // The constraint matrix is copied by osqp_setup anyways
+        A = _A;
     }
 
 
-    SubsolverOSQP::SubsolverOSQP(const SubsolverOSQP& rhs)
+    bool SubsolverOSQP::updateMatrices( const csc* const _Q, const csc* const _A )
     {
-        copy( rhs );
+        // Requires a workspace of the same dimensions
+        if (Utilities::isNullPtr(work) || Utilities::isNullPtr(settings) || _Q->n != nV || _A->m != nC)
+            return false;
+
+        // OSQP keeps its own copy of A
+        const csc* const A_work = work->data->A;
+
+        if (!Utilities::hasPattern(_A, nC, nV, A_work->p, A_work->i))
+            return false;
+
+        // Q holds the upper triangular part of the Hessian
+        int k = 0;
+
+        for (int j = 0; j < nV; j++) {
+            for (int l = _Q->p[j]; l < _Q->p[j+1]; l++) {
+                if (_Q->i[l] > j)
+                    continue;
+
+                if (k >= Q->p[j+1] || Q->i[k] != _Q->i[l])
+                    return false;
+
+                k++;
+            }
+
+            if (k != Q->p[j+1])
+                return false;
+        }
+
+        k = 0;
+
+        for (int j = 0; j < nV; j++) {
+            for (int l = _Q->p[j]; l < _Q->p[j+1]; l++) {
+                if (_Q->i[l] <= j)
+                    Q->x[k++] = _Q->x[l];
+            }
+        }
+
+        A = _A;
+        data->A = const_cast<csc*>(A);
+        matricesUpdated = true;
+
+        return true;
     }
 
 
@@ -60,7 +125,31 @@ namespace LCQPow {
 
     void SubsolverOSQP::clear()
     {
-        osqp_cleanup(work);
+        clearWorkspace();
+
+        if (Utilities::isNotNullPtr(Q)) {
+            Utilities::ClearSparseMat(Q);
+            Q = NULL;
+        }
+
+        // The constraint matrix is borrowed
+        A = NULL;
+
+        if (Utilities::isNotNullPtr(settings)) {
+            c_free(settings);
+            settings = NULL;
+        }
+    }
+
+
+    void SubsolverOSQP::clearWorkspace()
+    {
+        matricesUpdated = false;
+
+        if (Utilities::isNotNullPtr(work)) {
+            osqp_cleanup(work);
+            work = NULL;
+        }
 
         if (Utilities::isNotNullPtr(data)) {
             if (Utilities::isNotNullPtr(data->l)) {
@@ -81,34 +170,42 @@ namespace LCQPow {
             c_free(data);
             data = NULL;
         }
+    }
 
-        if (Utilities::isNotNullPtr(Q)) {
-            Utilities::ClearSparseMat(Q);
-            Q = NULL;
-        }
 
-        if (Utilities::isNotNullPtr(A)) {
-            Utilities::ClearSparseMat(A);
-            A = NULL;
+    SubsolverOSQP& SubsolverOSQP::operator=(const SubsolverOSQP& rhs)
+    {
+        if (this != &rhs) {
+            copy( rhs );
         }
 
-        if (Utilities::isNotNullPtr(settings)) {
-            c_free(settings);
-            settings = NULL;
-        }
+        return *this;
     }
 
 
-    SubsolverOSQP& SubsolverOSQP::operator=(const SubsolverOSQP& rhs)
+    SubsolverOSQP& SubsolverOSQP::operator=(SubsolverOSQP&& rhs)
     {
         if (this != &rhs) {
-            copy( rhs );
+            move( rhs );
         }
 
         return *this;
     }
 
 
+    int SubsolverOSQP::getNumberOfSetups( ) const
+    {
+        return numberOfSetups;
+    }
+
+
+    void SubsolverOSQP::getSolveStatistics( int& rhoUpdates, int& factorizations ) const
+    {
+        rhoUpdates = lastRhoUpdates;
+        factorizations = lastFactorizations;
+    }
+
+
     void SubsolverOSQP::setOptions( OSQPSettings* _settings )
     {
         if (Utilities::isNotNullPtr(settings)) {
@@ -132,8 +229,28 @@ namespace LCQPow {
             return ReturnValue::INVALID_OSQP_BOX_CONSTRAINTS;
         }
 
-        // Setup workspace on initial solve
-        if (initialSolve) {
+        if (initialSolve && matricesUpdated) {
+            matricesUpdated = false;
+
+            // Only the numeric factorization is computed again, the workspace is kept
+            if (osqp_update_P_A(work, Q->x, OSQP_NULL, Q->p[nV], A->x, OSQP_NULL, A->p[nV]) != 0)
+                return ReturnValue::SUBPROBLEM_SOLVER_ERROR;
+
+            // Start like a new workspace: initial step size, new data and the initial guess (or zero)
+            if (osqp_update_rho(work, settings->rho) != 0 || osqp_update_lin_cost(work, _g) != 0 || osqp_update_bounds(work, _lbA, _ubA) != 0)
+                return ReturnValue::SUBPROBLEM_SOLVER_ERROR;
+
+            std::vector<double> zeros((size_t)(nV + nC), 0.0);
+
+            if (osqp_warm_start_x(work, Utilities::isNotNullPtr(x0) ? x0 : zeros.data()) != 0)
+                return ReturnValue::OSQP_INITIAL_PRIMAL_GUESS_FAILED;
+
+            if (osqp_warm_start_y(work, Utilities::isNotNullPtr(y0) ? y0 : zeros.data()) != 0)
+                return ReturnValue::OSQP_INITIAL_DUAL_GUESS_FAILED;
+        } else if (initialSolve) {
+            // Setup workspace on initial solve (a previous QP sequence is discarded)
+            clearWorkspace();
+
             double* l = (double*)malloc((size_t)nC*sizeof(double));
             double* u = (double*)malloc((size_t)nC*sizeof(double));
             double* g = (double*)malloc((size_t)nV*sizeof(double));
@@ -145,11 +262,16 @@ namespace LCQPow {
             data->n = nV;
             data->m = nC;
             data->P = Q;
-            data->A = A;
+            data->A = const_cast<csc*>(A);
             data->q = g;
             data->l = l;
             data->u = u;
-            osqp_setup(&work, data, settings);
+            if (osqp_setup(&work, data, settings) != 0) {
+                clearWorkspace();
+                return ReturnValue::OSQP_WORKSPACE_NOT_SET_UP;
+            }
+
+            numberOfSetups++;
 
             if (Utilities::isNotNullPtr(x0))
                 if (osqp_warm_start_x(work, x0) != 0)
@@ -160,13 +282,13 @@ namespace LCQPow {
                 if (osqp_warm_start_y(work, y0) != 0)
                     return ReturnValue::OSQP_INITIAL_DUAL_GUESS_FAILED;
         } else {
-            // Update linear cost and bounds
-            osqp_update_lin_cost(work, _g);
-            osqp_update_bounds(work, _lbA, _ubA);
-        }
+            // Hotstarts continue the workspace of a previous initial solve
+            if (Utilities::isNullPtr(work))
+                return ReturnValue::OSQP_WORKSPACE_NOT_SET_UP;
 
-        if (work == 0) {
-            return ReturnValue::OSQP_WORKSPACE_NOT_SET_UP;
+            // Update linear cost and bounds (OSQP would solve with the previous data otherwise)
+            if (osqp_update_lin_cost(work, _g) != 0 || osqp_update_bounds(work, _lbA, _ubA) != 0)
+                return ReturnValue::SUBPROBLEM_SOLVER_ERROR;
         }
 
         // Solve Problem
@@ -176,6 +298,10 @@ namespace LCQPow {
         iterations = work->info->iter;
         exit_flag = work->info->status_val;
 
+        // Each rho update refactorizes the KKT matrix
+        lastRhoUpdates = work->info->rho_updates;
+        lastFactorizations = (initialSolve ? 1 : 0) + lastRhoUpdates;
+
         // Either pass error
         if (errorflag != 0 || exit_flag <= 0)
             return ReturnValue::SUBPROBLEM_SOLVER_ERROR;
@@ -206,9 +332,12 @@ namespace LCQPow {
 
         nV = rhs.nV;
         nC = rhs.nC;
+        numberOfSetups = 0;
 
-        Q = copy_csc_mat(rhs.Q);
-        A = copy_csc_mat(rhs.A);
+        if (Utilities::isNotNullPtr(rhs.Q))
+            Q = copy_csc_mat(rhs.Q);
+
+        A = rhs.A;
 
         setOptions(rhs.settings);
 
@@ -224,12 +353,33 @@ namespace LCQPow {
             data->n = nV;
             data->m = nC;
             data->P = Q;
-            data->A = A;
+            data->A = const_cast<csc*>(A);
             data->q = g;
             data->l = l;
             data->u = u;
 
             osqp_setup(&work, data, settings);
+            numberOfSetups++;
         }
     }
+
+
+    void SubsolverOSQP::move(SubsolverOSQP& rhs)
+    {
+        clear();
+
+        nV = rhs.nV;
+        nC = rhs.nC;
+
+        // Take over the workspace (the OSQP data keeps pointing to the same matrices)
+        work = rhs.work; rhs.work = NULL;
+        settings = rhs.settings; rhs.settings = NULL;
+        data = rhs.data; rhs.data = NULL;
+
+        Q = rhs.Q; rhs.Q = NULL;
+        A = rhs.A; rhs.A = NULL;
+
+        numberOfSetups = rhs.numberOfSetups;
+        matricesUpdated = rhs.matricesUpdated;
+    }
 }
\ No newline at end of file
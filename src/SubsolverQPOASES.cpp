@@ -30,25 +30,80 @@ namespace LCQPow {
 
 
     SubsolverQPOASES::SubsolverQPOASES( int _nV, int _nC,
-                                        double* _Q, double* _A)
+                                        const double* const _Q, const double* const _A)
     {
+        setUp(_nV, _nC, _Q, _A);
+    }
+
+
+    SubsolverQPOASES::SubsolverQPOASES( int _nV, int _nC,
+                                        const csc* const _Q, const csc* const _A)
+    {
+        setUp(_nV, _nC, _Q, _A);
+    }
+
+
+    SubsolverQPOASES::SubsolverQPOASES(const SubsolverQPOASES& rhs)
+    {
+        copy( rhs );
+    }
+
+
+    SubsolverQPOASES::SubsolverQPOASES(SubsolverQPOASES&& rhs)
+    {
+        move( rhs );
+    }
+
+
+    SubsolverQPOASES::~SubsolverQPOASES()
+    {
+        clear();
+    }
+
+
+    SubsolverQPOASES& SubsolverQPOASES::operator=(const SubsolverQPOASES& rhs)
+    {
+        if (this != &rhs) {
+            copy( rhs );
+        }
+
+        return *this;
+    }
+
+
+    SubsolverQPOASES& SubsolverQPOASES::operator=(SubsolverQPOASES&& rhs)
+    {
+        if (this != &rhs) {
+            move( rhs );
+        }
+
+        return *this;
+    }
+
+
+    void SubsolverQPOASES::setUp( int _nV, int _nC, const double* const _Q, const double* const _A )
+    {
+        clear();
+
         nV = _nV;
         nC = _nC;
 
         isSparse = false;
-        qp = qpOASES::QProblem(nV, nC);
+        useSchur = false;
+        qp = new qpOASES::QProblem(nV, nC);
 
         Q = new double[nV*nV];
-        A = new double[nC*nV];
-
         memcpy(Q, _Q, (size_t)(nV*nV)*sizeof(double));
-        memcpy(A, _A, (size_t)(nC*nV)*sizeof(double));
+
+        // The constraint matrix is only read by qpOASES (no copy required)
+        A = _A;
     }
 
 
-    SubsolverQPOASES::SubsolverQPOASES( int _nV, int _nC,
-                                        csc* _Q, csc* _A)
+    void SubsolverQPOASES::setUp( int _nV, int _nC, const csc* const _Q, const csc* const _A )
     {
+        clear();
+
         nV = _nV;
         nC = _nC;
 
@@ -61,19 +116,9 @@ namespace LCQPow {
         #endif
 
         if (useSchur) {
-            qpSchur = qpOASES::SQProblemSchur(nV, nC);
+            qpSchur = new qpOASES::SQProblemSchur(nV, nC);
         } else {
-            qp = qpOASES::QProblem(nV, nC);
-        }
-
-        if (Utilities::isNotNullPtr(Q_sparse)) {
-            free(Q_sparse);
-            Q_sparse = NULL;
-        }
-
-        if (Utilities::isNotNullPtr(A_sparse)) {
-            free(A_sparse);
-            A_sparse = NULL;
+            qp = new qpOASES::QProblem(nV, nC);
         }
 
         Q_i = new int[_Q->p[_nV]];
@@ -99,34 +144,41 @@ namespace LCQPow {
     }
 
 
-    SubsolverQPOASES::SubsolverQPOASES(const SubsolverQPOASES& rhs)
+    bool SubsolverQPOASES::updateMatrices( int _nV, int _nC, const double* const _Q, const double* const _A )
     {
-        copy( rhs );
-    }
+        if (isSparse || Utilities::isNullPtr(qp) || nV != _nV || nC != _nC)
+            return false;
 
+        // qpOASES initializes the QP from these arrays (it may have regularised the previous Hessian in place)
+        memcpy(Q, _Q, (size_t)(nV*nV)*sizeof(double));
+        A = _A;
 
-    SubsolverQPOASES::~SubsolverQPOASES()
-    {
-        clear();
+        return true;
     }
 
 
-    SubsolverQPOASES& SubsolverQPOASES::operator=(const SubsolverQPOASES& rhs)
+    bool SubsolverQPOASES::updateMatrices( int _nV, int _nC, const csc* const _Q, const csc* const _A )
     {
-        if (this != &rhs) {
-            copy( rhs );
-        }
+        if (!isSparse || nV != _nV || nC != _nC)
+            return false;
 
-        return *this;
+        if (!Utilities::hasPattern(_Q, nV, nV, Q_p, Q_i) || !Utilities::hasPattern(_A, nC, nV, A_p, A_i))
+            return false;
+
+        // The qpOASES matrices reference these arrays (their diagonal info only depends on the pattern)
+        memcpy(Q_x, _Q->x, (size_t)Q_p[nV]*sizeof(double));
+        memcpy(A_x, _A->x, (size_t)A_p[nV]*sizeof(double));
+
+        return true;
     }
 
 
     void SubsolverQPOASES::setOptions( qpOASES::Options options )
     {
-        if (useSchur) {
-            qpSchur.setOptions( options );
-        } else {
-            qp.setOptions( options );
+        if (Utilities::isNotNullPtr(qpSchur)) {
+            qpSchur->setOptions( options );
+        } else if (Utilities::isNotNullPtr(qp)) {
+            qp->setOptions( options );
         }
     }
 
@@ -144,23 +196,24 @@ namespace LCQPow {
         if (initialSolve) {
             if (isSparse) {
                 if (useSchur) {
-                    ret = qpSchur.init(Q_sparse, g, A_sparse, lb, ub, lbA, ubA, nwsr, (double*)0, x0, y0);
+                    ret = qpSchur->init(Q_sparse, g, A_sparse, lb, ub, lbA, ubA, nwsr, (double*)0, x0, y0);
                 } else {
-                    ret = qp.init(Q_sparse, g, A_sparse, lb, ub, lbA, ubA, nwsr, (double*)0, x0, y0);
+                    ret = qp->init(Q_sparse, g, A_sparse, lb, ub, lbA, ubA, nwsr, (double*)0, x0, y0);
                 }
             } else {
-                ret = qp.init(Q, g, A, lb, ub, lbA, ubA, nwsr, (double*)0, x0, y0);
+                ret = qp->init(Q, g, A, lb, ub, lbA, ubA, nwsr, (double*)0, x0, y0);
             }
         } else {
             if (useSchur) {
-                ret = qpSchur.hotstart(g, lb, ub, lbA, ubA, nwsr);
+                ret = qpSchur->hotstart(g, lb, ub, lbA, ubA, nwsr);
             } else {
-                ret = qp.hotstart(g, lb, ub, lbA, ubA, nwsr);
+                ret = qp->hotstart(g, lb, ub, lbA, ubA, nwsr);
             }
         }
 
         iterations = (int)(nwsr);
         exit_flag = (int)(ret);
+        lastSolveInitial = initialSolve;
 
         if (ret != qpOASES::returnValue::SUCCESSFUL_RETURN)
             return ReturnValue::SUBPROBLEM_SOLVER_ERROR;
@@ -172,15 +225,22 @@ namespace LCQPow {
     void SubsolverQPOASES::getSolution( double* x, double* y )
     {
         if (useSchur) {
-            qpSchur.getPrimalSolution( x );
-            qpSchur.getDualSolution( y );
+            qpSchur->getPrimalSolution( x );
+            qpSchur->getDualSolution( y );
         } else {
-            qp.getPrimalSolution( x );
-            qp.getDualSolution( y );
+            qp->getPrimalSolution( x );
+            qp->getDualSolution( y );
         }
     }
 
 
+    void SubsolverQPOASES::getSolveStatistics( int& rhoUpdates, int& factorizations ) const
+    {
+        rhoUpdates = 0;
+        factorizations = lastSolveInitial ? 1 : 0;
+    }
+
+
     void SubsolverQPOASES::copy(const SubsolverQPOASES& rhs)
     {
 
@@ -216,17 +276,46 @@ namespace LCQPow {
             A_sparse->createDiagInfo();
         } else {
             Q = new double[nV*nV];
-            A = new double[nC*nV];
-
             memcpy(Q, rhs.Q, (size_t)(nV*nV)*sizeof(double));
-            memcpy(A, rhs.A, (size_t)(nC*nV)*sizeof(double));
-        }
 
-        if (useSchur) {
-            qpSchur = rhs.qpSchur;
-        } else {
-            qp = rhs.qp;
+            A = rhs.A;
         }
+
+        if (Utilities::isNotNullPtr(rhs.qpSchur))
+            qpSchur = new qpOASES::SQProblemSchur(*rhs.qpSchur);
+
+        if (Utilities::isNotNullPtr(rhs.qp))
+            qp = new qpOASES::QProblem(*rhs.qp);
+    }
+
+
+    void SubsolverQPOASES::move(SubsolverQPOASES& rhs)
+    {
+        clear();
+
+        nV = rhs.nV;
+        nC = rhs.nC;
+
+        isSparse = rhs.isSparse;
+        useSchur = rhs.useSchur;
+
+        // Take over all data (the qpOASES matrices keep pointing to the same arrays)
+        Q = rhs.Q; rhs.Q = NULL;
+        A = rhs.A; rhs.A = NULL;
+
+        Q_sparse = rhs.Q_sparse; rhs.Q_sparse = NULL;
+        A_sparse = rhs.A_sparse; rhs.A_sparse = NULL;
+
+        Q_x = rhs.Q_x; rhs.Q_x = NULL;
+        Q_i = rhs.Q_i; rhs.Q_i = NULL;
+        Q_p = rhs.Q_p; rhs.Q_p = NULL;
+
+        A_x = rhs.A_x; rhs.A_x = NULL;
+        A_i = rhs.A_i; rhs.A_i = NULL;
+        A_p = rhs.A_p; rhs.A_p = NULL;
+
+        qp = rhs.qp; rhs.qp = NULL;
+        qpSchur = rhs.qpSchur; rhs.qpSchur = NULL;
     }
 
 
@@ -237,10 +326,8 @@ namespace LCQPow {
             Q = NULL;
         }
 
-        if (Utilities::isNotNullPtr(A)) {
-            delete[] A;
-            A = NULL;
-        }
+        // The dense constraint matrix is borrowed
+        A = NULL;
 
         if (Utilities::isNotNullPtr(Q_i)) {
             delete[] Q_i;
@@ -267,9 +354,9 @@ namespace LCQPow {
             A_p = NULL;
         }
 
-        if (Utilities::isNotNullPtr(A_x)) {
-            delete[] A_x;
-            A_x = NULL;
+        if (Utilities::isNotNullPtr(A_i)) {
+            delete[] A_i;
+            A_i = NULL;
         }
 
         if (Utilities::isNotNullPtr(Q_sparse)) {
@@ -281,5 +368,15 @@ namespace LCQPow {
             delete A_sparse;
             A_sparse = 0;
         }
+
+        if (Utilities::isNotNullPtr(qp)) {
+            delete qp;
+            qp = 0;
+        }
+
+        if (Utilities::isNotNullPtr(qpSchur)) {
+            delete qpSchur;
+            qpSchur = 0;
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+/*
+ *	This file is part of LCQPow.
+ *
+ *	LCQPow -- A Solver for Quadratic Programs with Commplementarity Constraints.
+ *	Copyright (C) 2020 - 2022 by Jonas Hall et al.
+ *
+ *	LCQPow is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	LCQPow is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with LCQPow; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#include "TrajectoryWriter.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace LCQPow {
+
+    // Size of the output buffer
+    static const size_t BUFFER_SIZE = 1 << 16;
+
+    // Upper bound on the length of a number printed with %.17g and its separator
+    static const size_t MAX_NUMBER_LENGTH = 32;
+
+
+    TrajectoryWriter::TrajectoryWriter( ) { }
+
+
+    TrajectoryWriter::~TrajectoryWriter( )
+    {
+        close( );
+    }
+
+
+    ReturnValue TrajectoryWriter::open( const char* filename )
+    {
+        return open( filename, Utilities::getFileFormat( filename ) == BINARY_FILE ? BINARY_FILE : TEXT_FILE );
+    }
+
+
+    ReturnValue TrajectoryWriter::open( const char* filename, FileFormat _format )
+    {
+        close( );
+
+        if (_format != TEXT_FILE && _format != BINARY_FILE)
+            return INVALID_ARGUMENT;
+
+        file = fopen( filename, _format == BINARY_FILE ? "wb" : "w" );
+
+        if (file == 0)
+            return UNABLE_TO_WRITE_FILE;
+
+        format = _format;
+        failed = false;
+        nRecords = 0;
+        used = 0;
+        buffer.resize(BUFFER_SIZE);
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue TrajectoryWriter::write( const double* const data, int n )
+    {
+        if (!isOpen())
+            return LCQPOBJECT_NOT_SETUP;
+
+        if (failed || (n > 0 && Utilities::isNullPtr(data)))
+            return UNABLE_TO_WRITE_FILE;
+
+        if (format == BINARY_FILE) {
+            size_t bytes = (size_t)(n > 0 ? n : 0)*sizeof(double);
+
+            // Large records bypass the buffer
+            if (bytes > buffer.size()) {
+                flush( );
+                failed = failed || fwrite(data, sizeof(double), (size_t)n, file) != (size_t)n;
+            } else {
+                reserve( bytes );
+                memcpy(&buffer[used], data, bytes);
+                used += bytes;
+            }
+        } else {
+            for (int i = 0; i < n; i++) {
+                reserve( MAX_NUMBER_LENGTH );
+                used += (size_t)snprintf(&buffer[used], MAX_NUMBER_LENGTH, i + 1 < n ? "%.17g " : "%.17g", data[i]);
+            }
+
+            reserve( 1 );
+            buffer[used++] = '\n';
+        }
+
+        nRecords++;
+
+        return failed ? UNABLE_TO_WRITE_FILE : SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue TrajectoryWriter::flush( )
+    {
+        if (!isOpen())
+            return SUCCESSFUL_RETURN;
+
+        if (used > 0 && !failed)
+            failed = fwrite(buffer.data(), 1, used, file) != used;
+
+        used = 0;
+
+        return failed ? UNABLE_TO_WRITE_FILE : SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue TrajectoryWriter::close( )
+    {
+        if (!isOpen())
+            return SUCCESSFUL_RETURN;
+
+        flush( );
+        failed = (fclose(file) != 0) || failed;
+        file = NULL;
+
+        return failed ? UNABLE_TO_WRITE_FILE : SUCCESSFUL_RETURN;
+    }
+
+
+    bool TrajectoryWriter::isOpen( ) const
+    {
+        return file != NULL;
+    }
+
+
+    int TrajectoryWriter::getNumberOfRecords( ) const
+    {
+        return nRecords;
+    }
+
+
+    void TrajectoryWriter::reserve( size_t bytes )
+    {
+        if (used + bytes > buffer.size())
+            flush( );
+    }
+}
@@ -21,10 +21,18 @@
 
 
 #include "Utilities.hpp"
+#include "DenseKernels.hpp"
 #include "MessageHandler.hpp"
+#include "TrajectoryWriter.hpp"
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <stdint.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <qpOASES.hpp>
 
@@ -36,14 +44,7 @@ extern "C" {
 namespace LCQPow {
 
     void Utilities::MatrixMultiplication(const double* const A, const double* const B, double* C, int m, int n, int p) {
-        for (int i = 0; i < m; i++) {
-            for (int j = 0; j < p; j++) {
-                C[i*p + j] = 0;
-                for (int k = 0; k < n; k++) {
-                    C[i*p + j] += A[i*n + k]*B[k*p + j];
-                }
-            }
-        }
+        DenseKernels::MatrixProduct(A, B, C, m, n, p);
     }
 
     void Utilities::MatrixMultiplication(const csc* const A, const double* const b, double* c)
@@ -60,15 +61,7 @@ namespace LCQPow {
 
 
     void Utilities::TransponsedMatrixMultiplication(const double* const A, const double* const B, double* C, int m, int n, int p) {
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < p; j++) {
-                C[i*p + j] = 0;
-
-                for (int k = 0; k < m; k++) {
-                    C[i*p+j] += A[k*n + i]*B[k*p + j];
-                }
-            }
-        }
+        DenseKernels::TransposedMatrixProduct(A, B, C, m, n, p, false);
     }
 
 
@@ -83,13 +76,7 @@ namespace LCQPow {
 
 
     void Utilities::AddTransponsedMatrixMultiplication(const double* const A, const double* const B, double* C, int m, int n, int p) {
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < p; j++) {
-                for (int k = 0; k < m; k++) {
-                    C[i*p+j] += A[k*n + i]*B[k*p + j];
-                }
-            }
-        }
+        DenseKernels::TransposedMatrixProduct(A, B, C, m, n, p, true);
     }
 
 
@@ -102,58 +89,95 @@ namespace LCQPow {
     }
 
     void Utilities::MatrixSymmetrizationProduct(const double* const A, const double* const B, double* C, int m, int n) {
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j <= i; j++) {
-                C[i*n + j] = 0;
-                for (int k = 0; k < m; k++) {
-                    C[i*n + j] += A[k*n + i]*B[k*n + j] + B[k*n + i]*A[k*n + j];
-                }
-
-                // Make symmetric
-                C[j*n + i] = C[i*n + j];
-            }
-        }
+        DenseKernels::SymmetrizationProduct(A, B, C, m, n);
     }
 
     csc* Utilities::MatrixSymmetrizationProduct(double* L_x, int* L_i, int* L_p, double* R_x, int* R_i, int* R_p, int n) {
+        // At least n rows (as the square case), more if the row indices require them
+        int m = n;
+
+        for (int k = 0; k < L_p[n]; k++)
+            m = std::max(m, L_i[k] + 1);
+
+        for (int k = 0; k < R_p[n]; k++)
+            m = std::max(m, R_i[k] + 1);
+
+        return MatrixSymmetrizationProduct(L_x, L_i, L_p, R_x, R_i, R_p, m, n);
+    }
+
+    csc* Utilities::MatrixSymmetrizationProduct(double* L_x, int* L_i, int* L_p, double* R_x, int* R_i, int* R_p, int m, int n) {
+        // Wrap the raw arrays (no copies) and build row-wise access to L and R via their transposes
+        csc* L = createCSC(m, n, L_p[n], L_x, L_i, L_p);
+        csc* R = createCSC(m, n, R_p[n], R_x, R_i, R_p);
+        csc* Lt = transposeCSC(L);
+        csc* Rt = transposeCSC(R);
+
         std::vector<int> C_rows;
         std::vector<double> C_data;
         int* C_p = (int*) malloc((size_t)(n+1)*sizeof(int));
         C_p[0] = 0;
 
-        for (int j = 0; j < n; j++) {
-            C_p[j+1] = C_p[j];
-            for (int i = 0; i < n; i++) {
-                double tmp = 0;
+        // Dense accumulator and marker workspace (marker[i] == j iff row i is already in column j)
+        std::vector<double> acc((size_t)n, 0.0);
+        std::vector<int> marker((size_t)n, -1);
+        std::vector<int> pattern;
 
-                // (L'*R)_ij
-                for (int k = L_p[i]; k < L_p[i+1]; k++) {
-                    int ind_s2 = getIndexOfIn(L_i[k], R_i, R_p[j], R_p[j+1]);
-                    if (ind_s2 != -1) {
-                        tmp += L_x[k]*R_x[ind_s2];
+        for (int j = 0; j < n; j++) {
+            pattern.clear();
+
+            // (L'*R)(:,j) = sum_k R_kj * L(k,:)'
+            for (int k = R->p[j]; k < R->p[j+1]; k++) {
+                int row = R->i[k];
+                for (int t = Lt->p[row]; t < Lt->p[row+1]; t++) {
+                    int i = Lt->i[t];
+                    if (marker[(size_t)i] != j) {
+                        marker[(size_t)i] = j;
+                        acc[(size_t)i] = 0;
+                        pattern.push_back(i);
                     }
+                    acc[(size_t)i] += Lt->x[t]*R->x[k];
                 }
+            }
 
-                // (R'*L)_ij
-                for (int k = R_p[i]; k < R_p[i+1]; k++) {
-                    int ind_s1 = getIndexOfIn(R_i[k], L_i, L_p[j], L_p[j+1]);
-
-                    if (ind_s1 != -1) {
-                        tmp += R_x[k]*L_x[ind_s1];
+            // (R'*L)(:,j) = sum_k L_kj * R(k,:)'
+            for (int k = L->p[j]; k < L->p[j+1]; k++) {
+                int row = L->i[k];
+                for (int t = Rt->p[row]; t < Rt->p[row+1]; t++) {
+                    int i = Rt->i[t];
+                    if (marker[(size_t)i] != j) {
+                        marker[(size_t)i] = j;
+                        acc[(size_t)i] = 0;
+                        pattern.push_back(i);
                     }
+                    acc[(size_t)i] += Rt->x[t]*L->x[k];
                 }
+            }
+
+            // Row indices must be sorted within each column
+            std::sort(pattern.begin(), pattern.end());
 
-                // If the entry is non-zero append it to the data
+            // Only append the non-zero entries
+            C_p[j+1] = C_p[j];
+            for (size_t k = 0; k < pattern.size(); k++) {
+                double tmp = acc[(size_t)pattern[k]];
                 if (!isZero(tmp)) {
-                    C_rows.push_back(i);
+                    C_rows.push_back(pattern[k]);
                     C_data.push_back(tmp);
                     C_p[j+1]++;
                 }
             }
         }
 
-        if (C_p[n] == 0)
+        // Only free the wrappers of L and R (data is owned by the caller)
+        free(L);
+        free(R);
+        ClearSparseMat(&Lt);
+        ClearSparseMat(&Rt);
+
+        if (C_p[n] == 0) {
+            free(C_p);
             return 0;
+        }
 
         int* C_i = (int*) malloc((size_t)C_p[n]*sizeof(int));
         double* C_x = (double*) malloc((size_t)C_p[n]*sizeof(double));
@@ -168,21 +192,71 @@ namespace LCQPow {
     }
 
 
-    csc* Utilities::MatrixSymmetrizationProduct(csc* L, csc* R) {
-        return MatrixSymmetrizationProduct(L->x, L->i, L->p, R->x, R->i, R->p, L->n);
+    csc* Utilities::MatrixSymmetrizationProduct(const csc* const L, const csc* const R) {
+        return MatrixSymmetrizationProduct(L->x, L->i, L->p, R->x, R->i, R->p, L->m, L->n);
     }
 
 
-    void Utilities::AffineLinearTransformation(const double alpha, const double* const A, const double* const b, const double* const c, double* d, int m, int n) {
-        for (int i = 0; i < m; i++) {
+    void Utilities::SelectorSymmetrizationProduct(const int* const l, const int* const r, double* C, int m, int n) {
+        for (int i = 0; i < n*n; i++)
+            C[i] = 0;
 
-            double tmp = 0;
-            for (int k = 0; k < n; k++) {
-                tmp += A[i*n + k]*b[k];
-            }
+        // Pair k contributes e_l*e_r' + e_r*e_l'
+        for (int k = 0; k < m; k++) {
+            C[l[k]*n + r[k]] += 1;
+            C[r[k]*n + l[k]] += 1;
+        }
+    }
+
+
+    csc* Utilities::SelectorSymmetrizationProduct(const int* const l, const int* const r, int m, int n) {
+        if (m <= 0)
+            return 0;
+
+        // Pair k contributes the entries (l[k], r[k]) and (r[k], l[k]): bucket their rows by column
+        std::vector<int> count((size_t)(n+1), 0);
+        for (int k = 0; k < m; k++) {
+            count[(size_t)r[k] + 1]++;
+            count[(size_t)l[k] + 1]++;
+        }
+
+        for (int j = 0; j < n; j++)
+            count[(size_t)j + 1] += count[(size_t)j];
+
+        std::vector<int> rows((size_t)(2*m));
+        std::vector<int> next(count.begin(), count.end() - 1);
+        for (int k = 0; k < m; k++) {
+            rows[(size_t)next[(size_t)r[k]]++] = l[k];
+            rows[(size_t)next[(size_t)l[k]]++] = r[k];
+        }
+
+        int* C_p = (int*) malloc((size_t)(n+1)*sizeof(int));
+        int* C_i = (int*) malloc((size_t)(2*m)*sizeof(int));
+        double* C_x = (double*) malloc((size_t)(2*m)*sizeof(double));
+        C_p[0] = 0;
 
-            d[i] = alpha*tmp + c[i];
+        // Sort the rows within each column and merge duplicates
+        for (int j = 0; j < n; j++) {
+            std::sort(rows.begin() + count[(size_t)j], rows.begin() + count[(size_t)j + 1]);
+
+            C_p[j+1] = C_p[j];
+            for (int k = count[(size_t)j]; k < count[(size_t)j + 1]; k++) {
+                if (C_p[j+1] > C_p[j] && C_i[C_p[j+1] - 1] == rows[(size_t)k]) {
+                    C_x[C_p[j+1] - 1] += 1;
+                } else {
+                    C_i[C_p[j+1]] = rows[(size_t)k];
+                    C_x[C_p[j+1]] = 1;
+                    C_p[j+1]++;
+                }
+            }
         }
+
+        return createCSC(n, n, C_p[n], C_x, C_i, C_p);
+    }
+
+
+    void Utilities::AffineLinearTransformation(const double alpha, const double* const A, const double* const b, const double* const c, double* d, int m, int n) {
+        DenseKernels::MatrixVectorProduct(alpha, A, b, c, d, m, n);
     }
 
 
@@ -211,17 +285,8 @@ namespace LCQPow {
     }
 
 
-    double Utilities::QuadraticFormProduct(const double* const Q, const double* const p, int m) {
-        double ret = 0;
-        for (int i = 0; i < m; i++) {
-            double tmp = 0;
-            for (int j = 0; j < m; j++)
-                tmp += Q[i*m + j]*p[j];
-
-            ret += tmp*p[i];
-        }
-
-        return ret;
+    double Utilities::QuadraticFormProduct(const double* const Q, const double* const p, int m, double* Qp) {
+        return DenseKernels::QuadraticFormProduct(Q, p, m, Qp);
     }
 
 
@@ -242,11 +307,7 @@ namespace LCQPow {
 
 
     double Utilities::DotProduct(const double* const a, const double* const b, int m) {
-        double ret = 0;
-        for (int i = 0; i < m; i++)
-            ret += a[i]*b[i];
-
-        return ret;
+        return DenseKernels::DotProduct(a, b, m);
     }
 
 
@@ -265,6 +326,30 @@ namespace LCQPow {
     }
 
 
+    // The SplitMix64 output function
+    static inline uint64_t splitMix64(uint64_t z) {
+        z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+
+    void Utilities::AddRandomPerturbation(double* a, int m, unsigned long long seed, unsigned long long counter, double scale) {
+        const uint64_t gamma = 0x9E3779B97F4A7C15ULL;
+        const uint64_t key = splitMix64((uint64_t)seed + gamma);
+
+        // Branch free, i.e. the loop is vectorized
+        for (int i = 0; i < m; i++) {
+            uint64_t bits = splitMix64(key + ((uint64_t)counter + (uint64_t)i)*gamma);
+
+            // Upper 32 bits mapped to {0, 1, 2}
+            int r = (int)(((bits >> 32)*3) >> 32) - 1;
+
+            a[i] += r*scale;
+        }
+    }
+
+
     void Utilities::ClearSparseMat(csc* M)
     {
         if (isNotNullPtr(M)) {
@@ -309,121 +394,436 @@ namespace LCQPow {
     }
 
 
-    ReturnValue Utilities::readFromFile( int* data, int n, const char* datafilename )
-    {
-        int i;
-        FILE* datafile;
+    namespace {
+
+        // Longest token accepted by the readers (longer ones are invalid numbers)
+        const int MAX_TOKEN = 63;
 
-        /* 1) Open file. */
-        if ( ( datafile = fopen( datafilename, "r" ) ) == 0 )
+
+        // Buffered reader of whitespace separated tokens, replaces one fscanf call per number
+        class TokenReader {
+
+            public:
+                TokenReader( FILE* _file ) : file( _file ) { }
+
+                // Reads the next token, returns false at the end of the file or if the token is too long
+                bool next( char* token )
+                {
+                    int c = peek();
+                    while (c != EOF && isspace(c)) {
+                        position++;
+                        c = peek();
+                    }
+
+                    if (c == EOF)
+                        return false;
+
+                    int length = 0;
+                    while (c != EOF && !isspace(c)) {
+                        if (length == MAX_TOKEN)
+                            return false;
+
+                        token[length++] = (char)c;
+                        position++;
+                        c = peek();
+                    }
+
+                    token[length] = '\0';
+                    return true;
+                }
+
+                // Skips the rest of the current line
+                void skipLine( )
+                {
+                    int c = peek();
+                    while (c != EOF && c != '\n') {
+                        position++;
+                        c = peek();
+                    }
+                }
+
+            private:
+                int peek( )
+                {
+                    if (position == size) {
+                        size = fread(buffer, 1, sizeof(buffer), file);
+                        position = 0;
+                    }
+
+                    return position < size ? (unsigned char)buffer[position] : EOF;
+                }
+
+                FILE* file;
+                char buffer[1 << 16];
+                size_t position = 0;
+                size_t size = 0;
+        };
+
+
+        bool parseNumber( const char* token, double& value )
         {
-            fclose( datafile );
-            return UNABLE_TO_READ_FILE;
+            char* stop;
+            value = strtod(token, &stop);
+            return stop != token && *stop == '\0';
         }
 
-        /* 2) Read data from file. */
-        for( i=0; i<n; ++i )
+
+        bool parseNumber( const char* token, int& value )
         {
-            if ( fscanf( datafile, "%d\n", &(data[i]) ) == 0 )
-            {
-                fclose( datafile );
+            char* stop;
+            long number = strtol(token, &stop, 10);
+            value = (int)number;
+            return stop != token && *stop == '\0' && number == (long)value;
+        }
+
+
+        bool hasExtension( const char* filename, const char* extension )
+        {
+            size_t n = strlen(filename);
+            size_t m = strlen(extension);
+            return n >= m && strcmp(filename + n - m, extension) == 0;
+        }
+
+
+        // Reads exactly n whitespace separated numbers
+        template <typename T>
+        ReturnValue readTextFile( T* data, int n, const char* datafilename )
+        {
+            FILE* datafile = fopen( datafilename, "r" );
+
+            if (datafile == 0)
                 return UNABLE_TO_READ_FILE;
+
+            TokenReader reader( datafile );
+            char token[MAX_TOKEN + 1];
+
+            for (int i = 0; i < n; i++) {
+                if (!reader.next(token) || !parseNumber(token, data[i])) {
+                    fclose( datafile );
+                    return UNABLE_TO_READ_FILE;
+                }
             }
+
+            bool trailing = reader.next(token);
+            fclose( datafile );
+
+            return trailing ? UNABLE_TO_READ_FILE : SUCCESSFUL_RETURN;
         }
 
-        /* 3) Close file. */
-        fclose( datafile );
 
-        return SUCCESSFUL_RETURN;
-    }
+        // Reads a file of exactly n raw numbers
+        template <typename T>
+        ReturnValue readBinaryFile( T* data, int n, const char* datafilename )
+        {
+            FILE* datafile = fopen( datafilename, "rb" );
 
+            if (datafile == 0)
+                return UNABLE_TO_READ_FILE;
 
-    ReturnValue Utilities::readFromFile( double* data, int n, const char* datafilename )
-    {
-        int i;
-        FILE* datafile;
+            size_t count = fread(data, sizeof(T), (size_t)n, datafile);
+            bool trailing = fgetc(datafile) != EOF;
+            fclose( datafile );
 
-        /* 1) Open file. */
-        if ( ( datafile = fopen( datafilename, "r" ) ) == 0 )
-        {
-            return UNABLE_TO_READ_FILE;
+            return count == (size_t)n && !trailing ? SUCCESSFUL_RETURN : UNABLE_TO_READ_FILE;
         }
 
-        /* 2) Read data from file. */
-        for( i=0; i<n; ++i )
+
+        // Reads the entries of a Matrix Market file as 0-based triplets (symmetric storage is expanded, array files skip zeros)
+        ReturnValue readMatrixMarketTriplets( const char* datafilename, int& m, int& n, std::vector<int>& rows, std::vector<int>& cols, std::vector<double>& vals )
         {
-            if ( fscanf( datafile, "%lf\n", &(data[i]) ) == 0 )
-            {
-                fclose( datafile );
+            FILE* datafile = fopen( datafilename, "r" );
+
+            if (datafile == 0)
                 return UNABLE_TO_READ_FILE;
+
+            TokenReader reader( datafile );
+            char token[MAX_TOKEN + 1];
+            char header[5][MAX_TOKEN + 1];
+
+            // Banner: %%MatrixMarket matrix <coordinate|array> <real|integer|pattern> <general|symmetric|skew-symmetric>
+            bool valid = true;
+            for (int k = 0; k < 5 && valid; k++) {
+                valid = reader.next(header[k]);
+
+                for (char* c = header[k]; valid && *c != '\0'; c++)
+                    *c = (char)tolower(*c);
+            }
+
+            valid = valid && strcmp(header[0], "%%matrixmarket") == 0 && strcmp(header[1], "matrix") == 0;
+
+            bool coordinate = valid && strcmp(header[2], "coordinate") == 0;
+            bool pattern = valid && strcmp(header[3], "pattern") == 0;
+            bool symmetric = valid && strcmp(header[4], "symmetric") == 0;
+            bool skew = valid && strcmp(header[4], "skew-symmetric") == 0;
+
+            valid = valid && (coordinate || strcmp(header[2], "array") == 0);
+            valid = valid && (pattern || strcmp(header[3], "real") == 0 || strcmp(header[3], "integer") == 0);
+            valid = valid && (symmetric || skew || strcmp(header[4], "general") == 0);
+            valid = valid && !(pattern && !coordinate);
+
+            // Comment lines
+            reader.skipLine();
+            while (valid && reader.next(token) && token[0] == '%')
+                reader.skipLine();
+
+            // Size line
+            int nnz = 0;
+            valid = valid && parseNumber(token, m) && reader.next(token) && parseNumber(token, n);
+
+            if (coordinate)
+                valid = valid && reader.next(token) && parseNumber(token, nnz);
+            else if (valid)
+                nnz = symmetric || skew ? n*(n + 1)/2 - (skew ? n : 0) : m*n;
+
+            valid = valid && m >= 0 && n >= 0 && nnz >= 0 && (!(symmetric || skew) || m == n);
+
+            rows.clear();
+            cols.clear();
+            vals.clear();
+
+            if (valid) {
+                rows.reserve((size_t)nnz);
+                cols.reserve((size_t)nnz);
+                vals.reserve((size_t)nnz);
+            }
+
+            // Entries
+            int i = 0, j = 0;
+            for (int k = 0; k < nnz && valid; k++) {
+                double v = 1.0;
+
+                if (coordinate) {
+                    valid = reader.next(token) && parseNumber(token, i) && reader.next(token) && parseNumber(token, j);
+                    i--;
+                    j--;
+                } else {
+                    // Column by column (only the lower triangle of symmetric matrices)
+                    if (k == 0) {
+                        i = skew ? 1 : 0;
+                        j = 0;
+                    } else if (++i == m) {
+                        j++;
+                        i = symmetric ? j : (skew ? j + 1 : 0);
+                    }
+                }
+
+                if (!pattern)
+                    valid = valid && reader.next(token) && parseNumber(token, v);
+
+                valid = valid && i >= 0 && i < m && j >= 0 && j < n;
+
+                if (!valid || v == 0.0)
+                    continue;
+
+                rows.push_back(i);
+                cols.push_back(j);
+                vals.push_back(v);
+
+                if ((symmetric || skew) && i != j) {
+                    rows.push_back(j);
+                    cols.push_back(i);
+                    vals.push_back(skew ? -v : v);
+                }
             }
+
+            valid = valid && !reader.next(token);
+            fclose( datafile );
+
+            return valid ? SUCCESSFUL_RETURN : UNABLE_TO_READ_FILE;
         }
+    }
 
-        /* 3) Close file. */
-        fclose( datafile );
 
-        return SUCCESSFUL_RETURN;
+    FileFormat Utilities::getFileFormat( const char* datafilename )
+    {
+        if (hasExtension(datafilename, ".bin"))
+            return BINARY_FILE;
+
+        if (hasExtension(datafilename, ".mtx"))
+            return MATRIX_MARKET_FILE;
+
+        return TEXT_FILE;
     }
 
 
-    ReturnValue Utilities::writeToFile( double* data, int n, const char* datafilename )
+    ReturnValue Utilities::readFromFile( int* data, int n, const char* datafilename )
     {
-        int i;
-        FILE* datafile;
+        switch (getFileFormat(datafilename)) {
+            case BINARY_FILE:
+                return readBinaryFile( data, n, datafilename );
 
-        /* 1) Open file. */
-        if ( ( datafile = fopen( datafilename, "w" ) ) == 0 )
-        {
-            fclose( datafile );
+            case MATRIX_MARKET_FILE:
+                return UNABLE_TO_READ_FILE;
+
+            default:
+                return readTextFile( data, n, datafilename );
+        }
+    }
+
+
+    ReturnValue Utilities::readFromFile( double* data, int n, const char* datafilename )
+    {
+        switch (getFileFormat(datafilename)) {
+            case BINARY_FILE:
+                return readBinaryFile( data, n, datafilename );
+
+            case MATRIX_MARKET_FILE:
+                break;
+
+            default:
+                return readTextFile( data, n, datafilename );
+        }
+
+        // Matrix Market files are expanded to dense (row by row)
+        int m, cols;
+        std::vector<int> rowIdx, colIdx;
+        std::vector<double> vals;
+
+        ReturnValue ret = readMatrixMarketTriplets( datafilename, m, cols, rowIdx, colIdx, vals );
+
+        if (ret != SUCCESSFUL_RETURN)
+            return ret;
+
+        if ((long long)m*cols != (long long)n)
             return UNABLE_TO_READ_FILE;
+
+        for (int i = 0; i < n; i++)
+            data[i] = 0;
+
+        for (size_t k = 0; k < vals.size(); k++)
+            data[rowIdx[k]*cols + colIdx[k]] += vals[k];
+
+        return SUCCESSFUL_RETURN;
+    }
+
+
+    ReturnValue Utilities::readMatrixMarket( csc** M, const char* datafilename )
+    {
+        int m, n;
+        std::vector<int> rowIdx, colIdx;
+        std::vector<double> vals;
+
+        ReturnValue ret = readMatrixMarketTriplets( datafilename, m, n, rowIdx, colIdx, vals );
+
+        if (ret != SUCCESSFUL_RETURN)
+            return ret;
+
+        int nnz = (int)vals.size();
+
+        // Order the entries by row first, a stable pass by column then yields sorted columns
+        std::vector<int> byRow((size_t)nnz), start((size_t)(std::max(m, n) + 1));
+
+        for (int k = 0; k < nnz; k++)
+            start[(size_t)rowIdx[k] + 1]++;
+
+        for (int i = 0; i < m; i++)
+            start[(size_t)i + 1] += start[(size_t)i];
+
+        for (int k = 0; k < nnz; k++)
+            byRow[(size_t)start[(size_t)rowIdx[k]]++] = k;
+
+        int* p = (int*) malloc((size_t)(n + 1)*sizeof(int));
+        int* i = (int*) malloc((size_t)std::max(nnz, 1)*sizeof(int));
+        double* x = (double*) malloc((size_t)std::max(nnz, 1)*sizeof(double));
+
+        for (int j = 0; j <= n; j++)
+            p[j] = 0;
+
+        for (int k = 0; k < nnz; k++)
+            p[colIdx[k] + 1]++;
+
+        for (int j = 0; j < n; j++)
+            p[j + 1] += p[j];
+
+        std::vector<int> next(p, p + n);
+        for (int k = 0; k < nnz; k++) {
+            int e = byRow[(size_t)k];
+            int pos = next[(size_t)colIdx[e]]++;
+
+            i[pos] = rowIdx[e];
+            x[pos] = vals[e];
         }
 
-        /* 2) Read data from file. */
-        for( i=0; i<n; ++i )
-        {
-            if ( fprintf( datafile, "%f\n", data[i] ) == 0 )
-            {
-                fclose( datafile );
-                return UNABLE_TO_READ_FILE;
+        // Sum duplicates
+        int count = 0;
+        for (int j = 0; j < n; j++) {
+            int begin = p[j];
+            p[j] = count;
+
+            for (int k = begin; k < p[j + 1]; k++) {
+                if (count > p[j] && i[count - 1] == i[k]) {
+                    x[count - 1] += x[k];
+                } else {
+                    i[count] = i[k];
+                    x[count] = x[k];
+                    count++;
+                }
             }
         }
+        p[n] = count;
 
-        /* 3) Close file. */
-        fclose( datafile );
+        *M = createCSC(m, n, count, x, i, p);
+
+        if (isNullPtr(*M)) {
+            free(p);
+            free(i);
+            free(x);
+            return UNABLE_TO_READ_FILE;
+        }
 
         return SUCCESSFUL_RETURN;
     }
 
 
+    ReturnValue Utilities::writeToFile( const double* const data, int n, const char* datafilename )
+    {
+        TrajectoryWriter writer;
+
+        ReturnValue ret = writer.open( datafilename );
+
+        // Binary files hold the raw values, text files one value per line
+        if (ret == SUCCESSFUL_RETURN && getFileFormat( datafilename ) == BINARY_FILE) {
+            ret = writer.write( data, n );
+        } else {
+            for (int i = 0; i < n && ret == SUCCESSFUL_RETURN; i++)
+                ret = writer.write( &data[i], 1 );
+        }
+
+        ReturnValue closeRet = writer.close( );
+
+        return ret != SUCCESSFUL_RETURN ? ret : closeRet;
+    }
+
+
     void Utilities::printMatrix(const double* const A, int m, int n, const char* const name)
     {
-        printf("Printing matrix %s:\n", name);
+        MessageHandler::Print("Printing matrix %s:\n", name);
 
         for (int i = 0; i < m; i++) {
             for (int j = 0; j < n; j++)
-                printf("%.5f ", A[i*n + j]);
+                MessageHandler::Print("%.5f ", A[i*n + j]);
 
 
-            printf("\n");
+            MessageHandler::Print("\n");
         }
 
-        printf("\n");
+        MessageHandler::Print("\n");
     }
 
 
     void Utilities::printMatrix(const int* const A, int m, int n, const char* const name)
     {
-        printf("Printing matrix %s:\n", name);
+        MessageHandler::Print("Printing matrix %s:\n", name);
 
         for (int i = 0; i < m; i++) {
             for (int j = 0; j < n; j++)
-                printf("%d ", A[i*n + j]);
+                MessageHandler::Print("%d ", A[i*n + j]);
 
 
-            printf("\n");
+            MessageHandler::Print("\n");
         }
 
-        printf("\n");
+        MessageHandler::Print("\n");
         fflush(stdout);
     }
 
@@ -446,23 +846,23 @@ namespace LCQPow {
 
     void Utilities::printStep(double* xk, double* pk, double* xk_new, double alpha, int nV)
     {
-        printf("Printing Step:\n");
+        MessageHandler::Print("Printing Step:\n");
 
         for (int i = 0; i < nV; i++)
-            printf("%.2f + %.2f * %.2f = %.2f \n", xk[i], alpha, pk[i], xk_new[i]);
+            MessageHandler::Print("%.2f + %.2f * %.2f = %.2f \n", xk[i], alpha, pk[i], xk_new[i]);
 
-        printf("\n");
+        MessageHandler::Print("\n");
     }
 
 
     void Utilities::printBounds(double* lb, double* xk, double* ub, int m)
     {
-        printf("Printing box constraints:\n");
+        MessageHandler::Print("Printing box constraints:\n");
 
         for (int i = 0; i < m; i++)
-            printf("%.2f <= %.2f <= %.2f \n", lb[i], xk[i], ub[i]);
+            MessageHandler::Print("%.2f <= %.2f <= %.2f \n", lb[i], xk[i], ub[i]);
 
-        printf("\n");
+        MessageHandler::Print("\n");
     }
 
 
@@ -583,6 +983,72 @@ namespace LCQPow {
     }
 
 
+    void Utilities::assignCSC(const csc* const M, csc** dst)
+    {
+        csc* D = *dst;
+
+        if (isNotNullPtr(D) && D->m == M->m && D->n == M->n && D->p[D->n] == M->p[M->n]) {
+            int nnx = M->p[M->n];
+
+            memcpy(D->p, M->p, (size_t)(M->n+1)*sizeof(int));
+            memcpy(D->i, M->i, (size_t)nnx*sizeof(int));
+            memcpy(D->x, M->x, (size_t)nnx*sizeof(double));
+            return;
+        }
+
+        ClearSparseMat(dst);
+        *dst = copyCSC(M);
+    }
+
+
+    bool Utilities::hasPattern(const csc* const M, int m, int n, const int* const p, const int* const i)
+    {
+        if (M->m != m || M->n != n)
+            return false;
+
+        for (int j = 0; j <= n; j++) {
+            if (M->p[j] != p[j])
+                return false;
+        }
+
+        for (int k = 0; k < p[n]; k++) {
+            if (M->i[k] != i[k])
+                return false;
+        }
+
+        return true;
+    }
+
+
+    csc* Utilities::transposeCSC(const csc* const M)
+    {
+        int nnx = M->p[M->n];
+
+        int* p = (int*) calloc((size_t)(M->m+1), sizeof(int));
+        int* i = (int*) malloc((size_t)nnx*sizeof(int));
+        double* x = (double*) malloc((size_t)nnx*sizeof(double));
+
+        // Count the entries of each row of M (i.e. each column of M')
+        for (int k = 0; k < nnx; k++)
+            p[M->i[k]+1]++;
+
+        for (int r = 0; r < M->m; r++)
+            p[r+1] += p[r];
+
+        // Scatter the entries (visiting the columns in order keeps the row indices of M' sorted)
+        std::vector<int> next(p, p + M->m);
+        for (int j = 0; j < M->n; j++) {
+            for (int k = M->p[j]; k < M->p[j+1]; k++) {
+                int dest = next[(size_t)M->i[k]]++;
+                i[dest] = j;
+                x[dest] = M->x[k];
+            }
+        }
+
+        return createCSC(M->n, M->m, nnx, x, i, p);
+    }
+
+
     void Utilities::copyIntToIntT(int* dest, const int* const src, int n)
     {
         for (int i = 0; i < n; i++)
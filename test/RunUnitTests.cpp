@@ -22,12 +22,58 @@
 
 #include "Utilities.hpp"
 #include "Options.hpp"
+#include "ConstraintMatrix.hpp"
+#include "DenseKernels.hpp"
 #include "LCQProblem.hpp"
+#include "LCQBatchSolver.hpp"
+#include "LCQProblemPool.hpp"
+#include "LCQPContainer.hpp"
+#include "TrajectoryWriter.hpp"
+#include "MessageHandler.hpp"
 
 #include <gtest/gtest.h>
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <utility>
+#include <new>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <cstring>
+
+// Counts the calls of operator new and delete (see SolverTest.NoAllocationsInResolve and SolverTest.ReloadProblem).
+// Allocations with malloc are not counted, i.e. the OSQP workspaces (c_malloc) set up by the subsolver are not seen.
+static std::atomic<size_t> allocationCount( 0 );
+static std::atomic<size_t> deallocationCount( 0 );
+
+void* operator new( size_t size )
+{
+    allocationCount++;
+
+    void* ptr = malloc(size > 0 ? size : 1);
+    if (ptr == NULL)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void operator delete( void* ptr ) noexcept
+{
+    if (ptr != NULL)
+        deallocationCount++;
+
+    free(ptr);
+}
+
+void operator delete( void* ptr, size_t ) noexcept
+{
+    if (ptr != NULL)
+        deallocationCount++;
+
+    free(ptr);
+}
 
 // Testing standard matrix multiplications
 TEST(UtilitiesTest, MatrixMultiplicationTest) {
@@ -103,6 +149,342 @@ TEST(UtilitiesTest, MatrixSymmetrization) {
     delete[] A; delete[] B; delete[] C;
 }
 
+// Testing the sparse matrix symmetrization product against the dense one
+TEST(UtilitiesTest, SparseMatrixSymmetrization) {
+
+    int numExp = 100;
+    int m = 4;
+    int n = 7;
+
+    srand((unsigned int)time(NULL));
+
+    for (int k = 0; k < numExp; k++) {
+        double* A = new double[m*n]();
+        double* B = new double[m*n]();
+        double* C = new double[n*n];
+
+        // Randomly fill roughly 25% of the entries
+        for (int j = 0; j < m*n; j++) {
+            int rd = std::rand();
+            if (rd % 4 == 0)
+                A[j] = rd % 9 - 4;
+
+            rd = std::rand();
+            if (rd % 4 == 0)
+                B[j] = rd % 9 - 4;
+        }
+
+        LCQPow::Utilities::MatrixSymmetrizationProduct(A, B, C, m, n);
+
+        csc* A_sparse = LCQPow::Utilities::dns_to_csc(A, m, n);
+        csc* B_sparse = LCQPow::Utilities::dns_to_csc(B, m, n);
+        csc* C_sparse = LCQPow::Utilities::MatrixSymmetrizationProduct(A_sparse, B_sparse);
+
+        // The raw array overload without the number of rows gives the same product
+        csc* C_columns = LCQPow::Utilities::MatrixSymmetrizationProduct(A_sparse->x, A_sparse->i, A_sparse->p, B_sparse->x, B_sparse->i, B_sparse->p, n);
+        ASSERT_EQ(C_columns == 0, C_sparse == 0);
+
+        // An empty product is returned as null pointer
+        if (C_sparse == 0) {
+            for (int j = 0; j < n*n; j++)
+                ASSERT_DOUBLE_EQ(C[j], 0);
+        } else {
+            ASSERT_EQ(C_columns->p[n], C_sparse->p[n]);
+            for (int l = 0; l < C_sparse->p[n]; l++) {
+                ASSERT_EQ(C_columns->i[l], C_sparse->i[l]);
+                ASSERT_DOUBLE_EQ(C_columns->x[l], C_sparse->x[l]);
+            }
+
+            LCQPow::Utilities::ClearSparseMat(&C_columns);
+
+            ASSERT_EQ(C_sparse->m, n);
+            ASSERT_EQ(C_sparse->n, n);
+
+            // Row indices must be strictly increasing within each column
+            for (int j = 0; j < n; j++)
+                for (int l = C_sparse->p[j] + 1; l < C_sparse->p[j+1]; l++)
+                    ASSERT_LT(C_sparse->i[l-1], C_sparse->i[l]);
+
+            double* C_control = LCQPow::Utilities::csc_to_dns(C_sparse);
+
+            for (int j = 0; j < n*n; j++)
+                ASSERT_DOUBLE_EQ(C_control[j], C[j]);
+
+            delete[] C_control;
+            LCQPow::Utilities::ClearSparseMat(&C_sparse);
+        }
+
+        // Clear memory
+        delete[] A; delete[] B; delete[] C;
+        LCQPow::Utilities::ClearSparseMat(&A_sparse);
+        LCQPow::Utilities::ClearSparseMat(&B_sparse);
+    }
+}
+
+// Testing the csc transpose
+TEST(UtilitiesTest, TransposeCSC) {
+    // A = [1 0 2; 3 1 0]
+    double A[2*3] = { 1, 0, 2, 3, 1, 0 };
+    csc* A_sparse = LCQPow::Utilities::dns_to_csc(A, 2, 3);
+    csc* At_sparse = LCQPow::Utilities::transposeCSC(A_sparse);
+
+    ASSERT_EQ(At_sparse->m, 3);
+    ASSERT_EQ(At_sparse->n, 2);
+    ASSERT_EQ(At_sparse->p[0], 0);
+    ASSERT_EQ(At_sparse->p[1], 2);
+    ASSERT_EQ(At_sparse->p[2], 4);
+    ASSERT_EQ(At_sparse->i[0], 0);
+    ASSERT_EQ(At_sparse->i[1], 2);
+    ASSERT_EQ(At_sparse->i[2], 0);
+    ASSERT_EQ(At_sparse->i[3], 1);
+    ASSERT_DOUBLE_EQ(At_sparse->x[0], 1);
+    ASSERT_DOUBLE_EQ(At_sparse->x[1], 2);
+    ASSERT_DOUBLE_EQ(At_sparse->x[2], 3);
+    ASSERT_DOUBLE_EQ(At_sparse->x[3], 1);
+
+    LCQPow::Utilities::ClearSparseMat(&A_sparse);
+    LCQPow::Utilities::ClearSparseMat(&At_sparse);
+}
+
+// Testing the blocked dense kernels of every supported instruction set against naive loops
+TEST(UtilitiesTest, DenseKernelsInstructionSets) {
+    // Odd sizes exercise the remainders, n > 256 spans several blocks
+    int m = 37;
+    int n = 301;
+    int p = 19;
+
+    srand(42);
+    std::vector<double> A((size_t)(m*n)), B((size_t)(m*n)), X((size_t)(n*p)), Y((size_t)(m*p)), x((size_t)n), y((size_t)m);
+    for (double& v : A) v = (std::rand() % 4 == 0) ? 0 : (std::rand() % 2001 - 1000)/100.0;
+    for (double& v : B) v = (std::rand() % 2001 - 1000)/100.0;
+    for (double& v : X) v = (std::rand() % 2001 - 1000)/100.0;
+    for (double& v : Y) v = (std::rand() % 2001 - 1000)/100.0;
+    for (double& v : x) v = (std::rand() % 2001 - 1000)/100.0;
+    for (double& v : y) v = (std::rand() % 3 == 0) ? 0 : (std::rand() % 2001 - 1000)/100.0;
+
+    // Reference values
+    std::vector<double> AX((size_t)(m*p), 0), AtY((size_t)(n*p), 0), C((size_t)(n*n), 0), Ax((size_t)m, 0), Aty((size_t)n, 0);
+    for (int i = 0; i < m; i++)
+        for (int k = 0; k < n; k++) {
+            for (int j = 0; j < p; j++) {
+                AX[(size_t)(i*p + j)] += A[(size_t)(i*n + k)]*X[(size_t)(k*p + j)];
+                AtY[(size_t)(k*p + j)] += A[(size_t)(i*n + k)]*Y[(size_t)(i*p + j)];
+            }
+
+            for (int j = 0; j < n; j++)
+                C[(size_t)(k*n + j)] += A[(size_t)(i*n + k)]*B[(size_t)(i*n + j)] + B[(size_t)(i*n + k)]*A[(size_t)(i*n + j)];
+
+            Ax[(size_t)i] += A[(size_t)(i*n + k)]*x[(size_t)k];
+            Aty[(size_t)k] += A[(size_t)(i*n + k)]*y[(size_t)i];
+        }
+
+    double TOL = 1e-9;
+    LCQPow::KernelInstructionSet defaultSet = LCQPow::DenseKernels::getInstructionSet();
+
+    for (LCQPow::KernelInstructionSet isa : { LCQPow::KERNELS_SCALAR, LCQPow::KERNELS_AVX2, LCQPow::KERNELS_AVX512 }) {
+        if (!LCQPow::DenseKernels::isSupported(isa)) {
+            ASSERT_EQ(LCQPow::DenseKernels::setInstructionSet(isa), LCQPow::INVALID_ARGUMENT);
+            continue;
+        }
+
+        ASSERT_EQ(LCQPow::DenseKernels::setInstructionSet(isa), LCQPow::SUCCESSFUL_RETURN);
+
+        std::vector<double> res((size_t)(n*n), 0);
+
+        LCQPow::Utilities::MatrixMultiplication(A.data(), X.data(), res.data(), m, n, p);
+        for (int i = 0; i < m*p; i++)
+            ASSERT_NEAR(res[(size_t)i], AX[(size_t)i], TOL);
+
+        LCQPow::Utilities::TransponsedMatrixMultiplication(A.data(), Y.data(), res.data(), m, n, p);
+        for (int i = 0; i < n*p; i++)
+            ASSERT_NEAR(res[(size_t)i], AtY[(size_t)i], TOL);
+
+        LCQPow::Utilities::MatrixSymmetrizationProduct(A.data(), B.data(), res.data(), m, n);
+        for (int i = 0; i < n*n; i++)
+            ASSERT_NEAR(res[(size_t)i], C[(size_t)i], TOL);
+
+        LCQPow::Utilities::AffineLinearTransformation(2, A.data(), x.data(), y.data(), res.data(), m, n);
+        for (int i = 0; i < m; i++)
+            ASSERT_NEAR(res[(size_t)i], 2*Ax[(size_t)i] + y[(size_t)i], TOL);
+
+        for (int i = 0; i < n; i++)
+            res[(size_t)i] = 1;
+
+        LCQPow::Utilities::AddTransponsedMatrixMultiplication(A.data(), y.data(), res.data(), m, n, 1);
+        for (int i = 0; i < n; i++)
+            ASSERT_NEAR(res[(size_t)i], Aty[(size_t)i] + 1, TOL);
+
+        double xCx = 0;
+        for (int i = 0; i < n; i++)
+            xCx += x[(size_t)i]*LCQPow::Utilities::DotProduct(C.data() + i*n, x.data(), n);
+
+        ASSERT_NEAR(LCQPow::Utilities::QuadraticFormProduct(C.data(), x.data(), n), xCx, 1e-12*LCQPow::Utilities::getAbs(xCx));
+
+        // With a buffer for C*x (used by the BLAS backend)
+        ASSERT_NEAR(LCQPow::Utilities::QuadraticFormProduct(C.data(), x.data(), n, res.data()), xCx, 1e-12*LCQPow::Utilities::getAbs(xCx));
+    }
+
+    ASSERT_EQ(LCQPow::DenseKernels::setInstructionSet(defaultSet), LCQPow::SUCCESSFUL_RETURN);
+}
+
+// Testing the block kernels of the stacked constraint matrix [A; L; R]
+TEST(UtilitiesTest, ConstraintMatrixBlocks) {
+    // A = [1 0 2], L = [0 1 0; 2 0 0], R = [0 0 3; 0 -1 0]
+    int nV = 3;
+    int nC = 1;
+    int nComp = 2;
+    double A[1*3] = { 1, 0, 2 };
+    double L[2*3] = { 0, 1, 0, 2, 0, 0 };
+    double R[2*3] = { 0, 0, 3, 0, -1, 0 };
+    double M[5*3] = { 1, 0, 2, 0, 1, 0, 2, 0, 0, 0, 0, 3, 0, -1, 0 };
+
+    double x[3] = { 1, -2, 0.5 };
+    double y[5] = { 1, 2, -1, 0.5, 3 };
+
+    // Reference values
+    double Lx[2], Rx[2], Mty[3], Rty[3];
+    LCQPow::Utilities::MatrixMultiplication(L, x, Lx, nComp, nV, 1);
+    LCQPow::Utilities::MatrixMultiplication(R, x, Rx, nComp, nV, 1);
+    LCQPow::Utilities::TransponsedMatrixMultiplication(M, y, Mty, nC + 2*nComp, nV, 1);
+    LCQPow::Utilities::TransponsedMatrixMultiplication(R, y + nC + nComp, Rty, nComp, nV, 1);
+
+    csc* A_sparse = LCQPow::Utilities::dns_to_csc(A, nC, nV);
+    csc* L_sparse = LCQPow::Utilities::dns_to_csc(L, nComp, nV);
+    csc* R_sparse = LCQPow::Utilities::dns_to_csc(R, nComp, nV);
+
+    LCQPow::ConstraintMatrix dense;
+    dense.setUp(nV, nC, nComp, A, L, R);
+
+    LCQPow::ConstraintMatrix sparse;
+    sparse.setUp(nV, nC, nComp, A_sparse, L_sparse, R_sparse);
+
+    LCQPow::ConstraintMatrix switched(dense);
+    ASSERT_EQ(switched.switchToSparseMode(), LCQPow::SUCCESSFUL_RETURN);
+
+    ASSERT_FALSE(dense.isSparse());
+    ASSERT_TRUE(sparse.isSparse());
+    ASSERT_TRUE(switched.isSparse());
+
+    for (int i = 0; i < (nC + 2*nComp)*nV; i++)
+        ASSERT_DOUBLE_EQ(dense.getDense()[i], M[i]);
+
+    for (LCQPow::ConstraintMatrix* Ms : { &dense, &sparse, &switched }) {
+        double Lx_M[2], Rx_M[2], LRx_M[4];
+        double Mty_M[3] = { 0, 0, 0 };
+        double Rty_M[3] = { 0, 0, 0 };
+
+        Ms->multiply(LCQPow::BLOCK_L, x, Lx_M);
+        Ms->multiply(LCQPow::BLOCK_R, x, Rx_M);
+        Ms->multiply(LCQPow::BLOCK_L, LCQPow::BLOCK_R, x, LRx_M);
+        Ms->addTransposedMultiply(1, y, Mty_M);
+        Ms->addTransposedMultiply(LCQPow::BLOCK_R, 2, y + nC + nComp, Rty_M);
+
+        for (int i = 0; i < nComp; i++) {
+            ASSERT_DOUBLE_EQ(Lx_M[i], Lx[i]);
+            ASSERT_DOUBLE_EQ(Rx_M[i], Rx[i]);
+            ASSERT_DOUBLE_EQ(LRx_M[i], Lx[i]);
+            ASSERT_DOUBLE_EQ(LRx_M[nComp + i], Rx[i]);
+        }
+
+        for (int j = 0; j < nV; j++) {
+            ASSERT_DOUBLE_EQ(Mty_M[j], Mty[j]);
+            ASSERT_DOUBLE_EQ(Rty_M[j], 2*Rty[j]);
+        }
+    }
+
+    // Back to dense
+    ASSERT_EQ(sparse.switchToDenseMode(), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_FALSE(sparse.isSparse());
+
+    for (int i = 0; i < (nC + 2*nComp)*nV; i++)
+        ASSERT_DOUBLE_EQ(sparse.getDense()[i], M[i]);
+
+    LCQPow::Utilities::ClearSparseMat(&A_sparse);
+    LCQPow::Utilities::ClearSparseMat(&L_sparse);
+    LCQPow::Utilities::ClearSparseMat(&R_sparse);
+}
+
+// Testing the detection of selector blocks and their gather/scatter products
+TEST(UtilitiesTest, SelectorComplementarities) {
+    // A = [1 1 0 0], L = [1 0 0 0; 0 0 1 0; 0 1 0 0], R = [0 1 0 0; 0 0 0 1; 0 1 0 0]
+    int nV = 4;
+    int nC = 1;
+    int nComp = 3;
+    double A[1*4] = { 1, 1, 0, 0 };
+    double L[3*4] = { 1, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0 };
+    double R[3*4] = { 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0 };
+    double R_scaled[3*4] = { 0, 2, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0 };
+
+    double x[4] = { 1, -2, 0.5, 3 };
+    double y[7] = { 1, 2, -1, 0.5, 3, -4, 1.5 };
+
+    // Reference values
+    double C[4*4], LRx[6], Mty[4];
+    double M[7*4];
+    memcpy(M, A, sizeof(A));
+    memcpy(M + 4, L, sizeof(L));
+    memcpy(M + 16, R, sizeof(R));
+    LCQPow::Utilities::MatrixSymmetrizationProduct(L, R, C, nComp, nV);
+    LCQPow::Utilities::MatrixMultiplication(M + 4, x, LRx, 2*nComp, nV, 1);
+    LCQPow::Utilities::TransponsedMatrixMultiplication(M, y, Mty, nC + 2*nComp, nV, 1);
+
+    csc* A_sparse = LCQPow::Utilities::dns_to_csc(A, nC, nV);
+    csc* L_sparse = LCQPow::Utilities::dns_to_csc(L, nComp, nV);
+    csc* R_sparse = LCQPow::Utilities::dns_to_csc(R, nComp, nV);
+
+    LCQPow::ConstraintMatrix dense;
+    dense.setUp(nV, nC, nComp, A, L, R);
+
+    LCQPow::ConstraintMatrix sparse;
+    sparse.setUp(nV, nC, nComp, A_sparse, L_sparse, R_sparse);
+
+    for (LCQPow::ConstraintMatrix* Ms : { &dense, &sparse }) {
+        ASSERT_TRUE(LCQPow::Utilities::isNullPtr(Ms->getSelectorColumns(LCQPow::BLOCK_A)));
+        ASSERT_TRUE(LCQPow::Utilities::isNotNullPtr(Ms->getSelectorColumns(LCQPow::BLOCK_L)));
+        ASSERT_TRUE(LCQPow::Utilities::isNotNullPtr(Ms->getSelectorColumns(LCQPow::BLOCK_R)));
+
+        double LRx_M[6];
+        double Mty_M[4] = { 0, 0, 0, 0 };
+
+        Ms->multiply(LCQPow::BLOCK_L, LCQPow::BLOCK_R, x, LRx_M);
+        Ms->addTransposedMultiply(1, y, Mty_M);
+
+        for (int i = 0; i < 2*nComp; i++)
+            ASSERT_DOUBLE_EQ(LRx_M[i], LRx[i]);
+
+        for (int j = 0; j < nV; j++)
+            ASSERT_DOUBLE_EQ(Mty_M[j], Mty[j]);
+    }
+
+    // C = L'*R + R'*L (the last pair has l = r)
+    const int* l = dense.getSelectorColumns(LCQPow::BLOCK_L);
+    const int* r = dense.getSelectorColumns(LCQPow::BLOCK_R);
+
+    double C_sel[4*4];
+    LCQPow::Utilities::SelectorSymmetrizationProduct(l, r, C_sel, nComp, nV);
+    csc* C_sparse = LCQPow::Utilities::SelectorSymmetrizationProduct(l, r, nComp, nV);
+    double* C_dns = LCQPow::Utilities::csc_to_dns(C_sparse);
+
+    for (int i = 0; i < nV*nV; i++) {
+        ASSERT_DOUBLE_EQ(C_sel[i], C[i]);
+        ASSERT_DOUBLE_EQ(C_dns[i], C[i]);
+    }
+
+    ASSERT_EQ(C_sparse->p[nV], 5);
+
+    // A scaled entry is no selector
+    LCQPow::ConstraintMatrix scaled;
+    scaled.setUp(nV, nC, nComp, A, L, R_scaled);
+    ASSERT_TRUE(LCQPow::Utilities::isNotNullPtr(scaled.getSelectorColumns(LCQPow::BLOCK_L)));
+    ASSERT_TRUE(LCQPow::Utilities::isNullPtr(scaled.getSelectorColumns(LCQPow::BLOCK_R)));
+
+    delete[] C_dns;
+    LCQPow::Utilities::ClearSparseMat(&C_sparse);
+    LCQPow::Utilities::ClearSparseMat(&A_sparse);
+    LCQPow::Utilities::ClearSparseMat(&L_sparse);
+    LCQPow::Utilities::ClearSparseMat(&R_sparse);
+}
+
 // Testing standard and symmetrization matrix multiplications
 TEST(UtilitiesTest, AffineTransformation) {
     // alpha = 2;
@@ -245,6 +627,38 @@ TEST(UtilitiesTest, MaxAbs) {
     delete[] a;
 }
 
+// Testing the counter-based perturbation (reproducible, independent of how the numbers are drawn)
+TEST(UtilitiesTest, RandomPerturbation) {
+    int m = 300;
+    std::vector<double> bulk((size_t)m, 0.0);
+    std::vector<double> split((size_t)m, 0.0);
+    std::vector<double> other((size_t)m, 0.0);
+
+    // All at once vs. in chunks with the corresponding counters
+    LCQPow::Utilities::AddRandomPerturbation(bulk.data(), m, 7, 1000, 1.0);
+    LCQPow::Utilities::AddRandomPerturbation(split.data(), 100, 7, 1000, 1.0);
+    LCQPow::Utilities::AddRandomPerturbation(split.data() + 100, 200, 7, 1100, 1.0);
+    LCQPow::Utilities::AddRandomPerturbation(other.data(), m, 8, 1000, 1.0);
+
+    int count[3] = { 0, 0, 0 };
+    int differences = 0;
+
+    for (size_t i = 0; i < (size_t)m; i++) {
+        ASSERT_EQ(bulk[i], split[i]);
+        ASSERT_TRUE(bulk[i] == -1.0 || bulk[i] == 0.0 || bulk[i] == 1.0);
+
+        count[(int)bulk[i] + 1]++;
+        if (bulk[i] != other[i])
+            differences++;
+    }
+
+    // Each value is drawn and other seeds yield other numbers
+    ASSERT_GT(count[0], m/6);
+    ASSERT_GT(count[1], m/6);
+    ASSERT_GT(count[2], m/6);
+    ASSERT_GT(differences, m/3);
+}
+
 // Testing Options constructors, default settings, consistency
 TEST(UtilitiesTest, Options) {
     LCQPow::Options opts;
@@ -374,6 +788,147 @@ TEST(UtilitiesTest, SparseDenseBackAndForth) {
     }
 }
 
+// Testing the text, binary and Matrix Market readers
+TEST(UtilitiesTest, ReadDataFiles) {
+    double data[6];
+
+    // Text: exactly n numbers
+    {
+        std::ofstream file("lcqpow_test_data.txt");
+        file << "1.5\n-2e-3  inf\n\n4\n";
+    }
+
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(data, 4, "lcqpow_test_data.txt"), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(data[0], 1.5);
+    ASSERT_EQ(data[1], -2e-3);
+    ASSERT_EQ(data[2], INFINITY);
+    ASSERT_EQ(data[3], 4.0);
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(data, 5, "lcqpow_test_data.txt"), LCQPow::UNABLE_TO_READ_FILE);
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(data, 3, "lcqpow_test_data.txt"), LCQPow::UNABLE_TO_READ_FILE);
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(data, 1, "lcqpow_missing_file.txt"), LCQPow::UNABLE_TO_READ_FILE);
+
+    // Binary: raw doubles
+    {
+        double values[3] = { 0.1, -1.0/3.0, 1e300 };
+        std::ofstream file("lcqpow_test_data.bin", std::ios::binary);
+        file.write((const char*)values, sizeof(values));
+    }
+
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(data, 3, "lcqpow_test_data.bin"), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(data[1], -1.0/3.0);
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(data, 2, "lcqpow_test_data.bin"), LCQPow::UNABLE_TO_READ_FILE);
+
+    // Matrix Market: symmetric 3x3 with a duplicate entry (1-based, lower triangle)
+    {
+        std::ofstream file("lcqpow_test_data.mtx");
+        file << "%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 4\n1 1 2.0\n3 1 -1.0\n2 2 1.0\n2 2 0.5\n";
+    }
+
+    csc* M = NULL;
+    ASSERT_EQ(LCQPow::Utilities::readMatrixMarket(&M, "lcqpow_test_data.mtx"), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(M->m, 3);
+    ASSERT_EQ(M->n, 3);
+
+    int p_expected[4] = { 0, 2, 3, 4 };
+    int i_expected[4] = { 0, 2, 1, 0 };
+    double x_expected[4] = { 2.0, -1.0, 1.5, -1.0 };
+
+    for (int j = 0; j < 4; j++)
+        ASSERT_EQ(M->p[j], p_expected[j]);
+
+    for (int k = 0; k < 4; k++) {
+        ASSERT_EQ(M->i[k], i_expected[k]);
+        ASSERT_EQ(M->x[k], x_expected[k]);
+    }
+
+    LCQPow::Utilities::ClearSparseMat(&M);
+
+    // Expanded to dense (row by row)
+    double dense[9];
+    double dense_expected[9] = { 2.0, 0.0, -1.0, 0.0, 1.5, 0.0, -1.0, 0.0, 0.0 };
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(dense, 9, "lcqpow_test_data.mtx"), LCQPow::SUCCESSFUL_RETURN);
+
+    for (int k = 0; k < 9; k++)
+        ASSERT_EQ(dense[k], dense_expected[k]);
+
+    // Array format (column by column)
+    {
+        std::ofstream file("lcqpow_test_data.mtx");
+        file << "%%MatrixMarket matrix array real general\n2 3\n1\n2\n3\n4\n5\n6\n";
+    }
+
+    ASSERT_EQ(LCQPow::Utilities::readFromFile(data, 6, "lcqpow_test_data.mtx"), LCQPow::SUCCESSFUL_RETURN);
+    double array_expected[6] = { 1.0, 3.0, 5.0, 2.0, 4.0, 6.0 };
+
+    for (int k = 0; k < 6; k++)
+        ASSERT_EQ(data[k], array_expected[k]);
+
+    // Invalid index
+    {
+        std::ofstream file("lcqpow_test_data.mtx");
+        file << "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n";
+    }
+
+    ASSERT_EQ(LCQPow::Utilities::readMatrixMarket(&M, "lcqpow_test_data.mtx"), LCQPow::UNABLE_TO_READ_FILE);
+
+    remove("lcqpow_test_data.txt");
+    remove("lcqpow_test_data.bin");
+    remove("lcqpow_test_data.mtx");
+}
+
+// Testing lossless writing of data files
+TEST(UtilitiesTest, WriteDataFiles) {
+    double data[5] = { 0.1, 1.0/3.0, -2.5e-300, 1e300, -7.0 };
+    double read[5];
+
+    const char* files[2] = { "lcqpow_test_write.txt", "lcqpow_test_write.bin" };
+
+    for (int k = 0; k < 2; k++) {
+        ASSERT_EQ(LCQPow::Utilities::writeToFile(data, 5, files[k]), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(LCQPow::Utilities::readFromFile(read, 5, files[k]), LCQPow::SUCCESSFUL_RETURN);
+
+        for (int i = 0; i < 5; i++)
+            ASSERT_EQ(read[i], data[i]);
+    }
+
+    // Records of a trajectory (one line each in text files)
+    double records[3*2];
+
+    for (int k = 0; k < 2; k++) {
+        LCQPow::TrajectoryWriter writer;
+        ASSERT_EQ(writer.write(data, 2), LCQPow::LCQPOBJECT_NOT_SETUP);
+        ASSERT_EQ(writer.open(files[k]), LCQPow::SUCCESSFUL_RETURN);
+
+        for (int r = 0; r < 3; r++)
+            ASSERT_EQ(writer.write(data + r, 2), LCQPow::SUCCESSFUL_RETURN);
+
+        ASSERT_EQ(writer.getNumberOfRecords(), 3);
+        ASSERT_EQ(writer.close(), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_FALSE(writer.isOpen());
+
+        ASSERT_EQ(LCQPow::Utilities::readFromFile(records, 6, files[k]), LCQPow::SUCCESSFUL_RETURN);
+
+        for (int r = 0; r < 3; r++) {
+            ASSERT_EQ(records[2*r], data[r]);
+            ASSERT_EQ(records[2*r + 1], data[r + 1]);
+        }
+    }
+
+    std::ifstream text(files[0]);
+    std::string line;
+    int lines = 0;
+    while (std::getline(text, line))
+        lines++;
+    ASSERT_EQ(lines, 3);
+
+    LCQPow::TrajectoryWriter writer;
+    ASSERT_EQ(writer.open(files[0], LCQPow::MATRIX_MARKET_FILE), LCQPow::INVALID_ARGUMENT);
+    ASSERT_EQ(writer.open("lcqpow_missing_directory/lcqpow_test_write.txt"), LCQPow::UNABLE_TO_WRITE_FILE);
+
+    remove(files[0]);
+    remove(files[1]);
+}
+
 // Testing csc to triangular
 TEST(UtilitesTest, CSCtoTriangular) {
     double M_data[4] = { 2.0, 3.0, 3.0, 2.0 };
@@ -501,53 +1056,1751 @@ TEST(OutputStatisticsTest, CheckQPReturnFlag) {
     ASSERT_TRUE(qp_ext_flag != 0);
 }
 
-// Testing LCQPow solver set up
-TEST(SolverTest, RunWarmUp) {
+// Testing the wall-clock timers of the solver phases
+TEST(OutputStatisticsTest, PhaseTimes) {
     double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
     double g[2] = { -2.0, -2.0 };
     double L[1*2] = {1.0, 0.0};
     double R[1*2] = {0.0, 1.0};
-    int nV = 2;
-    int nC = 0;
-    int nComp = 1;
 
-    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+    LCQPow::LCQProblem lcqp( 2, 0, 1 );
 
-	LCQPow::Options options;
+    LCQPow::Options options;
     options.setPrintLevel(LCQPow::PrintLevel::NONE);
     lcqp.setOptions( options );
 
-    int numExp = 100;
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
 
-    // Allocate solution vectors
-    double* xOpt = new double[2];
-    double* yOpt = new double[nV + nC + 2*nComp];
+    LCQPow::OutputStatistics stats;
+    lcqp.getOutputStatistics(stats);
 
-    for (int i = 0; i < numExp; i++) {
+    // The phases add up to the total time
+    double sum = 0;
+    for (int k = 0; k < LCQPow::NUMBER_OF_PHASES; k++) {
+        ASSERT_GE(stats.getPhaseTime( (LCQPow::SolverPhase)k ), 0.0);
+        sum += stats.getPhaseTime( (LCQPow::SolverPhase)k );
+    }
 
-        LCQPow::ReturnValue retVal = lcqp.loadLCQP( Q, g, L, R );
-        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_GT(stats.getTimeTotal(), 0.0);
+    ASSERT_GT(stats.getPhaseTime( LCQPow::PHASE_SETUP ), 0.0);
+    ASSERT_GT(stats.getPhaseTime( LCQPow::PHASE_QP_SOLVE ), 0.0);
+    ASSERT_NEAR(sum, stats.getTimeTotal(), 1e-12 + 1e-9*stats.getTimeTotal());
 
-        retVal = lcqp.runSolver( );
-        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(stats.updatePhaseTime( LCQPow::NUMBER_OF_PHASES, 1.0 ), LCQPow::INVALID_ARGUMENT);
+    ASSERT_EQ(stats.updatePhaseTime( LCQPow::PHASE_SETUP, -1.0 ), LCQPow::INVALID_ARGUMENT);
 
-        lcqp.getPrimalSolution( xOpt );
-        lcqp.getDualSolution( yOpt );
+    // Each solve measures its own time
+    lcqp.reset();
+    lcqp.getOutputStatistics(stats);
+    ASSERT_EQ(stats.getTimeTotal(), 0.0);
+    ASSERT_EQ(stats.getPhaseTime( LCQPow::PHASE_QP_SOLVE ), 0.0);
+}
 
-        bool sStat1Found = (std::abs(xOpt[0] - 1) <= options.getStationarityTolerance()) && (std::abs(xOpt[1]) <= options.getStationarityTolerance());
-        bool sStat2Found = (std::abs(xOpt[1] - 1) <= options.getStationarityTolerance()) && (std::abs(xOpt[0]) <= options.getStationarityTolerance());
+// Testing the telemetry of the QP subproblems
+TEST(OutputStatisticsTest, SubproblemTelemetry) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    double A[1*2] = {1.0, 1.0};
+    double lbA[1] = {-10.0};
+    double ubA[1] = {10.0};
+    double lb[2] = {-5.0, -5.0};
+    double ub[2] = {5.0, 5.0};
 
-        ASSERT_TRUE( sStat1Found || sStat2Found );
+    LCQPow::LCQProblem lcqp( 2, 1, 1 );
 
-        bool stat1 = std::abs(2*xOpt[0] - 2 - yOpt[0] - yOpt[2]) <= options.getStationarityTolerance();
-        bool stat2 = std::abs(2*xOpt[1] - 2 - yOpt[1] - yOpt[3]) <= options.getStationarityTolerance();
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setStoreSteps(true);
+    lcqp.setOptions( options );
 
-        ASSERT_TRUE( stat1 );
-        ASSERT_TRUE( stat2 );
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, A, lbA, ubA, lb, ub ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    LCQPow::OutputStatistics stats;
+    lcqp.getOutputStatistics(stats);
+
+    // One entry per stored step
+    std::vector<int> innerIters = stats.getInnerItersStdVec();
+    std::vector<double> times = stats.getSubproblemTimesStdVec();
+    std::vector<int> rhoUpdates = stats.getSubproblemRhoUpdatesStdVec();
+    std::vector<int> factorizations = stats.getSubproblemFactorizationsStdVec();
+    std::vector<double> primalResiduals = stats.getSubproblemPrimalResidualsStdVec();
+    std::vector<double> dualResiduals = stats.getSubproblemDualResidualsStdVec();
+
+    ASSERT_GT(innerIters.size(), 0u);
+    ASSERT_EQ(times.size(), innerIters.size());
+    ASSERT_EQ(rhoUpdates.size(), innerIters.size());
+    ASSERT_EQ(factorizations.size(), innerIters.size());
+    ASSERT_EQ(primalResiduals.size(), innerIters.size());
+    ASSERT_EQ(dualResiduals.size(), innerIters.size());
+
+    // Only the initial solve factorizes (qpOASES hotstarts afterwards)
+    ASSERT_EQ(factorizations[0], 1);
+
+    for (size_t i = 0; i < times.size(); i++) {
+        ASSERT_GE(times[i], 0.0);
+        ASSERT_EQ(rhoUpdates[i], 0);
+        ASSERT_LE(primalResiduals[i], 1e-8);
+        ASSERT_LE(dualResiduals[i], 1e-8);
+
+        if (i > 0) {
+            ASSERT_EQ(factorizations[i], 0);
+        }
     }
 
-    // Clear solution vectors
-    delete[] xOpt; delete[] yOpt;
+    // Cleared with the other tracking vectors
+    lcqp.reset();
+    lcqp.getOutputStatistics(stats);
+    ASSERT_EQ(stats.getSubproblemTimesStdVec().size(), 0u);
+}
+
+// Records the events of a solve and aborts after a given number of iterations
+struct CallbackRecord {
+    int iterations = 0;
+    int penaltyUpdates = 0;
+    int terminations = 0;
+    int abortAfter = -1;
+    LCQPow::ReturnValue status = LCQPow::NOT_YET_IMPLEMENTED;
+    double lastStatNorm = -1;
+};
+
+bool recordEvent( LCQPow::CallbackEvent event, const LCQPow::IterationData& data, void* userData ) {
+    CallbackRecord* record = (CallbackRecord*) userData;
+
+    if (event == LCQPow::EVENT_ITERATION) {
+        record->iterations++;
+        record->lastStatNorm = LCQPow::Utilities::MaxAbs(data.stat, data.nV);
+    } else if (event == LCQPow::EVENT_PENALTY_UPDATE) {
+        record->penaltyUpdates++;
+    } else {
+        record->terminations++;
+        record->status = data.status;
+    }
+
+    return record->iterations != record->abortAfter;
+}
+
+// Testing the iteration callback
+TEST(SolverTest, IterationCallback) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+
+    LCQPow::LCQProblem lcqp( 2, 0, 1 );
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    lcqp.setOptions( options );
+
+    CallbackRecord record;
+    LCQPow::ReturnValue ret = lcqp.setIterationCallback( recordEvent, &record );
+
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+#ifdef LCQPOW_NO_CALLBACKS
+    ASSERT_EQ(ret, LCQPow::CALLBACKS_DISABLED);
+    ASSERT_EQ(record.iterations, 0);
+#else
+    ASSERT_EQ(ret, LCQPow::SUCCESSFUL_RETURN);
+
+    LCQPow::OutputStatistics stats;
+    lcqp.getOutputStatistics(stats);
+
+    // One event per iteration and penalty update, one termination
+    ASSERT_EQ(record.iterations, stats.getIterTotal());
+    ASSERT_EQ(record.penaltyUpdates, stats.getIterOuter());
+    ASSERT_EQ(record.terminations, 1);
+    ASSERT_EQ(record.status, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_LT(record.lastStatNorm, options.getStationarityTolerance());
+
+    // Abort after the first iteration
+    CallbackRecord abortRecord;
+    abortRecord.abortAfter = 1;
+    ASSERT_EQ(lcqp.setIterationCallback( recordEvent, &abortRecord ), LCQPow::SUCCESSFUL_RETURN);
+
+    lcqp.reset();
+    ASSERT_EQ(lcqp.runSolver( ), LCQPow::SOLVER_ABORTED_BY_CALLBACK);
+    ASSERT_EQ(abortRecord.iterations, 1);
+    ASSERT_EQ(abortRecord.terminations, 1);
+    ASSERT_EQ(abortRecord.status, LCQPow::SOLVER_ABORTED_BY_CALLBACK);
+
+    // Removing the callback
+    ASSERT_EQ(lcqp.setIterationCallback( NULL ), LCQPow::SUCCESSFUL_RETURN);
+    lcqp.reset();
+    ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(abortRecord.iterations, 1);
+#endif
+}
+
+// Testing the file formats of loadLCQP
+TEST(SolverTest, LoadFromFileFormats) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+
+    {
+        std::ofstream Qtxt("lcqpow_test_Q.txt"), gtxt("lcqpow_test_g.txt"), Ltxt("lcqpow_test_L.txt"), Rtxt("lcqpow_test_R.txt");
+        Qtxt << "2\n0\n0\n2\n";
+        gtxt << "-2\n-2\n";
+        Ltxt << "1\n0\n";
+        Rtxt << "0\n1\n";
+
+        std::ofstream Qbin("lcqpow_test_Q.bin", std::ios::binary), gbin("lcqpow_test_g.bin", std::ios::binary);
+        Qbin.write((const char*)Q, sizeof(Q));
+        gbin.write((const char*)g, sizeof(g));
+
+        std::ofstream Qmtx("lcqpow_test_Q.mtx"), Lmtx("lcqpow_test_L.mtx"), Rmtx("lcqpow_test_R.mtx");
+        Qmtx << "%%MatrixMarket matrix coordinate real symmetric\n2 2 2\n1 1 2\n2 2 2\n";
+        Lmtx << "%%MatrixMarket matrix coordinate real general\n1 2 1\n1 1 1\n";
+        Rmtx << "%%MatrixMarket matrix coordinate pattern general\n1 2 1\n1 2\n";
+
+        // Dual guess of the box constraints (nV), linear constraints (nC = 0) and complementarity rows (2*nComp)
+        std::ofstream y0txt("lcqpow_test_y0.txt");
+        y0txt << "0\n0\n0\n0\n";
+    }
+
+    // Reference from memory
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+    LCQPow::LCQProblem reference( 2, 0, 1 );
+    reference.setOptions( options );
+    ASSERT_EQ(reference.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(reference.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    double xRef[2], x[2];
+    reference.getPrimalSolution( xRef );
+
+    // Text, binary and mixed files are loaded dense, Matrix Market matrices sparse
+    const char* files[3][4] = {
+        { "lcqpow_test_Q.txt", "lcqpow_test_g.txt", "lcqpow_test_L.txt", "lcqpow_test_R.txt" },
+        { "lcqpow_test_Q.bin", "lcqpow_test_g.bin", "lcqpow_test_L.mtx", "lcqpow_test_R.txt" },
+        { "lcqpow_test_Q.mtx", "lcqpow_test_g.bin", "lcqpow_test_L.mtx", "lcqpow_test_R.mtx" }
+    };
+
+    for (int k = 0; k < 3; k++) {
+        LCQPow::LCQProblem lcqp( 2, 0, 1 );
+
+        options.setQPSolver( k < 2 ? LCQPow::QPOASES_DENSE : LCQPow::QPOASES_SPARSE );
+        lcqp.setOptions( options );
+
+        ASSERT_EQ(lcqp.loadLCQP( files[k][0], files[k][1], files[k][2], files[k][3] ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        lcqp.getPrimalSolution( x );
+        ASSERT_NEAR(x[0], xRef[0], 1e-10);
+        ASSERT_NEAR(x[1], xRef[1], 1e-10);
+    }
+
+    // The dual guess includes the box duals
+    LCQPow::LCQProblem guessed( 2, 0, 1 );
+    options.setQPSolver( LCQPow::QPOASES_DENSE );
+    guessed.setOptions( options );
+    ASSERT_EQ(guessed.loadLCQP( files[0][0], files[0][1], files[0][2], files[0][3], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, "lcqpow_test_y0.txt" ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(guessed.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    guessed.getPrimalSolution( x );
+    ASSERT_NEAR(x[0], xRef[0], 1e-10);
+    ASSERT_NEAR(x[1], xRef[1], 1e-10);
+
+    // Wrong dimensions
+    LCQPow::LCQProblem wrong( 3, 0, 1 );
+    wrong.setOptions( options );
+    ASSERT_NE(wrong.loadLCQP( files[2][0], files[2][1], files[2][2], files[2][3] ), LCQPow::SUCCESSFUL_RETURN);
+
+    const char* names[] = { "Q.txt", "g.txt", "L.txt", "R.txt", "Q.bin", "g.bin", "Q.mtx", "L.mtx", "R.mtx", "y0.txt" };
+    for (int k = 0; k < 10; k++)
+        remove((std::string("lcqpow_test_") + names[k]).c_str());
+}
+
+// Testing the problem container
+TEST(SolverTest, ProblemContainer) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    double A[1*2] = {1.0, 1.0};
+    double lbA[1] = { -10.0 };
+    double ubA[1] = { 10.0 };
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+    LCQPow::LCQProblem reference( 2, 1, 1 );
+    reference.setOptions( options );
+    ASSERT_EQ(reference.loadLCQP( Q, g, L, R, 0, 0, 0, 0, A, lbA, ubA ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(reference.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    double xRef[2], x[2];
+    reference.getPrimalSolution( xRef );
+
+    csc* Q_sparse = LCQPow::Utilities::dns_to_csc(Q, 2, 2);
+    csc* L_sparse = LCQPow::Utilities::dns_to_csc(L, 1, 2);
+    csc* R_sparse = LCQPow::Utilities::dns_to_csc(R, 1, 2);
+    csc* A_sparse = LCQPow::Utilities::dns_to_csc(A, 1, 2);
+
+    ASSERT_EQ(LCQPow::LCQPContainer::write( "lcqpow_test_dense.lcqp", 2, 1, 1, Q, g, L, R, 0, 0, 0, 0, A, lbA, ubA ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(LCQPow::LCQPContainer::write( "lcqpow_test_sparse.lcqp", 2, 1, 1, Q_sparse, g, L_sparse, R_sparse, 0, 0, 0, 0, A_sparse, lbA, ubA ), LCQPow::SUCCESSFUL_RETURN);
+
+    LCQPow::Utilities::ClearSparseMat(Q_sparse);
+    LCQPow::Utilities::ClearSparseMat(L_sparse);
+    LCQPow::Utilities::ClearSparseMat(R_sparse);
+    LCQPow::Utilities::ClearSparseMat(A_sparse);
+
+    const char* files[2] = { "lcqpow_test_dense.lcqp", "lcqpow_test_sparse.lcqp" };
+
+    for (int k = 0; k < 2; k++) {
+        LCQPow::LCQPContainer container;
+        ASSERT_EQ(container.open( files[k] ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(container.isSparse(), k == 1);
+        ASSERT_EQ(container.getNV(), 2);
+        ASSERT_EQ(container.getNC(), 1);
+        ASSERT_EQ(container.getNComp(), 1);
+
+        // Sections start at cache line boundaries
+        size_t count = 0;
+        ASSERT_EQ((size_t)container.getSection( LCQPow::SECTION_G, &count ) % 64, 0u);
+        ASSERT_EQ(count, 2u);
+        ASSERT_TRUE(container.getSection( LCQPow::SECTION_X0 ) == NULL);
+
+        LCQPow::LCQProblem lcqp( 2, 1, 1 );
+        options.setQPSolver( k == 0 ? LCQPow::QPOASES_DENSE : LCQPow::QPOASES_SPARSE );
+        lcqp.setOptions( options );
+
+        ASSERT_EQ(container.load( lcqp ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        lcqp.getPrimalSolution( x );
+        ASSERT_NEAR(x[0], xRef[0], 1e-10);
+        ASSERT_NEAR(x[1], xRef[1], 1e-10);
+
+        // Wrong dimensions
+        LCQPow::LCQProblem wrong( 3, 1, 1 );
+        ASSERT_EQ(container.load( wrong ), LCQPow::INVALID_ARGUMENT);
+    }
+
+    // Truncated and corrupted files are rejected
+    std::string data;
+    {
+        std::ifstream file("lcqpow_test_sparse.lcqp", std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    LCQPow::LCQPContainer container;
+    {
+        std::ofstream file("lcqpow_test_corrupt.lcqp", std::ios::binary);
+        file.write(data.data(), (std::streamsize)(data.size() - 8));
+    }
+    ASSERT_EQ(container.open( "lcqpow_test_corrupt.lcqp" ), LCQPow::UNABLE_TO_READ_FILE);
+
+    {
+        // Out of range row index of the first entry of Q (the section table follows the 64 byte header)
+        unsigned long long offset = 0;
+        memcpy(&offset, data.data() + 64 + LCQPow::SECTION_Q_I*16, sizeof(offset));
+        int index = 5;
+        memcpy(&data[(size_t)offset], &index, sizeof(index));
+
+        std::ofstream file("lcqpow_test_corrupt.lcqp", std::ios::binary);
+        file.write(data.data(), (std::streamsize)data.size());
+    }
+    ASSERT_EQ(container.open( "lcqpow_test_corrupt.lcqp" ), LCQPow::UNABLE_TO_READ_FILE);
+
+    ASSERT_FALSE(container.isOpen());
+    ASSERT_EQ(container.open( "lcqpow_test_missing.lcqp" ), LCQPow::UNABLE_TO_READ_FILE);
+
+    for (int k = 0; k < 2; k++)
+        remove(files[k]);
+    remove("lcqpow_test_corrupt.lcqp");
+}
+
+// Testing the streaming of the stored iterates
+TEST(SolverTest, StreamSteps) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setStoreSteps(true);
+
+    // Reference with the iterates in memory
+    LCQPow::LCQProblem reference( 2, 0, 1 );
+    reference.setOptions( options );
+    ASSERT_EQ(reference.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(reference.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    LCQPow::OutputStatistics stats;
+    reference.getOutputStatistics( stats );
+    std::vector<std::vector<double>> xSteps = stats.getxStepsStdVec();
+    ASSERT_GT(xSteps.size(), 0u);
+
+    const char* files[2] = { "lcqpow_test_steps.txt", "lcqpow_test_steps.bin" };
+
+    for (int k = 0; k < 2; k++) {
+        options.setStepFile( files[k] );
+
+        LCQPow::LCQProblem lcqp( 2, 0, 1 );
+        lcqp.setOptions( options );
+        ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        // The iterates are only in the file, the scalar trajectories are kept
+        lcqp.getOutputStatistics( stats );
+        ASSERT_EQ(stats.getxStepsStdVec().size(), 0u);
+        ASSERT_EQ(stats.getStatValsStdVec().size(), xSteps.size());
+
+        std::vector<double> steps(2*xSteps.size());
+        ASSERT_EQ(LCQPow::Utilities::readFromFile(steps.data(), (int)steps.size(), files[k]), LCQPow::SUCCESSFUL_RETURN);
+
+        for (size_t i = 0; i < xSteps.size(); i++) {
+            ASSERT_EQ(steps[2*i], xSteps[i][0]);
+            ASSERT_EQ(steps[2*i + 1], xSteps[i][1]);
+        }
+
+        remove(files[k]);
+    }
+}
+
+// Testing the bounded and sampled storage of the iterates
+TEST(SolverTest, StepStorage) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setStoreSteps(true);
+
+    // Reference with all iterates
+    LCQPow::LCQProblem reference( 2, 0, 1 );
+    reference.setOptions( options );
+    ASSERT_EQ(reference.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(reference.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    // The view and the copy agree
+    const LCQPow::OutputStatistics& all = reference.getOutputStatistics( );
+    LCQPow::OutputStatistics stats;
+    reference.getOutputStatistics( stats );
+    ASSERT_EQ(stats.getxStepsStdVec(), all.getxStepsStdVec());
+    ASSERT_EQ(stats.getStatValsStdVec(), all.getStatValsStdVec());
+
+    int n = all.getNumberOfxSteps();
+    ASSERT_GT(n, 2);
+    ASSERT_EQ(n, all.getNumberOfTrackedSteps());
+
+    // Invalid storage settings are rejected
+    ASSERT_EQ(options.setStepStorage(3), LCQPow::INVALID_ARGUMENT);
+    ASSERT_EQ(options.setStepStorageSize(0), LCQPow::INVALID_ARGUMENT);
+
+    for (int k = 1; k <= 2; k++) {
+        ASSERT_EQ(options.setStepStorage(k), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(options.setStepStorageSize(2), LCQPow::SUCCESSFUL_RETURN);
+
+        LCQPow::LCQProblem lcqp( 2, 0, 1 );
+        lcqp.setOptions( options );
+        ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        // The scalar trajectories are complete, the iterates are a subset of the reference
+        const LCQPow::OutputStatistics& part = lcqp.getOutputStatistics( );
+        ASSERT_EQ(part.getNumberOfTrackedSteps(), n);
+        ASSERT_EQ(part.getNumberOfxSteps(), k == 1 ? 2 : (n + 1)/2);
+
+        for (int i = 0; i < part.getNumberOfxSteps(); i++) {
+            int iter = part.getxStepIter(i);
+            ASSERT_EQ(iter, k == 1 ? n - 2 + i : 2*i);
+            ASSERT_EQ(part.getxStep(i)[0], all.getxStep(iter)[0]);
+            ASSERT_EQ(part.getxStep(i)[1], all.getxStep(iter)[1]);
+        }
+
+        ASSERT_TRUE(part.getxStep(part.getNumberOfxSteps()) == NULL);
+    }
+}
+
+// Testing the problem dump and its replay
+TEST(SolverTest, DumpAndReplay) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    double A[1*2] = {1.0, 1.0};
+    double lbA[1] = { -10.0 };
+    double ubA[1] = { 10.0 };
+    double x0[2] = { 0.5, 0.5 };
+
+    for (int k = 0; k < 2; k++) {
+        LCQPow::Options options;
+        options.setPrintLevel(LCQPow::PrintLevel::NONE);
+        options.setQPSolver( k == 0 ? LCQPow::QPOASES_DENSE : LCQPow::QPOASES_SPARSE );
+        options.setRandomSeed( 7 );
+        options.setMaxIterations( 321 );
+        options.setDumpFile( "lcqpow_test_dump.lcqp" );
+
+        LCQPow::LCQProblem lcqp( 2, 1, 1 );
+        lcqp.setOptions( options );
+        ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, A, lbA, ubA, 0, 0, x0 ), LCQPow::SUCCESSFUL_RETURN);
+
+        if (k == 1) {
+            ASSERT_EQ(lcqp.switchToSparseMode( ), LCQPow::SUCCESSFUL_RETURN);
+        }
+
+        ASSERT_EQ(lcqp.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        double x[2], xReplay[2];
+        lcqp.getPrimalSolution( x );
+
+        // The snapshot holds the data and options as passed to runSolver
+        LCQPow::LCQPContainer snapshot;
+        ASSERT_EQ(snapshot.open( "lcqpow_test_dump.lcqp" ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(snapshot.isSparse(), k == 1);
+        ASSERT_EQ(((const double*)snapshot.getSection( LCQPow::SECTION_X0 ))[0], 0.5);
+
+        LCQPow::Options replayOptions;
+        ASSERT_EQ(snapshot.getOptions( replayOptions ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(replayOptions.getQPSolver(), options.getQPSolver());
+        ASSERT_EQ(replayOptions.getRandomSeed(), 7u);
+        ASSERT_EQ(replayOptions.getMaxIterations(), 321);
+        ASSERT_EQ(replayOptions.getPrintLevel(), LCQPow::PrintLevel::NONE);
+        ASSERT_TRUE(replayOptions.getDumpFile() == NULL);
+
+        LCQPow::LCQProblem replay( 2, 1, 1 );
+        replay.setOptions( replayOptions );
+        ASSERT_EQ(snapshot.load( replay ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(replay.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        replay.getPrimalSolution( xReplay );
+        ASSERT_EQ(x[0], xReplay[0]);
+        ASSERT_EQ(x[1], xReplay[1]);
+    }
+
+    // Containers without options
+    ASSERT_EQ(LCQPow::LCQPContainer::write( "lcqpow_test_dump.lcqp", 2, 1, 1, Q, g, L, R, 0, 0, 0, 0, A, lbA, ubA ), LCQPow::SUCCESSFUL_RETURN);
+
+    LCQPow::LCQPContainer container;
+    LCQPow::Options options;
+    ASSERT_EQ(container.open( "lcqpow_test_dump.lcqp" ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(container.getOptions( options ), LCQPow::INVALID_ARGUMENT);
+
+    remove("lcqpow_test_dump.lcqp");
+}
+
+// Testing LCQPow solver set up
+TEST(SolverTest, RunWarmUp) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+
+	LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    lcqp.setOptions( options );
+
+    int numExp = 100;
+
+    // Allocate solution vectors
+    double* xOpt = new double[2];
+    double* yOpt = new double[nV + nC + 2*nComp];
+
+    for (int i = 0; i < numExp; i++) {
+
+        LCQPow::ReturnValue retVal = lcqp.loadLCQP( Q, g, L, R );
+        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+        retVal = lcqp.runSolver( );
+        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+        lcqp.getPrimalSolution( xOpt );
+        lcqp.getDualSolution( yOpt );
+
+        bool sStat1Found = (std::abs(xOpt[0] - 1) <= options.getStationarityTolerance()) && (std::abs(xOpt[1]) <= options.getStationarityTolerance());
+        bool sStat2Found = (std::abs(xOpt[1] - 1) <= options.getStationarityTolerance()) && (std::abs(xOpt[0]) <= options.getStationarityTolerance());
+
+        ASSERT_TRUE( sStat1Found || sStat2Found );
+
+        bool stat1 = std::abs(2*xOpt[0] - 2 - yOpt[0] - yOpt[2]) <= options.getStationarityTolerance();
+        bool stat2 = std::abs(2*xOpt[1] - 2 - yOpt[1] - yOpt[3]) <= options.getStationarityTolerance();
+
+        ASSERT_TRUE( stat1 );
+        ASSERT_TRUE( stat2 );
+    }
+
+    // Clear solution vectors
+    delete[] xOpt; delete[] yOpt;
+}
+
+// Testing repeated solves in sparse mode (Qk pattern is reused)
+TEST(SolverTest, RunSparseTwice) {
+    double Q_data[2] = { 2.0, 2.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double g[2] = { -2.0, 2.0 };
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    int L_p[3] = { 0, 1, 1 };
+    double R_data[1] = { 1.0 };
+    int R_i[1] = { 0 };
+    int R_p[3] = { 0, 0, 1 };
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+
+    csc* Q = LCQPow::Utilities::createCSC(nV, nV, 2, Q_data, Q_i, Q_p);
+    csc* L = LCQPow::Utilities::createCSC(nComp, nV, 1, L_data, L_i, L_p);
+    csc* R = LCQPow::Utilities::createCSC(nComp, nV, 1, R_data, R_i, R_p);
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setQPSolver(LCQPow::QPSolver::QPOASES_SPARSE);
+    lcqp.setOptions( options );
+
+    LCQPow::ReturnValue retVal = lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    double xOpt[2];
+
+    // The unique solution is x = (1, 0)
+    for (int i = 0; i < 2; i++) {
+        retVal = lcqp.runSolver( );
+        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+        lcqp.getPrimalSolution( xOpt );
+        ASSERT_NEAR(xOpt[0], 1, options.getStationarityTolerance());
+        ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+    }
+
+    // Only free the wrappers
+    free(Q); free(L); free(R);
+}
+
+// Testing that the cached iterate products (updated along the steps) reproduce phi at every tracked iterate
+TEST(SolverTest, CachedIterateEvaluation) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, -2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    double lbL[1] = { 0.5 };
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+
+    // Without and with a (one sided) complementarity lower bound, in dense and sparse mode
+    for (int run = 0; run < 4; run++) {
+        bool sparse = (run % 2 == 1);
+        double shift = (run < 2) ? 0 : lbL[0];
+        const double* const lbL_run = (run < 2) ? 0 : lbL;
+
+        LCQPow::LCQProblem lcqp( nV, nC, nComp );
+
+        LCQPow::Options options;
+        options.setPrintLevel(LCQPow::PrintLevel::NONE);
+        options.setStoreSteps(true);
+
+        if (sparse)
+            options.setQPSolver(LCQPow::QPSolver::QPOASES_SPARSE);
+
+        lcqp.setOptions( options );
+
+        LCQPow::ReturnValue retVal;
+
+        if (sparse) {
+            csc* Q_sparse = LCQPow::Utilities::dns_to_csc(Q, nV, nV);
+            csc* L_sparse = LCQPow::Utilities::dns_to_csc(L, nComp, nV);
+            csc* R_sparse = LCQPow::Utilities::dns_to_csc(R, nComp, nV);
+
+            retVal = lcqp.loadLCQP( Q_sparse, g, L_sparse, R_sparse, lbL_run );
+
+            LCQPow::Utilities::ClearSparseMat(&Q_sparse);
+            LCQPow::Utilities::ClearSparseMat(&L_sparse);
+            LCQPow::Utilities::ClearSparseMat(&R_sparse);
+        } else {
+            retVal = lcqp.loadLCQP( Q, g, L, R, lbL_run );
+        }
+
+        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+        retVal = lcqp.runSolver( );
+        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+        LCQPow::OutputStatistics stats;
+        lcqp.getOutputStatistics( stats );
+
+        std::vector<std::vector<double>> xSteps = stats.getxStepsStdVec();
+        std::vector<double> phiVals = stats.getPhiValsStdVec();
+        std::vector<double> objVals = stats.getObjValsStdVec();
+
+        ASSERT_EQ(xSteps.size(), phiVals.size());
+        ASSERT_GT(xSteps.size(), (size_t)1);
+
+        // phi(x) = (L*x - lbL)'*(R*x) = (x0 - lbL)*x1, obj(x) = x'*x - 2*(x0 + x1)
+        for (size_t k = 0; k < xSteps.size(); k++) {
+            double x0 = xSteps[k][0];
+            double x1 = xSteps[k][1];
+
+            ASSERT_NEAR(phiVals[k], (x0 - shift)*x1, 1e-12);
+            ASSERT_NEAR(objVals[k], x0*x0 + x1*x1 - 2*(x0 + x1), 1e-12);
+        }
+    }
+}
+
+// Testing that the OSQP workspace is set up exactly once per QP sequence (also when moving the subsolver) and required by hotstarts
+TEST(SolverTest, OSQPSetupCount) {
+    double Q_data[2] = { 2.0, 2.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double A_data[2] = { 1.0, 1.0 };
+    int A_i[2] = { 0, 1 };
+    int A_p[3] = { 0, 1, 2 };
+    double g[2] = { -2.0, 2.0 };
+    double lbA[2] = { 0.0, 0.0 };
+    double ubA[2] = { INFINITY, INFINITY };
+    int nV = 2;
+    int nC = 2;
+
+    csc* Q = LCQPow::Utilities::createCSC(nV, nV, 2, Q_data, Q_i, Q_p);
+    csc* A = LCQPow::Utilities::createCSC(nC, nV, 2, A_data, A_i, A_p);
+
+    LCQPow::Options options;
+
+    LCQPow::Subsolver subsolver;
+    LCQPow::ReturnValue retVal = subsolver.setUp( nV, nC, Q, A, LCQPow::QPSolver::OSQP_SPARSE );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    subsolver.setOptions( options.getOSQPOptions() );
+    ASSERT_EQ(subsolver.getNumberOfSetups(), 0);
+
+    // A hotstart without a workspace is rejected
+    int iter, exitFlag;
+    retVal = subsolver.solve( false, iter, exitFlag, g, lbA, ubA );
+    ASSERT_EQ(retVal, LCQPow::OSQP_WORKSPACE_NOT_SET_UP);
+
+    retVal = subsolver.solve( true, iter, exitFlag, g, lbA, ubA );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(subsolver.getNumberOfSetups(), 1);
+
+    // Moving the subsolver must not set up a new workspace
+    LCQPow::Subsolver moved( std::move(subsolver) );
+    ASSERT_EQ(moved.getNumberOfSetups(), 1);
+
+    // Hotstarts reuse the workspace
+    g[0] = -4.0;
+    retVal = moved.solve( false, iter, exitFlag, g, lbA, ubA );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(moved.getNumberOfSetups(), 1);
+
+    double x[2], y[2];
+    moved.getSolution( x, y );
+    ASSERT_NEAR(x[0], 2, 1e-2);
+    ASSERT_NEAR(x[1], 0, 1e-2);
+
+    // Invalid bounds are rejected by the update instead of solving with the previous ones
+    double lbInvalid[2] = { 1.0, 0.0 };
+    double ubInvalid[2] = { -1.0, INFINITY };
+    retVal = moved.solve( false, iter, exitFlag, g, lbInvalid, ubInvalid );
+    ASSERT_EQ(retVal, LCQPow::SUBPROBLEM_SOLVER_ERROR);
+
+    // New values of the same patterns are passed to the workspace by the next initial solve (Q = 4*I, i.e. x = (1, 0))
+    double Q_new_data[2] = { 4.0, 4.0 };
+    csc* Q_new = LCQPow::Utilities::createCSC(nV, nV, 2, Q_new_data, Q_i, Q_p);
+
+    ASSERT_TRUE(moved.updateMatrices( nV, nC, Q_new, A, LCQPow::QPSolver::OSQP_SPARSE ));
+    retVal = moved.solve( true, iter, exitFlag, g, lbA, ubA );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(moved.getNumberOfSetups(), 1);
+
+    moved.getSolution( x, y );
+    ASSERT_NEAR(x[0], 1, 1e-2);
+    ASSERT_NEAR(x[1], 0, 1e-2);
+
+    // Other patterns or solvers require a new set up
+    double Q_full_data[4] = { 4.0, 1.0, 1.0, 4.0 };
+    int Q_full_i[4] = { 0, 1, 0, 1 };
+    int Q_full_p[3] = { 0, 2, 4 };
+    csc* Q_full = LCQPow::Utilities::createCSC(nV, nV, 4, Q_full_data, Q_full_i, Q_full_p);
+
+    ASSERT_FALSE(moved.updateMatrices( nV, nC, Q_full, A, LCQPow::QPSolver::OSQP_SPARSE ));
+    ASSERT_FALSE(moved.updateMatrices( nV, nC, Q_new, A, LCQPow::QPSolver::QPOASES_SPARSE ));
+    ASSERT_FALSE(LCQPow::Subsolver().updateMatrices( nV, nC, Q_new, A, LCQPow::QPSolver::OSQP_SPARSE ));
+
+    // Only free the wrappers
+    free(Q); free(A); free(Q_new); free(Q_full);
+}
+
+// Testing the parametric update API (hotstarted resolves)
+TEST(SolverTest, ResolveUpdatedData) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    lcqp.setOptions( options );
+
+    LCQPow::ReturnValue retVal = lcqp.loadLCQP( Q, g, L, R );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    double xOpt[2];
+
+    // Resolve before runSolver falls back to a cold start
+    retVal = lcqp.resolve( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 1, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // New linear term: the solution moves to x = (2, 0)
+    double g_new[2] = { -4.0, 2.0 };
+    retVal = lcqp.updateLinearTerm( g_new );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    retVal = lcqp.resolve( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 2, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // New box constraints: the solution moves to x = (1.5, 0)
+    double lb_new[2] = { -10.0, -10.0 };
+    double ub_new[2] = { 1.5, 10.0 };
+    retVal = lcqp.updateBounds( lb_new, ub_new, 0, 0 );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    double x0[2] = { 0.0, 0.0 };
+    retVal = lcqp.resolve( x0 );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 1.5, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // Removing the box constraints again (and comparing against a cold start)
+    retVal = lcqp.updateBounds( 0, 0, 0, 0 );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    retVal = lcqp.resolve( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    double xCold[2];
+    lcqp.getPrimalSolution( xOpt );
+    retVal = lcqp.runSolver( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqp.getPrimalSolution( xCold );
+    for (int i = 0; i < nV; i++)
+        ASSERT_NEAR(xOpt[i], xCold[i], options.getStationarityTolerance());
+}
+
+// Testing that hotstarted resolves do not allocate and cold solves only allocate in the subsolver set up (malloc of OSQP is not counted)
+TEST(SolverTest, NoAllocationsInResolve) {
+    double Q_data[2] = { 2.0, 2.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double g[2] = { 2.0, 2.0 };
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    int L_p[3] = { 0, 1, 1 };
+    double R_data[1] = { 1.0 };
+    int R_i[1] = { 0 };
+    int R_p[3] = { 0, 0, 1 };
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+
+    csc* Q = LCQPow::Utilities::createCSC(nV, nV, 2, Q_data, Q_i, Q_p);
+    csc* L = LCQPow::Utilities::createCSC(nComp, nV, 1, L_data, L_i, L_p);
+    csc* R = LCQPow::Utilities::createCSC(nComp, nV, 1, R_data, R_i, R_p);
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setQPSolver(LCQPow::QPSolver::OSQP_SPARSE);
+    lcqp.setOptions( options );
+
+    LCQPow::ReturnValue retVal = lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    // The first run sets up the subsolver
+    retVal = lcqp.runSolver( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    // The unique solution x = (0, 0) is weakly complementary (exercises the stationarity type check)
+    double g_new[2] = { 4.0, 2.0 };
+    retVal = lcqp.updateLinearTerm( g_new );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    size_t allocationsBefore = allocationCount;
+    retVal = lcqp.resolve( );
+    size_t allocations = allocationCount - allocationsBefore;
+
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(allocations, 0u);
+
+    double xOpt[2];
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 0, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // A cold solve sets up the subsolver again (copies of the matrices, OSQP workspace), the LCQProblem side reuses its memory
+    double LR_data[2] = { 1.0, 1.0 };
+    int LR_i[2] = { 0, 1 };
+    int LR_p[3] = { 0, 1, 2 };
+    double lbLR[2] = { 0.0, 0.0 };
+    double ubLR[2] = { INFINITY, INFINITY };
+    csc* LR = LCQPow::Utilities::createCSC(2*nComp, nV, 2, LR_data, LR_i, LR_p);
+
+    int iter, exitFlag;
+    LCQPow::Subsolver subsolver;
+    allocationsBefore = allocationCount;
+    ASSERT_EQ(subsolver.setUp( nV, 2*nComp, Q, LR, LCQPow::QPSolver::OSQP_SPARSE ), LCQPow::SUCCESSFUL_RETURN);
+    subsolver.setOptions( options.getOSQPOptions() );
+    ASSERT_EQ(subsolver.solve( true, iter, exitFlag, g, lbLR, ubLR ), LCQPow::SUCCESSFUL_RETURN);
+    size_t subsolverAllocations = allocationCount - allocationsBefore;
+
+    allocationsBefore = allocationCount;
+    retVal = lcqp.runSolver( );
+    allocations = allocationCount - allocationsBefore;
+
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(allocations, subsolverAllocations);
+
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 0, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // Only free the wrappers
+    free(Q); free(L); free(R); free(LR);
+}
+
+// Testing that large sparse problems do not reserve a dense Qk (nV*nV would exceed the range of int)
+TEST(SolverTest, LargeSparseWorkspace) {
+    int nV = 60000;
+    int nComp = 1;
+
+    std::vector<double> Q_data((size_t)nV, 2.0);
+    std::vector<int> Q_i((size_t)nV);
+    std::vector<int> Q_p((size_t)nV + 1);
+    for (int j = 0; j < nV; j++) {
+        Q_i[(size_t)j] = j;
+        Q_p[(size_t)j + 1] = j + 1;
+    }
+
+    std::vector<double> g((size_t)nV, 1.0);
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    double R_data[1] = { 1.0 };
+    int R_i[1] = { 0 };
+    std::vector<int> L_p((size_t)nV + 1, 1);
+    std::vector<int> R_p((size_t)nV + 1, 1);
+    L_p[0] = 0;
+    R_p[0] = 0;
+    R_p[1] = 0;
+
+    csc* Q = LCQPow::Utilities::createCSC(nV, nV, nV, Q_data.data(), Q_i.data(), Q_p.data());
+    csc* L = LCQPow::Utilities::createCSC(nComp, nV, 1, L_data, L_i, L_p.data());
+    csc* R = LCQPow::Utilities::createCSC(nComp, nV, 1, R_data, R_i, R_p.data());
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+    LCQPow::LCQProblem lcqp( nV, 0, nComp );
+    lcqp.setOptions( options );
+    ASSERT_EQ(lcqp.loadLCQP( Q, g.data(), L, R, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ), LCQPow::SUCCESSFUL_RETURN);
+
+    // Copies only hold the vectors and sparse matrices as well
+    LCQPow::LCQProblem copy( lcqp );
+    ASSERT_EQ(copy.getNumberOfPrimals(), nV);
+
+    // Only free the wrappers
+    free(Q); free(L); free(R);
+}
+
+// Testing that an object can be reloaded with problems of the same dimensions (and reset) without allocating
+TEST(SolverTest, ReloadProblem) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    double A[1*2] = {1.0, 1.0};
+    double lbA[1] = { -100.0 };
+    double ubA[1] = { 100.0 };
+    int nV = 2;
+    int nC = 1;
+    int nComp = 1;
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    lcqp.setOptions( options );
+
+    double xOpt[2];
+    size_t liveAllocations[4];
+
+    // Linear terms g_k = (-2*(1 + k), 2), i.e. the unique solutions are x_k = (1 + k, 0)
+    for (int k = 0; k < 4; k++) {
+        double g[2] = { -2.0*(1.0 + k), 2.0 };
+
+        size_t allocationsBefore = allocationCount;
+        LCQPow::ReturnValue retVal = lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, A, lbA, ubA );
+        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+        // Loads after the first one reuse the memory
+        if (k > 0) {
+            ASSERT_EQ(allocationCount - allocationsBefore, 0u);
+        }
+
+        retVal = lcqp.runSolver( );
+        ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+        lcqp.getPrimalSolution( xOpt );
+        ASSERT_NEAR(xOpt[0], 1.0 + k, options.getStationarityTolerance());
+        ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+        liveAllocations[k] = allocationCount - deallocationCount;
+    }
+
+    // The solves do not accumulate memory either
+    ASSERT_EQ(liveAllocations[2], liveAllocations[1]);
+    ASSERT_EQ(liveAllocations[3], liveAllocations[1]);
+
+    // After a reset the next resolve starts cold from the initial guess
+    lcqp.reset( );
+
+    LCQPow::OutputStatistics stats;
+    lcqp.getOutputStatistics( stats );
+    ASSERT_EQ(stats.getIterTotal(), 0);
+    ASSERT_EQ(lcqp.getPrimalSolution( xOpt ), LCQPow::AlgorithmStatus::PROBLEM_NOT_SOLVED);
+
+    LCQPow::ReturnValue retVal = lcqp.resolve( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 4, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+}
+
+// Testing the borrowed-data mode (no copies of Q, L, R) against the regular load
+TEST(SolverTest, BorrowedData) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+    // Dense: the unique solution is x = (1, 0)
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+    lcqp.setOptions( options );
+
+    LCQPow::ReturnValue retVal = lcqp.loadLCQPBorrowed( Q, g, L, R );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    retVal = lcqp.runSolver( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    double xOpt[2];
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 1, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // A copy shares the borrowed matrices
+    LCQPow::LCQProblem lcqpCopy( lcqp );
+    retVal = lcqpCopy.runSolver( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqpCopy.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 1, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // Switching to sparse mode creates owned sparse matrices
+    options.setQPSolver(LCQPow::QPSolver::QPOASES_SPARSE);
+    lcqp.setOptions( options );
+    ASSERT_EQ(lcqp.switchToSparseMode( ), LCQPow::SUCCESSFUL_RETURN);
+
+    retVal = lcqp.runSolver( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqp.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 1, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // Sparse
+    double Q_data[2] = { 2.0, 2.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    int L_p[3] = { 0, 1, 1 };
+    double R_data[1] = { 1.0 };
+    int R_i[1] = { 0 };
+    int R_p[3] = { 0, 0, 1 };
+
+    csc* Q_sparse = LCQPow::Utilities::createCSC(nV, nV, 2, Q_data, Q_i, Q_p);
+    csc* L_sparse = LCQPow::Utilities::createCSC(nComp, nV, 1, L_data, L_i, L_p);
+    csc* R_sparse = LCQPow::Utilities::createCSC(nComp, nV, 1, R_data, R_i, R_p);
+
+    LCQPow::LCQProblem lcqpSparse( nV, nC, nComp );
+    lcqpSparse.setOptions( options );
+
+    retVal = lcqpSparse.loadLCQPBorrowed( Q_sparse, g, L_sparse, R_sparse );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    retVal = lcqpSparse.runSolver( );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+
+    lcqpSparse.getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 1, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    // A regular load after a borrowed one must not release the user data
+    retVal = lcqpSparse.loadLCQP( Q_sparse, g, L_sparse, R_sparse );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(Q_sparse->x, Q_data);
+    ASSERT_EQ(L_sparse->i, L_i);
+
+    // The user data is unchanged
+    ASSERT_EQ(Q[0], 2.0);
+    ASSERT_EQ(Q[3], 2.0);
+    ASSERT_EQ(Q_data[0], 2.0);
+    ASSERT_EQ(R_data[0], 1.0);
+
+    // Only free the wrappers
+    free(Q_sparse); free(L_sparse); free(R_sparse);
+}
+
+// Testing the batch solver against serial solves
+TEST(BatchSolverTest, MatchesSerial) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+    int nInstances = 16;
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+    lcqp.setOptions( options );
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+
+    // Linear terms g_i = (-2*(1 + i/10), 2), i.e. the unique solutions are x_i = (1 + i/10, 0)
+    std::vector<double> gBatch((size_t)(nInstances*nV));
+    for (int i = 0; i < nInstances; i++) {
+        gBatch[(size_t)(i*nV)] = -2.0*(1.0 + i/10.0);
+        gBatch[(size_t)(i*nV + 1)] = 2.0;
+    }
+
+    LCQPow::LCQBatchSolver batch( lcqp, 4 );
+    LCQPow::ReturnValue retVal = batch.solve( nInstances, gBatch.data() );
+    ASSERT_EQ(retVal, LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(batch.getNumberOfInstances(), nInstances);
+
+    double xBatch[2];
+    double xSerial[2];
+
+    for (int i = 0; i < nInstances; i++) {
+        LCQPow::LCQProblem serial( nV, nC, nComp );
+        serial.setOptions( options );
+        ASSERT_EQ(serial.loadLCQP( Q, &gBatch[(size_t)(i*nV)], L, R ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(serial.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        ASSERT_EQ(batch.getReturnValue(i), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(batch.getPrimalSolution(i, xBatch), serial.getPrimalSolution(xSerial));
+
+        ASSERT_NEAR(xBatch[0], xSerial[0], options.getStationarityTolerance());
+        ASSERT_NEAR(xBatch[1], xSerial[1], options.getStationarityTolerance());
+        ASSERT_NEAR(xBatch[0], 1.0 + i/10.0, options.getStationarityTolerance());
+        ASSERT_NEAR(xBatch[1], 0.0, options.getStationarityTolerance());
+    }
+}
+
+// Testing that hotstarting workers set up their subsolver once and hotstart it for the following instances of their range
+TEST(BatchSolverTest, HotstartsWorkers) {
+    double Q_data[2] = { 2.0, 2.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double g[2] = { -2.0, 2.0 };
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    int L_p[3] = { 0, 1, 1 };
+    double R_data[1] = { 1.0 };
+    int R_i[1] = { 0 };
+    int R_p[3] = { 0, 0, 1 };
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+    int nInstances = 16;
+    int nThreads = 4;
+
+    csc* Q = LCQPow::Utilities::createCSC(nV, nV, 2, Q_data, Q_i, Q_p);
+    csc* L = LCQPow::Utilities::createCSC(nComp, nV, 1, L_data, L_i, L_p);
+    csc* R = LCQPow::Utilities::createCSC(nComp, nV, 1, R_data, R_i, R_p);
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setQPSolver(LCQPow::QPSolver::OSQP_SPARSE);
+    options.setStoreSteps(true);
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+    lcqp.setOptions( options );
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ), LCQPow::SUCCESSFUL_RETURN);
+
+    // Linear terms g_i = (-2*(1 + i/10), 2), i.e. the unique solutions are x_i = (1 + i/10, 0)
+    std::vector<double> gBatch((size_t)(nInstances*nV));
+    for (int i = 0; i < nInstances; i++) {
+        gBatch[(size_t)(i*nV)] = -2.0*(1.0 + i/10.0);
+        gBatch[(size_t)(i*nV + 1)] = 2.0;
+    }
+
+    LCQPow::LCQBatchSolver batch( lcqp, nThreads, true );
+    ASSERT_EQ(batch.solve( nInstances, gBatch.data() ), LCQPow::SUCCESSFUL_RETURN);
+
+    // Only the first QP of a cold start sets up (and factorizes) a new OSQP workspace
+    int coldStarts = 0;
+    double xBatch[2];
+
+    for (int i = 0; i < nInstances; i++) {
+        LCQPow::OutputStatistics stats;
+        batch.getOutputStatistics( i, stats );
+        ASSERT_GT(stats.getSubproblemFactorizationsStdVec().size(), 0u);
+
+        bool coldStart = stats.getSubproblemFactorizationsStdVec()[0] > stats.getSubproblemRhoUpdatesStdVec()[0];
+
+        // Each worker cold starts the first instance of its range only
+        ASSERT_EQ(coldStart, i % (nInstances/nThreads) == 0);
+
+        if (coldStart)
+            coldStarts++;
+
+        ASSERT_EQ(batch.getReturnValue(i), LCQPow::SUCCESSFUL_RETURN);
+        batch.getPrimalSolution( i, xBatch );
+        ASSERT_NEAR(xBatch[0], 1.0 + i/10.0, options.getStationarityTolerance());
+        ASSERT_NEAR(xBatch[1], 0.0, options.getStationarityTolerance());
+    }
+
+    ASSERT_EQ(coldStarts, nThreads);
+
+    // Only free the wrappers
+    free(Q); free(L); free(R);
+}
+
+// Testing that the results of a batch do not depend on the number of threads (and are reproducible when hotstarting)
+TEST(BatchSolverTest, ReproducibleResults) {
+    double Q_data[2] = { 2.0, 2.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double g[2] = { -2.0, 2.0 };
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    int L_p[3] = { 0, 1, 1 };
+    double R_data[1] = { 1.0 };
+    int R_i[1] = { 0 };
+    int R_p[3] = { 0, 0, 1 };
+    int nV = 2;
+    int nC = 0;
+    int nComp = 1;
+    int nInstances = 16;
+
+    csc* Q = LCQPow::Utilities::createCSC(nV, nV, 2, Q_data, Q_i, Q_p);
+    csc* L = LCQPow::Utilities::createCSC(nComp, nV, 1, L_data, L_i, L_p);
+    csc* R = LCQPow::Utilities::createCSC(nComp, nV, 1, R_data, R_i, R_p);
+
+    // OSQP is an iterative solver, i.e. its result depends on where it is started from
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setQPSolver(LCQPow::QPSolver::OSQP_SPARSE);
+
+    LCQPow::LCQProblem lcqp( nV, nC, nComp );
+    lcqp.setOptions( options );
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ), LCQPow::SUCCESSFUL_RETURN);
+
+    std::vector<double> gBatch((size_t)(nInstances*nV));
+    for (int i = 0; i < nInstances; i++) {
+        gBatch[(size_t)(i*nV)] = -2.0*(1.0 + i/10.0);
+        gBatch[(size_t)(i*nV + 1)] = 2.0 - i/10.0;
+    }
+
+    LCQPow::LCQBatchSolver serial( lcqp, 1 );
+    LCQPow::LCQBatchSolver parallel( lcqp, 4 );
+    LCQPow::LCQBatchSolver hotstarted( lcqp, 4, true );
+    LCQPow::LCQBatchSolver hotstartedAgain( lcqp, 4, true );
+
+    ASSERT_EQ(serial.solve( nInstances, gBatch.data() ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(parallel.solve( nInstances, gBatch.data() ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(hotstarted.solve( nInstances, gBatch.data() ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(hotstartedAgain.solve( nInstances, gBatch.data() ), LCQPow::SUCCESSFUL_RETURN);
+
+    int nDuals = serial.getNumberOfDuals();
+    std::vector<double> x1((size_t)nV), x2((size_t)nV), y1((size_t)nDuals), y2((size_t)nDuals);
+
+    for (int i = 0; i < nInstances; i++) {
+        // Bit-identical solutions
+        serial.getPrimalSolution( i, x1.data() );
+        serial.getDualSolution( i, y1.data() );
+        parallel.getPrimalSolution( i, x2.data() );
+        parallel.getDualSolution( i, y2.data() );
+
+        ASSERT_EQ(memcmp(x1.data(), x2.data(), (size_t)nV*sizeof(double)), 0);
+        ASSERT_EQ(memcmp(y1.data(), y2.data(), (size_t)nDuals*sizeof(double)), 0);
+
+        hotstarted.getPrimalSolution( i, x1.data() );
+        hotstarted.getDualSolution( i, y1.data() );
+        hotstartedAgain.getPrimalSolution( i, x2.data() );
+        hotstartedAgain.getDualSolution( i, y2.data() );
+
+        ASSERT_EQ(memcmp(x1.data(), x2.data(), (size_t)nV*sizeof(double)), 0);
+        ASSERT_EQ(memcmp(y1.data(), y2.data(), (size_t)nDuals*sizeof(double)), 0);
+    }
+
+    // Only free the wrappers
+    free(Q); free(L); free(R);
+}
+
+// Testing a dump file on a multi-threaded batch (only the template is dumped, on the calling thread)
+TEST(BatchSolverTest, DumpFile) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -6.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    int nV = 2;
+    int nInstances = 16;
+    const char* file = "lcqpow_test_batch.lcqp";
+
+    remove(file);
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setDumpFile(file);
+
+    LCQPow::LCQProblem lcqp( nV, 0, 1 );
+    lcqp.setOptions( options );
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+
+    std::vector<double> gBatch((size_t)(nInstances*nV));
+    for (int i = 0; i < nInstances; i++) {
+        gBatch[(size_t)(i*nV)] = -2.0*(1.0 + i/10.0);
+        gBatch[(size_t)(i*nV + 1)] = 2.0;
+    }
+
+    LCQPow::LCQBatchSolver batch( lcqp, 4 );
+    ASSERT_EQ(batch.solve( nInstances, gBatch.data() ), LCQPow::SUCCESSFUL_RETURN);
+
+    // The dump holds the template (not an instance), i.e. its replay yields x = (3, 0)
+    LCQPow::LCQPContainer container;
+    ASSERT_EQ(container.open( file ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(container.getNV(), nV);
+
+    options.setDumpFile(NULL);
+    LCQPow::LCQProblem replay( nV, 0, 1 );
+    replay.setOptions( options );
+    ASSERT_EQ(container.load( replay ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(replay.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    double x[2];
+    replay.getPrimalSolution( x );
+    ASSERT_NEAR(x[0], 3.0, options.getStationarityTolerance());
+    ASSERT_NEAR(x[1], 0.0, options.getStationarityTolerance());
+    container.close();
+
+    remove(file);
+}
+
+// Testing a step file on a multi-threaded batch (the iterates are kept in the statistics of the instances)
+TEST(BatchSolverTest, StepFile) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    int nInstances = 16;
+    const char* file = "lcqpow_test_batch_steps.bin";
+
+    remove(file);
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setStoreSteps(true);
+    options.setStepFile(file);
+
+    LCQPow::LCQProblem lcqp( 2, 0, 1 );
+    lcqp.setOptions( options );
+    ASSERT_EQ(lcqp.loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+
+    LCQPow::LCQBatchSolver batch( lcqp, 4 );
+    ASSERT_EQ(batch.solve( nInstances ), LCQPow::SUCCESSFUL_RETURN);
+
+    for (int i = 0; i < nInstances; i++) {
+        LCQPow::OutputStatistics stats;
+        batch.getOutputStatistics( i, stats );
+        ASSERT_GT(stats.getNumberOfxSteps(), 0);
+        ASSERT_EQ(stats.getNumberOfxSteps(), stats.getNumberOfTrackedSteps());
+    }
+
+    std::ifstream steps(file);
+    ASSERT_FALSE(steps.good());
+}
+
+// Testing the problem pool (reuse, limits and concurrent requests)
+TEST(PoolTest, AcquireAndRelease) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double g[2] = { -2.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+    LCQPow::LCQProblemPool pool( options, 4, 2 );
+    LCQPow::LCQProblemShape shape = { 2, 0, 1, 0 };
+    LCQPow::LCQProblemShape other = { 2, 0, 1, 1 };
+    LCQPow::LCQProblemShape third = { 3, 0, 1, 0 };
+    LCQPow::LCQProblemShape invalid = { 0, 0, 1, 0 };
+
+    ASSERT_TRUE(pool.acquire( invalid ) == NULL);
+
+    LCQPow::LCQProblem* first = pool.acquire( shape );
+    ASSERT_TRUE(first != NULL);
+    ASSERT_EQ(first->loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(first->runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    ASSERT_EQ(pool.release( first ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(pool.release( first ), LCQPow::INVALID_ARGUMENT);
+    ASSERT_EQ(pool.getNumberOfIdle( shape ), 1);
+
+    // Released objects are only handed out for their shape
+    LCQPow::LCQProblem* second = pool.acquire( other );
+    ASSERT_TRUE(second != first);
+    ASSERT_TRUE(pool.acquire( shape ) == first);
+    ASSERT_EQ(pool.getNumberOfReused(), 1);
+
+    // The reset object solves the next problem
+    double xOpt[2];
+    double g_new[2] = { -4.0, 2.0 };
+    ASSERT_EQ(first->getPrimalSolution( xOpt ), LCQPow::AlgorithmStatus::PROBLEM_NOT_SOLVED);
+    ASSERT_EQ(first->loadLCQP( Q, g_new, L, R ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(first->runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+    first->getPrimalSolution( xOpt );
+    ASSERT_NEAR(xOpt[0], 2, options.getStationarityTolerance());
+    ASSERT_NEAR(xOpt[1], 0, options.getStationarityTolerance());
+
+    ASSERT_EQ(pool.release( first ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(pool.release( second ), LCQPow::SUCCESSFUL_RETURN);
+
+    // Limits per shape and in total (the least recently released objects are evicted)
+    ASSERT_EQ(pool.warmUp( shape, 3 ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(pool.getNumberOfIdle( shape ), 2);
+
+    ASSERT_EQ(pool.warmUp( other, 1 ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(pool.getNumberOfIdle( other ), 2);
+
+    // Evicts second (released before the objects created by warmUp)
+    ASSERT_EQ(pool.warmUp( third, 1 ), LCQPow::SUCCESSFUL_RETURN);
+    ASSERT_EQ(pool.getNumberOfIdle( ), 4);
+    ASSERT_EQ(pool.getNumberOfIdle( other ), 1);
+    ASSERT_EQ(pool.getNumberOfIdle( shape ), 2);
+    ASSERT_EQ(pool.getNumberOfIdle( third ), 1);
+
+    // Concurrent requests, the linear terms g_i = (-2*(1 + i/10), 2) yield the solutions x_i = (1 + i/10, 0)
+    int nThreads = 8;
+    int nRequests = 10;
+    int nCreated = pool.getNumberOfCreated();
+    std::atomic<int> failures( 0 );
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < nThreads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            for (int k = 0; k < nRequests; k++) {
+                int i = t*nRequests + k;
+                double g_i[2] = { -2.0*(1.0 + i/10.0), 2.0 };
+                double x_i[2];
+
+                LCQPow::LCQProblem* lcqp = pool.acquire( shape );
+                if (lcqp->loadLCQP( Q, g_i, L, R ) != LCQPow::SUCCESSFUL_RETURN || lcqp->runSolver( ) != LCQPow::SUCCESSFUL_RETURN)
+                    failures++;
+
+                lcqp->getPrimalSolution( x_i );
+                if (std::abs(x_i[0] - (1.0 + i/10.0)) > options.getStationarityTolerance() || std::abs(x_i[1]) > options.getStationarityTolerance())
+                    failures++;
+
+                if (pool.release( lcqp ) != LCQPow::SUCCESSFUL_RETURN)
+                    failures++;
+            }
+        }));
+    }
+
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    ASSERT_EQ(failures.load(), 0);
+    ASSERT_LE(pool.getNumberOfCreated() - nCreated, nThreads);
+
+    // Fingerprints distinguish sparsity patterns
+    double Q_data[2] = { 2.0, 2.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    int L_p[3] = { 0, 1, 1 };
+    int R_p[3] = { 0, 0, 1 };
+
+    csc* Q_sparse = LCQPow::Utilities::createCSC(2, 2, 2, Q_data, Q_i, Q_p);
+    csc* L_sparse = LCQPow::Utilities::createCSC(1, 2, 1, L_data, L_i, L_p);
+    csc* R_sparse = LCQPow::Utilities::createCSC(1, 2, 1, L_data, L_i, R_p);
+
+    size_t fingerprint = LCQPow::LCQProblemPool::getFingerprint( Q_sparse, L_sparse, R_sparse );
+    ASSERT_EQ(fingerprint, LCQPow::LCQProblemPool::getFingerprint( Q_sparse, L_sparse, R_sparse ));
+    ASSERT_NE(fingerprint, LCQPow::LCQProblemPool::getFingerprint( Q_sparse, R_sparse, L_sparse ));
+    ASSERT_NE(fingerprint, 0u);
+
+    free(Q_sparse); free(L_sparse); free(R_sparse);
+}
+
+// Testing that reused objects of a pool keep their subsolver and solve with the values of the new matrices
+TEST(PoolTest, KeepsSubsolver) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double Q_new[2*2] = { 4.0, 0.0, 0.0, 4.0 };
+    double g[2] = { -8.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+
+    double Q_data[2] = { 2.0, 2.0 };
+    double Q_new_data[2] = { 4.0, 4.0 };
+    int Q_i[2] = { 0, 1 };
+    int Q_p[3] = { 0, 1, 2 };
+    double L_data[1] = { 1.0 };
+    int L_i[1] = { 0 };
+    int L_p[3] = { 0, 1, 1 };
+    double R_data[1] = { 1.0 };
+    int R_i[1] = { 0 };
+    int R_p[3] = { 0, 0, 1 };
+
+    csc* Q_sparse = LCQPow::Utilities::createCSC(2, 2, 2, Q_data, Q_i, Q_p);
+    csc* Q_new_sparse = LCQPow::Utilities::createCSC(2, 2, 2, Q_new_data, Q_i, Q_p);
+    csc* L_sparse = LCQPow::Utilities::createCSC(1, 2, 1, L_data, L_i, L_p);
+    csc* R_sparse = LCQPow::Utilities::createCSC(1, 2, 1, R_data, R_i, R_p);
+
+    for (int solver = 0; solver < 2; solver++) {
+        LCQPow::Options options;
+        options.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+        LCQPow::LCQProblemShape shape = { 2, 0, 1, 0 };
+
+        if (solver == 1) {
+            options.setQPSolver(LCQPow::QPSolver::OSQP_SPARSE);
+            shape.fingerprint = LCQPow::LCQProblemPool::getFingerprint( Q_sparse, L_sparse, R_sparse );
+        }
+
+        LCQPow::LCQProblemPool pool( options );
+
+        // Q = 2*I, i.e. x = (4, 0)
+        LCQPow::LCQProblem* lcqp = pool.acquire( shape );
+        ASSERT_TRUE(lcqp != NULL);
+
+        if (solver == 0)
+            ASSERT_EQ(lcqp->loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+        else
+            ASSERT_EQ(lcqp->loadLCQP( Q_sparse, g, L_sparse, R_sparse, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ), LCQPow::SUCCESSFUL_RETURN);
+
+        ASSERT_EQ(lcqp->runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        double x[2];
+        lcqp->getPrimalSolution( x );
+        ASSERT_NEAR(x[0], 4, options.getStationarityTolerance());
+        ASSERT_NEAR(x[1], 0, options.getStationarityTolerance());
+        ASSERT_EQ(pool.release( lcqp ), LCQPow::SUCCESSFUL_RETURN);
+
+        // Q = 4*I on the reused object, i.e. x = (2, 0) (x = (4, 0) if the subsolver kept the previous values)
+        ASSERT_TRUE(pool.acquire( shape ) == lcqp);
+
+        if (solver == 0)
+            ASSERT_EQ(lcqp->loadLCQP( Q_new, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+        else
+            ASSERT_EQ(lcqp->loadLCQP( Q_new_sparse, g, L_sparse, R_sparse, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ), LCQPow::SUCCESSFUL_RETURN);
+
+        ASSERT_EQ(lcqp->runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        lcqp->getPrimalSolution( x );
+        ASSERT_NEAR(x[0], 2, options.getStationarityTolerance());
+        ASSERT_NEAR(x[1], 0, options.getStationarityTolerance());
+        ASSERT_EQ(pool.release( lcqp ), LCQPow::SUCCESSFUL_RETURN);
+    }
+
+    // Only free the wrappers
+    free(Q_sparse); free(Q_new_sparse); free(L_sparse); free(R_sparse);
+}
+
+// Testing that the objects of a pool dump and stream steps to their own files
+TEST(PoolTest, ObjectFiles) {
+    double Q[2*2] = { 2.0, 0.0, 0.0, 2.0 };
+    double L[1*2] = {1.0, 0.0};
+    double R[1*2] = {0.0, 1.0};
+    const char* files[2] = { "lcqpow_test_pool.0.lcqp", "lcqpow_test_pool.1.lcqp" };
+    const char* stepFiles[2] = { "lcqpow_test_pool_steps.0.bin", "lcqpow_test_pool_steps.1.bin" };
+
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::NONE);
+    options.setDumpFile("lcqpow_test_pool.lcqp");
+    options.setStoreSteps(true);
+    options.setStepFile("lcqpow_test_pool_steps.bin");
+
+    LCQPow::LCQProblemPool pool( options );
+    LCQPow::LCQProblemShape shape = { 2, 0, 1, 0 };
+
+    LCQPow::LCQProblem* lcqp[2];
+    for (int k = 0; k < 2; k++) {
+        double g[2] = { -2.0*(1.0 + k), 2.0 };
+
+        lcqp[k] = pool.acquire( shape );
+        ASSERT_TRUE(lcqp[k] != NULL);
+        ASSERT_EQ(lcqp[k]->loadLCQP( Q, g, L, R ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(lcqp[k]->runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+    }
+
+    // Each dump replays the problem of its object, i.e. x_k = (1 + k, 0)
+    for (int k = 0; k < 2; k++) {
+        LCQPow::LCQPContainer container;
+        ASSERT_EQ(container.open( files[k] ), LCQPow::SUCCESSFUL_RETURN);
+
+        LCQPow::Options replayOptions;
+        replayOptions.setPrintLevel(LCQPow::PrintLevel::NONE);
+
+        LCQPow::LCQProblem replay( 2, 0, 1 );
+        replay.setOptions( replayOptions );
+        ASSERT_EQ(container.load( replay ), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(replay.runSolver( ), LCQPow::SUCCESSFUL_RETURN);
+
+        double x[2];
+        replay.getPrimalSolution( x );
+        ASSERT_NEAR(x[0], 1.0 + k, options.getStationarityTolerance());
+        container.close();
+
+        // The last iterate of the object's step file (binary, see the extension) is its solution
+        LCQPow::OutputStatistics stats;
+        lcqp[k]->getOutputStatistics( stats );
+        std::vector<double> steps((size_t)(2*stats.getNumberOfTrackedSteps()));
+        ASSERT_EQ(LCQPow::Utilities::readFromFile(steps.data(), (int)steps.size(), stepFiles[k]), LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_NEAR(steps[steps.size() - 2], 1.0 + k, options.getStationarityTolerance());
+
+        ASSERT_EQ(pool.release( lcqp[k] ), LCQPow::SUCCESSFUL_RETURN);
+        remove(files[k]);
+        remove(stepFiles[k]);
+    }
+}
+
+// Collects the output of a solver object (see SolverTest.ConcurrentSolvesMatchSerial)
+static void appendMessage( const char* message, void* userData )
+{
+    static_cast<std::string*>(userData)->append(message);
+}
+
+// Testing that solver objects on different threads share no state (iterates and output are equal to serial solves)
+TEST(SolverTest, ConcurrentSolvesMatchSerial) {
+    double Q[4*4] = { 2.0, 0.5, 0.0, 0.0,
+                      0.5, 2.0, 0.5, 0.0,
+                      0.0, 0.5, 2.0, 0.5,
+                      0.0, 0.0, 0.5, 2.0 };
+    double L[2*4] = { 1.0, 0.0, 0.0, 0.0,
+                      0.0, 1.0, 0.0, 0.0 };
+    double R[2*4] = { 0.0, 0.0, 1.0, 0.0,
+                      0.0, 0.0, 0.0, 1.0 };
+    double A[1*4] = { 1.0, 1.0, 1.0, 1.0 };
+    double lbA[1] = { -10.0 };
+    double ubA[1] = { 10.0 };
+    int nV = 4;
+    int nC = 1;
+    int nComp = 2;
+    int nInstances = 64;
+
+    // Step perturbations and printing enabled
+    LCQPow::Options options;
+    options.setPrintLevel(LCQPow::PrintLevel::INNER_LOOP_ITERATES);
+    options.setPerturbStep(true);
+    options.setRandomSeed(7);
+
+    struct Result {
+        LCQPow::ReturnValue ret;
+        std::vector<double> x;
+        std::vector<double> y;
+        int iterTotal;
+        std::string output;
+    };
+
+    auto solve = [&]( int i, Result& result ) {
+        LCQPow::MessageHandler::SetMessageSink( appendMessage, &result.output );
+
+        double g[4] = { -1.0 - i/16.0, -1.0 + i/32.0, -2.0 + i/64.0, 0.5 - i/16.0 };
+
+        LCQPow::LCQProblem lcqp( nV, nC, nComp );
+        lcqp.setOptions( options );
+        lcqp.loadLCQP( Q, g, L, R, 0, 0, 0, 0, A, lbA, ubA );
+        result.ret = lcqp.runSolver( );
+
+        result.x.resize((size_t)lcqp.getNumberOfPrimals());
+        result.y.resize((size_t)lcqp.getNumberOfDuals());
+        lcqp.getPrimalSolution( result.x.data() );
+        lcqp.getDualSolution( result.y.data() );
+
+        LCQPow::OutputStatistics stats;
+        lcqp.getOutputStatistics( stats );
+        result.iterTotal = stats.getIterTotal();
+
+        LCQPow::MessageHandler::SetMessageSink( NULL );
+    };
+
+    std::vector<Result> serial((size_t)nInstances);
+    for (int i = 0; i < nInstances; i++)
+        solve( i, serial[(size_t)i] );
+
+    std::vector<Result> concurrent((size_t)nInstances);
+    std::vector<std::thread> workers;
+
+    for (int i = 0; i < nInstances; i++)
+        workers.push_back(std::thread(solve, i, std::ref(concurrent[(size_t)i])));
+
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    for (size_t i = 0; i < (size_t)nInstances; i++) {
+        ASSERT_EQ(serial[i].ret, LCQPow::SUCCESSFUL_RETURN);
+        ASSERT_EQ(concurrent[i].ret, serial[i].ret);
+        ASSERT_EQ(concurrent[i].iterTotal, serial[i].iterTotal);
+
+        // Bitwise equal
+        ASSERT_EQ(memcmp(concurrent[i].x.data(), serial[i].x.data(), serial[i].x.size()*sizeof(double)), 0);
+        ASSERT_EQ(memcmp(concurrent[i].y.data(), serial[i].y.data(), serial[i].y.size()*sizeof(double)), 0);
+
+        // Each object printed to the sink of its own thread
+        ASSERT_FALSE(serial[i].output.empty());
+        ASSERT_EQ(concurrent[i].output, serial[i].output);
+    }
 }
 
 int main(int argc, char* argv[])